@@ -66,10 +66,9 @@ void take_ai_decisions(sys::state& state) {
 		}
 	});
 	// combination and final execution
-	auto total_vector = decisions_taken.combine([](auto& a, auto& b) {
-		std::vector<decision_nation_pair, dcon::cache_aligned_allocator<decision_nation_pair>> result(a.begin(), a.end());
-		result.insert(result.end(), b.begin(), b.end());
-		return result;
+	std::pmr::vector<decision_nation_pair> total_vector(&state.tick_arena);
+	decisions_taken.combine_each([&](auto const& local) {
+		total_vector.insert(total_vector.end(), local.begin(), local.end());
 	});
 	// ensure total deterministic ordering
 	std::sort(total_vector.begin(), total_vector.end(), [&](auto a, auto b) {
@@ -226,7 +225,8 @@ void update_ai_colony_starting(sys::state& state) {
 		}
 	}
 	// Randomize colonization target to avoid colonization along map patterns
-	std::vector<dcon::state_definition_id> states;
+	std::pmr::vector<dcon::state_definition_id> states(&state.tick_arena);
+	states.reserve(state.world.state_definition_size());
 	for(auto sd : state.world.in_state_definition) {
 		states.push_back(sd);
 	}
@@ -967,7 +967,8 @@ struct classified_province {
 };
 
 void distribute_guards(sys::state& state, dcon::nation_id n) {
-	std::vector<classified_province> provinces;
+	static thread_local std::vector<classified_province> provinces;
+	provinces.clear();
 	provinces.reserve(state.world.province_size());
 
 	auto cap = state.world.nation_get_capital(n);
@@ -977,8 +978,8 @@ void distribute_guards(sys::state& state, dcon::nation_id n) {
 		if(c.get_province() == cap)
 			cls = province_class::border;
 
-		for(auto padj : c.get_province().get_province_adjacency()) {
-			auto other = padj.get_connected_provinces(0) == c.get_province() ? padj.get_connected_provinces(1) : padj.get_connected_provinces(0);
+		for(auto& e : state.adjacency_graph.neighbors(c.get_province())) {
+			auto other = fatten(state.world, e.neighbor);
 			auto n_controller = other.get_nation_from_province_control();
 			auto ovr = n_controller.get_overlord_as_subject().get_ruler();
 
@@ -1046,7 +1047,8 @@ void distribute_guards(sys::state& state, dcon::nation_id n) {
 	});
 
 	// form list of guards
-	std::vector<dcon::army_id> guards_list;
+	static thread_local std::vector<dcon::army_id> guards_list;
+	guards_list.clear();
 	guards_list.reserve(state.world.army_size());
 	for(auto a : state.world.nation_get_army_control(n)) {
 		if(a.get_army().get_ai_activity() == uint8_t(army_activity::on_guard)) {
@@ -1151,7 +1153,8 @@ dcon::navy_id find_transport_fleet(sys::state& state, dcon::nation_id controller
 }
 
 void move_idle_guards(sys::state& state) {
-	std::vector<dcon::army_id> require_transport;
+	static std::vector<dcon::army_id> require_transport;
+	require_transport.clear();
 	require_transport.reserve(state.world.army_size());
 
 	for(auto ar : state.world.in_army) {
@@ -1517,7 +1520,8 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 		dcon::province_id p;
 		float str = 0.0f;
 	};
-	std::vector<a_str> ready_armies;
+	static thread_local std::vector<a_str> ready_armies;
+	ready_armies.clear();
 	ready_armies.reserve(state.world.province_size());
 
 	int32_t ready_count = 0;
@@ -1550,7 +1554,8 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 	};
 
 	/* Ourselves */
-	std::vector<army_target> potential_targets;
+	static thread_local std::vector<army_target> potential_targets;
+	potential_targets.clear();
 	potential_targets.reserve(state.world.province_size());
 	for(auto o : state.world.nation_get_province_ownership(n)) {
 		if(!o.get_province().get_nation_from_province_control()
@@ -1562,7 +1567,8 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 		}
 	}
 	/* Nations we're at war with OR hostile to */
-	std::vector<dcon::nation_id> at_war_with;
+	static thread_local std::vector<dcon::nation_id> at_war_with;
+	at_war_with.clear();
 	at_war_with.reserve(state.world.nation_size());
 	for(auto w : state.world.nation_get_war_participant(n)) {
 		auto attacker = w.get_is_attacker();
@@ -1692,6 +1698,16 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 		if(!central_province)
 			continue;
 
+		// a single search towards the central province gives the route of every gathering army
+		static thread_local province::distance_field gather_field;
+		static thread_local std::vector<dcon::province_id> gather_locations;
+		static thread_local std::vector<dcon::province_id> gather_path;
+		gather_locations.clear();
+		for(int32_t m = int32_t(ready_armies.size()); m-- > k + 1; ) {
+			gather_locations.push_back(ready_armies[m].p);
+		}
+		province::fill_safe_land_distance_field(state, n, province::search_direction::to_sources, std::span<dcon::province_id const>(&central_province, 1), gather_field, gather_locations);
+
 		// issue safe-move gather command
 		for(int32_t m = int32_t(ready_armies.size()); m-- > k + 1; ) {
 			assert(m >= 0 && m < int32_t(ready_armies.size()));
@@ -1710,8 +1726,8 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 				if(ready_armies[m].p == central_province) {
 					ar.get_army().set_ai_province(potential_targets[i].location);
 					ar.get_army().set_ai_activity(uint8_t(army_activity::attacking));
-				} else if(auto path = province::make_safe_land_path(state, ready_armies[m].p, central_province, n); !path.empty()) {
-					military::set_army_path(state, ar.get_army(), path, n);
+				} else if(gather_field.path(ready_armies[m].p, gather_path); !gather_path.empty()) {
+					military::set_army_path(state, ar.get_army(), gather_path, n);
 					ar.get_army().set_ai_province(potential_targets[i].location);
 					ar.get_army().set_ai_activity(uint8_t(army_activity::attacking));
 				}
@@ -1741,6 +1757,7 @@ void make_attacks(sys::state& state) {
 }
 
 void make_defense(sys::state& state) {
+	military::update_supply_fields(state);
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
 		if(state.world.nation_is_valid(n)) {
@@ -2259,6 +2276,7 @@ void new_units_and_merging(sys::state& state) {
 
 						if((is_art && num_support < 5) || (!is_art && num_frontline < 5)) {
 							(*regs.begin()).get_regiment().set_army_from_army_membership(o.get_army());
+							military::queue_for_gc(state, ar.id);
 							break;
 						}
 					}
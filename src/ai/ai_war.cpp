@@ -1921,7 +1921,7 @@ void make_peace_offers(sys::state& state) {
 		if(auto off = state.world.nation_get_peace_offer_from_pending_peace_offer(from); off) {
 			if(state.world.peace_offer_get_is_crisis_offer(off) == true || state.world.peace_offer_get_war_from_war_settlement(off))
 				return; // offer in flight
-			state.world.delete_peace_offer(off); // else -- offer has been already resolved and was just pending gc
+			military::delete_peace_offer(state, off); // else -- offer has been already resolved and was just pending gc
 		}
 
 		assert(command::can_start_peace_offer(state, from, to, w, concession));
@@ -2232,7 +2232,7 @@ void make_war_decs(sys::state& state) {
 					auto other = adj.get_connected_nations(0) != n ? adj.get_connected_nations(0) : adj.get_connected_nations(1);
 					auto neighbor = other;
 					if(neighbor.get_in_sphere_of() == n) {
-						auto path = province::make_safe_land_path(state, state.world.nation_get_capital(n), state.world.nation_get_capital(neighbor), n);
+						auto path = province::cached::make_safe_land_path_estimate(state, state.world.nation_get_capital(n), state.world.nation_get_capital(neighbor), n);
 						if(path.empty()) {
 							continue;
 						}
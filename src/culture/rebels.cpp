@@ -858,6 +858,7 @@ void delete_faction(sys::state& state, dcon::rebel_faction_id reb) {
 		auto prov = p.get_province();
 		province::set_province_controller(state, prov, prov.get_nation_from_province_ownership());
 	}
+	military::queue_units_for_gc(state, reb);
 	state.world.delete_rebel_faction(reb);
 }
 
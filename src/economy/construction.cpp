@@ -249,6 +249,29 @@ void register_construction_demand(sys::state& state, dcon::market_id s, dcon::co
 	assert(state.world.market_get_construction_demand(s, commodity_type) >= 0.f);
 }
 
+// demand generated by a single construction
+// it is computed in parallel over paying nations and registered serially afterwards,
+// so additions to market demand always happen in the same order
+struct construction_demand {
+	dcon::market_id market;
+	commodity_set goods;
+	uint32_t count = 0;
+
+	void add(dcon::market_id m, dcon::commodity_id cid, float amount) {
+		assert(count < commodity_set::set_size);
+		market = m;
+		goods.commodity_type[count] = cid;
+		goods.commodity_amounts[count] = amount;
+		count++;
+	}
+};
+
+void register_construction_demand(sys::state& state, construction_demand const& demand) {
+	for(uint32_t i = 0; i < demand.count; ++i) {
+		register_construction_demand(state, demand.market, demand.goods.commodity_type[i], demand.goods.commodity_amounts[i]);
+	}
+}
+
 void reset_construction_demand(sys::state& state) {
 	uint32_t total_commodities = state.world.commodity_size();
 	for(uint32_t i = 1; i < total_commodities; ++i) {
@@ -315,7 +338,8 @@ void populate_land_unit_construction_demand(
 	sys::state& state,
 	dcon::province_land_construction_id lc,
 	float& budget,
-	float budget_limit
+	float budget_limit,
+	construction_demand& demand
 ) {
 	auto details = explain_land_unit_construction(state, lc);
 	if(!details.can_be_advanced) {
@@ -343,7 +367,7 @@ void populate_land_unit_construction_demand(
 		auto can_purchase = std::min(can_purchase_budget, can_purchase_construction);
 		auto satisfaction = state.world.market_get_actual_probability_to_buy(details.market, cid);
 		budget = std::max(0.f, budget - can_purchase * local_price * satisfaction);
-		register_construction_demand(state, details.market, cid, can_purchase);
+		demand.add(details.market, cid, can_purchase);
 	}
 }
 
@@ -393,7 +417,8 @@ void populate_naval_unit_construction_demand(
 	sys::state& state,
 	dcon::province_naval_construction_id construction,
 	float& budget,
-	float budget_limit
+	float budget_limit,
+	construction_demand& demand
 ) {
 	auto details = explain_naval_unit_construction(state, construction);
 	if(!details.can_be_advanced) return;
@@ -414,7 +439,7 @@ void populate_naval_unit_construction_demand(
 		auto can_purchase = std::min(can_purchase_budget, can_purchase_construction);
 		auto satisfaction = state.world.market_get_actual_probability_to_buy(details.market, cid);
 		budget = std::max(0.f, budget - can_purchase * local_price * satisfaction);
-		register_construction_demand(state, details.market, cid, can_purchase);
+		demand.add(details.market, cid, can_purchase);
 	}
 }
 
@@ -497,7 +522,8 @@ void populate_province_building_construction_demand(
 	sys::state& state,
 	dcon::province_building_construction_id construction,
 	float& budget,
-	float budget_limit
+	float budget_limit,
+	construction_demand& demand
 ) {
 	auto details = explain_province_building_construction(state, construction);
 	if(!details.can_be_advanced) return;
@@ -519,7 +545,7 @@ void populate_province_building_construction_demand(
 		auto can_purchase = std::min(can_purchase_budget, can_purchase_construction);
 		auto satisfaction = state.world.market_get_actual_probability_to_buy(details.market, cid);
 		budget = std::max(0.f, budget - can_purchase * local_price * satisfaction);
-		register_construction_demand(state, details.market, cid, can_purchase);
+		demand.add(details.market, cid, can_purchase);
 	}
 }
 
@@ -704,7 +730,8 @@ void populate_state_construction_demand(
 	sys::state& state,
 	dcon::factory_construction_id construction,
 	float& budget,
-	float budget_limit
+	float budget_limit,
+	construction_demand& demand
 ) {
 	auto details = explain_factory_building_construction(state, construction);
 	if(!details.can_be_advanced) return;
@@ -728,11 +755,18 @@ void populate_state_construction_demand(
 		auto can_purchase = std::min(can_purchase_budget, can_purchase_construction);
 		auto satisfaction = state.world.market_get_actual_probability_to_buy(details.market, cid);
 		budget = std::max(0.f, budget - can_purchase * local_price * satisfaction);
-		register_construction_demand(state, details.market, cid, can_purchase);
+		demand.add(details.market, cid, can_purchase);
 	}
 }
 
 
+struct nation_construction_queue {
+	std::vector<dcon::province_land_construction_id> land;
+	std::vector<dcon::province_naval_construction_id> naval;
+	std::vector<dcon::province_building_construction_id> buildings;
+	std::vector<dcon::factory_construction_id> factories;
+};
+
 void populate_construction_consumption(sys::state& state) {
 	reset_construction_demand(state);
 
@@ -794,13 +828,36 @@ void populate_construction_consumption(sys::state& state) {
 	};
 
 
+	// budgets of nations are independent from each other:
+	// group constructions by the paying nation, keeping the order in which they were visited serially
+	// constructions without an owner draw from the budget slot of the invalid nation, like every other construction, and are handled serially on their own
+
+	static std::vector<nation_construction_queue> queues;
+	static nation_construction_queue ownerless;
+	static std::vector<construction_demand> land_demand;
+	static std::vector<construction_demand> naval_demand;
+	static std::vector<construction_demand> building_demand;
+	static std::vector<construction_demand> factory_demand;
+
+	queues.resize(state.world.nation_size());
+	for(auto& q : queues) {
+		q.land.clear();
+		q.naval.clear();
+		q.buildings.clear();
+		q.factories.clear();
+	}
+	ownerless.land.clear();
+	ownerless.buildings.clear();
+	ownerless.factories.clear();
+	land_demand.assign(state.world.province_land_construction_size(), construction_demand{});
+	naval_demand.assign(state.world.province_naval_construction_size(), construction_demand{});
+	building_demand.assign(state.world.province_building_construction_size(), construction_demand{});
+	factory_demand.assign(state.world.factory_construction_size(), construction_demand{});
+
 	for(auto lc : state.world.in_province_land_construction) {
 		auto province = state.world.pop_get_province_from_pop_location(state.world.province_land_construction_get_pop(lc));
 		auto owner = state.world.province_get_nation_from_province_ownership(province);
-		float& base_budget = current_budget.get(owner);
-		float budget = total_budget.get(owner);
-		float owners_projects = float(std::max(1, going_constructions.get(owner)));
-		populate_land_unit_construction_demand(state, lc, base_budget, budget/owners_projects);
+		(owner ? queues[owner.index()] : ownerless).land.push_back(lc);
 	}
 	province::for_each_land_province(state, [&](dcon::province_id p) {
 		auto owner = state.world.province_get_nation_from_province_ownership(p);
@@ -809,22 +866,55 @@ void populate_construction_consumption(sys::state& state) {
 		auto rng = state.world.province_get_province_naval_construction(p);
 		if(rng.begin() == rng.end())
 			return;
-		auto c = *(rng.begin());
-		float& base_budget = current_budget.get(owner);
-		float budget_limit = total_budget.get(owner) / float(std::max(1, going_constructions.get(owner)));
-		populate_naval_unit_construction_demand(state, c, base_budget, budget_limit);
+		queues[owner.index()].naval.push_back((*(rng.begin())).id);
 	});
 	for(auto c : state.world.in_province_building_construction) {
 		auto owner = c.get_nation().id;
-		float& base_budget = current_budget.get(owner);
-		float budget_limit = total_budget.get(owner) / float(std::max(1, going_constructions.get(owner)));
-		populate_province_building_construction_demand(state, c, base_budget, budget_limit);
+		(owner ? queues[owner.index()] : ownerless).buildings.push_back(c);
 	}
 	for(auto c : state.world.in_factory_construction) {
 		auto owner = c.get_nation().id;
+		(owner ? queues[owner.index()] : ownerless).factories.push_back(c);
+	}
+
+	auto populate_queue = [&](dcon::nation_id owner, nation_construction_queue const& q) {
 		float& base_budget = current_budget.get(owner);
 		float budget_limit = total_budget.get(owner) / float(std::max(1, going_constructions.get(owner)));
-		populate_state_construction_demand(state, c, base_budget, budget_limit);
+
+		for(auto lc : q.land) {
+			populate_land_unit_construction_demand(state, lc, base_budget, budget_limit, land_demand[lc.index()]);
+		}
+		for(auto c : q.naval) {
+			populate_naval_unit_construction_demand(state, c, base_budget, budget_limit, naval_demand[c.index()]);
+		}
+		for(auto c : q.buildings) {
+			populate_province_building_construction_demand(state, c, base_budget, budget_limit, building_demand[c.index()]);
+		}
+		for(auto c : q.factories) {
+			populate_state_construction_demand(state, c, base_budget, budget_limit, factory_demand[c.index()]);
+		}
+	};
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		populate_queue(dcon::nation_id{ dcon::nation_id::value_base_t(i) }, queues[i]);
+	});
+	populate_queue(dcon::nation_id{ }, ownerless);
+
+	// markets are shared between nations (foreign investment), so demand is registered serially
+
+	for(auto lc : state.world.in_province_land_construction) {
+		register_construction_demand(state, land_demand[lc.id.index()]);
+	}
+	province::for_each_land_province(state, [&](dcon::province_id p) {
+		auto rng = state.world.province_get_province_naval_construction(p);
+		if(rng.begin() == rng.end())
+			return;
+		register_construction_demand(state, naval_demand[(*(rng.begin())).id.index()]);
+	});
+	for(auto c : state.world.in_province_building_construction) {
+		register_construction_demand(state, building_demand[c.id.index()]);
+	}
+	for(auto c : state.world.in_factory_construction) {
+		register_construction_demand(state, factory_demand[c.id.index()]);
 	}
 }
 
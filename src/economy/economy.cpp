@@ -405,6 +405,7 @@ void presimulate(sys::state& state) {
 	uint32_t steps = 2;
 #endif
 	for(uint32_t i = 0; i < steps; i++) {
+		state.tick_arena.begin_tick();
 		float presim_completion = float(i) / float(steps);
 		float employment_gradient_mult = 1000.0f / std::max(presim_completion * 1000.0f, 1.0f);
 		update_employment(state, true, employment_gradient_mult);
@@ -2295,10 +2296,13 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 	if(state.trade_route_cached_values_out_of_date) {
 		state.trade_route_cached_values_out_of_date = false;
 
-		ankerl::unordered_dense::map<int32_t, bool> direct_block;
-		ankerl::unordered_dense::map<int32_t, bool> trade_closed;
-		ankerl::unordered_dense::map<int32_t, bool> direct_no_tariffs;
-		ankerl::unordered_dense::map<int32_t, bool> no_tariffs;
+		using nation_pair_flags = ankerl::unordered_dense::pmr::map<int32_t, bool>;
+		nation_pair_flags::allocator_type scratch{ &state.tick_arena };
+
+		nation_pair_flags direct_block{ scratch };
+		nation_pair_flags trade_closed{ scratch };
+		nation_pair_flags direct_no_tariffs{ scratch };
+		nation_pair_flags no_tariffs{ scratch };
 
 		// US3AC9. Wartime embargoes
 
@@ -3107,10 +3111,9 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 	});
 
 	{
-		auto total_vector = bankrupt_nations.combine([](auto& a, auto& b) {
-			std::vector<dcon::nation_id> result(a.begin(), a.end());
-			result.insert(result.end(), b.begin(), b.end());
-			return result;
+		std::pmr::vector<dcon::nation_id> total_vector(&state.tick_arena);
+		bankrupt_nations.combine_each([&](auto const& local) {
+			total_vector.insert(total_vector.end(), local.begin(), local.end());
 		});
 		std::sort(total_vector.begin(), total_vector.end(), [](auto a, auto b) { return a.value < b.value; });
 		for(auto& n : total_vector) {		
@@ -4957,6 +4960,106 @@ float estimate_subject_payments_received(sys::state& state, dcon::nation_id o) {
 	return res;
 }
 
+namespace cached {
+
+template<typename F>
+float memoize(sys::state& state, explanation_query query, dcon::nation_id n, F&& f) {
+	auto key = explanation_cache::key(query, uint32_t(n.index()));
+	auto it = state.economy_explanations.values.find(key);
+	if(it != state.economy_explanations.values.end()) {
+		return it->second;
+	}
+	auto result = f(state, n);
+	state.economy_explanations.values.insert_or_assign(key, result);
+	return result;
+}
+
+float estimate_gold_income(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::gold_income, n, economy::estimate_gold_income);
+}
+float estimate_tariff_import_income(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::tariff_import_income, n, economy::estimate_tariff_import_income);
+}
+float estimate_tariff_export_income(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::tariff_export_income, n, economy::estimate_tariff_export_income);
+}
+float estimate_war_subsidies_income(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::war_subsidies_income, n, economy::estimate_war_subsidies_income);
+}
+float estimate_war_subsidies_spending(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::war_subsidies_spending, n, economy::estimate_war_subsidies_spending);
+}
+float estimate_reparations_income(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::reparations_income, n, economy::estimate_reparations_income);
+}
+float estimate_reparations_spending(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::reparations_spending, n, economy::estimate_reparations_spending);
+}
+float estimate_subject_payments_paid(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::subject_payments_paid, n, economy::estimate_subject_payments_paid);
+}
+float estimate_diplomatic_income(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::diplomatic_income, n, economy::estimate_diplomatic_income);
+}
+float estimate_private_construction_spendings(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::private_construction_spendings, n, economy::estimate_private_construction_spendings);
+}
+float estimate_investment_pool_daily_loss(sys::state& state, dcon::nation_id n) {
+	return memoize(state, explanation_query::investment_pool_daily_loss, n, economy::estimate_investment_pool_daily_loss);
+}
+
+std::vector<trade_breakdown_item> explain_national_tariff(sys::state& state, dcon::nation_id n, bool import_flag, bool export_flag) {
+	auto key = explanation_cache::key(explanation_query::national_tariff, uint32_t(n.index()), (import_flag ? 1 : 0) | (export_flag ? 2 : 0));
+	auto it = state.economy_explanations.lists.find(key);
+	if(it != state.economy_explanations.lists.end()) {
+		return it->second;
+	}
+	auto result = economy::explain_national_tariff(state, n, import_flag, export_flag);
+	state.economy_explanations.lists.insert_or_assign(key, result);
+	return result;
+}
+
+trade_and_tariff<dcon::trade_route_id> explain_trade_route_commodity(sys::state& state, dcon::trade_route_id route, dcon::commodity_id cid) {
+	auto key = explanation_cache::key(explanation_query::trade_route_commodity, uint32_t(route.index()), uint32_t(cid.index()));
+	auto it = state.economy_explanations.trade_routes.find(key);
+	if(it != state.economy_explanations.trade_routes.end()) {
+		return it->second;
+	}
+	auto result = economy::explain_trade_route_commodity(state, route, cid);
+	state.economy_explanations.trade_routes.insert_or_assign(key, result);
+	return result;
+}
+
+float trade_route_value(sys::state& state, dcon::trade_route_id route) {
+	auto key = explanation_cache::key(explanation_query::trade_route_value, uint32_t(route.index()));
+	auto it = state.economy_explanations.values.find(key);
+	if(it != state.economy_explanations.values.end()) {
+		return it->second;
+	}
+	float total = 0.f;
+	state.world.for_each_commodity([&](auto cid) {
+		total += state.world.commodity_get_median_price(cid) * state.world.trade_route_get_volume(route, cid);
+	});
+	state.economy_explanations.values.insert_or_assign(key, total);
+	return total;
+}
+
+std::vector<dcon::market_id> const& trade_partners(sys::state& state, dcon::market_id m) {
+	auto key = explanation_cache::key(explanation_query::trade_partners, uint32_t(m.index()));
+	auto it = state.economy_explanations.markets.find(key);
+	if(it != state.economy_explanations.markets.end()) {
+		return it->second;
+	}
+	std::vector<dcon::market_id> result;
+	state.world.market_for_each_trade_route(m, [&](auto route) {
+		auto m_0 = state.world.trade_route_get_connected_markets(route, 0);
+		result.push_back(m_0 == m ? state.world.trade_route_get_connected_markets(route, 1) : m_0);
+	});
+	return state.economy_explanations.markets.insert_or_assign(key, std::move(result)).first->second;
+}
+
+}
+
 construction_status province_building_construction(sys::state& state, dcon::province_id p, province_building_type t) {
 	assert(0 <= int32_t(t) && int32_t(t) < int32_t(economy::max_building_types));
 	for(auto pb_con : state.world.province_get_province_building_construction(p)) {
@@ -5100,64 +5203,185 @@ void change_factory_type_in_province(sys::state& state, dcon::province_id p, dco
 	}
 }
 
-void resolve_constructions(sys::state& state) {
-	// US1. Regiment construction
-	// US1AC7.
-	for(auto c : state.world.in_province_land_construction) {
-		auto pop = state.world.province_land_construction_get_pop(c);
-		auto province = state.world.pop_get_province_from_pop_location(pop);
-		float cost_factor = economy::build_cost_multiplier(state, province, false);
-
-		auto& base_cost = state.military_definitions.unit_base_definitions[c.get_type()].build_cost;
-		auto& current_purchased = c.get_purchased_goods();
-		auto construction_time = state.military_definitions.unit_base_definitions[c.get_type()].build_time;
-
-		// US1AC4. All goods costs must be built
-		bool ready_for_deployment = true;
-		if(!(c.get_nation().get_is_player_controlled() && state.cheat_data.instant_army)) {
-			for(uint32_t j = 0; j < commodity_set::set_size && ready_for_deployment; ++j) {
-				if(base_cost.commodity_type[j]) {
-					if(current_purchased.commodity_amounts[j] < base_cost.commodity_amounts[j] * cost_factor) {
-						ready_for_deployment = false;
-					}
-				} else {
-					break;
+bool land_unit_construction_is_finished(sys::state& state, dcon::province_land_construction_id c) {
+	auto pop = state.world.province_land_construction_get_pop(c);
+	auto province = state.world.pop_get_province_from_pop_location(pop);
+	float cost_factor = economy::build_cost_multiplier(state, province, false);
+
+	auto type = state.world.province_land_construction_get_type(c);
+	auto& base_cost = state.military_definitions.unit_base_definitions[type].build_cost;
+	auto& current_purchased = state.world.province_land_construction_get_purchased_goods(c);
+	auto construction_time = state.military_definitions.unit_base_definitions[type].build_time;
+
+	// US1AC4. All goods costs must be built
+	bool ready_for_deployment = true;
+	auto n = state.world.province_land_construction_get_nation(c);
+	if(!(state.world.nation_get_is_player_controlled(n) && state.cheat_data.instant_army)) {
+		for(uint32_t j = 0; j < commodity_set::set_size && ready_for_deployment; ++j) {
+			if(base_cost.commodity_type[j]) {
+				if(current_purchased.commodity_amounts[j] < base_cost.commodity_amounts[j] * cost_factor) {
+					ready_for_deployment = false;
 				}
+			} else {
+				break;
 			}
 		}
+	}
 
-		// US1AC5. But no faster than construction_time
-		if(!state.cheat_data.instant_army) {
-			if(state.current_date < c.get_start_date() + construction_time) {
-				ready_for_deployment = false;
+	// US1AC5. But no faster than construction_time
+	if(!state.cheat_data.instant_army) {
+		if(state.current_date < state.world.province_land_construction_get_start_date(c) + construction_time) {
+			ready_for_deployment = false;
+		}
+	}
+	return ready_for_deployment;
+}
+
+bool naval_unit_construction_is_finished(sys::state& state, dcon::province_naval_construction_id c) {
+	auto province = state.world.province_naval_construction_get_province(c);
+	float cost_factor = economy::build_cost_multiplier(state, province, false);
+
+	auto type = state.world.province_naval_construction_get_type(c);
+	auto& base_cost = state.military_definitions.unit_base_definitions[type].build_cost;
+	auto& current_purchased = state.world.province_naval_construction_get_purchased_goods(c);
+	auto construction_time = state.military_definitions.unit_base_definitions[type].build_time;
+
+	// US2AC4.
+	bool ready_for_deployment = true;
+	auto n = state.world.province_naval_construction_get_nation(c);
+	if(!(state.world.nation_get_is_player_controlled(n) && state.cheat_data.instant_navy)) {
+		for(uint32_t i = 0; i < commodity_set::set_size && ready_for_deployment; ++i) {
+			if(base_cost.commodity_type[i]) {
+				if(current_purchased.commodity_amounts[i] < base_cost.commodity_amounts[i] * cost_factor) {
+					ready_for_deployment = false;
+				}
+			} else {
+				break;
 			}
 		}
+	}
 
-		if(ready_for_deployment) {
-			auto pop_location = c.get_pop().get_province_from_pop_location();
+	// US2AC5. But no faster than construction_time
+	if(!state.cheat_data.instant_navy) {
+		if(state.current_date < state.world.province_naval_construction_get_start_date(c) + construction_time) {
+			ready_for_deployment = false;
+		}
+	}
+	return ready_for_deployment;
+}
 
-			auto new_reg = military::create_new_regiment(state, c.get_nation(), c.get_type());
-			auto a = fatten(state.world, state.world.create_army());
+bool province_building_construction_is_finished(sys::state& state, dcon::province_building_construction_id c) {
+	auto for_province = state.world.province_building_construction_get_province(c);
+	float cost_factor = economy::build_cost_multiplier(state, for_province, state.world.province_building_construction_get_is_pop_project(c));
 
-			a.set_controller_from_army_control(c.get_nation());
-			state.world.try_create_army_membership(new_reg, a);
-			state.world.try_create_regiment_source(new_reg, c.get_pop());
-			military::army_arrives_in_province(state, a, pop_location, military::crossing_type::none);
-			military::move_land_to_merge(state, c.get_nation(), a, pop_location, c.get_template_province());
+	auto t = province_building_type(state.world.province_building_construction_get_type(c));
+	assert(0 <= int32_t(t) && int32_t(t) < int32_t(economy::max_building_types));
+	auto& base_cost = state.economy_definitions.building_definitions[int32_t(t)].cost;
+	auto& current_purchased = state.world.province_building_construction_get_purchased_goods(c);
+	bool all_finished = true;
+
+	for(uint32_t j = 0; j < commodity_set::set_size && all_finished; ++j) {
+		if(base_cost.commodity_type[j]) {
+			if(current_purchased.commodity_amounts[j] < base_cost.commodity_amounts[j] * cost_factor) {
+				all_finished = false;
+			}
+		} else {
+			break;
+		}
+	}
+	return all_finished;
+}
 
-			if(c.get_nation() == state.local_player_nation) {
-				notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
-						text::add_line(state, contents, "amsg_army_built");
-					},
-					"amsg_army_built",
-					state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
-					sys::message_base_type::army_built,
-					dcon::province_id{ }
-				});
+bool factory_construction_is_finished(sys::state& state, dcon::factory_construction_id c) {
+	auto n = state.world.factory_construction_get_nation(c);
+	auto type = state.world.factory_construction_get_type(c);
+	auto province = state.world.factory_construction_get_province(c);
+	auto refit_target = state.world.factory_construction_get_refit_target(c);
+	auto base_cost = refit_target ? calculate_factory_refit_goods_cost(state, n, province, type, refit_target) : state.world.factory_type_get_construction_costs(type);
+	auto& current_purchased = state.world.factory_construction_get_purchased_goods(c);
+	float factory_mod = factory_build_cost_multiplier(state, n, province, state.world.factory_construction_get_is_pop_project(c));
+
+	bool all_finished = true;
+	if(!(n == state.local_player_nation && state.cheat_data.instant_industry)) {
+		for(uint32_t j = 0; j < commodity_set::set_size && all_finished; ++j) {
+			if(base_cost.commodity_type[j]) {
+				if(current_purchased.commodity_amounts[j] < base_cost.commodity_amounts[j] * factory_mod) {
+					all_finished = false;
+				}
+			} else {
+				break;
 			}
+		}
+	}
+	return all_finished;
+}
+
+void resolve_constructions(sys::state& state) {
+	// progress pass: completion of every construction is checked in parallel
+	// it only reads the state, so the results are the same as if they were checked one by one
+
+	static std::vector<uint8_t> land_finished;
+	static std::vector<uint8_t> naval_finished;
+	static std::vector<uint8_t> building_finished;
+	static std::vector<uint8_t> factory_finished;
+
+	land_finished.assign(state.world.province_land_construction_size(), uint8_t(0));
+	naval_finished.assign(state.world.province_naval_construction_size(), uint8_t(0));
+	building_finished.assign(state.world.province_building_construction_size(), uint8_t(0));
+	factory_finished.assign(state.world.factory_construction_size(), uint8_t(0));
+
+	concurrency::parallel_for(uint32_t(0), uint32_t(land_finished.size()), [&](uint32_t i) {
+		dcon::province_land_construction_id c{ dcon::province_land_construction_id::value_base_t(i) };
+		if(state.world.province_land_construction_is_valid(c) && land_unit_construction_is_finished(state, c))
+			land_finished[i] = 1;
+	});
+	concurrency::parallel_for(uint32_t(0), uint32_t(naval_finished.size()), [&](uint32_t i) {
+		dcon::province_naval_construction_id c{ dcon::province_naval_construction_id::value_base_t(i) };
+		if(state.world.province_naval_construction_is_valid(c) && naval_unit_construction_is_finished(state, c))
+			naval_finished[i] = 1;
+	});
+	concurrency::parallel_for(uint32_t(0), uint32_t(building_finished.size()), [&](uint32_t i) {
+		dcon::province_building_construction_id c{ dcon::province_building_construction_id::value_base_t(i) };
+		if(state.world.province_building_construction_is_valid(c) && province_building_construction_is_finished(state, c))
+			building_finished[i] = 1;
+	});
+	concurrency::parallel_for(uint32_t(0), uint32_t(factory_finished.size()), [&](uint32_t i) {
+		dcon::factory_construction_id c{ dcon::factory_construction_id::value_base_t(i) };
+		if(state.world.factory_construction_is_valid(c) && factory_construction_is_finished(state, c))
+			factory_finished[i] = 1;
+	});
 
-			state.world.delete_province_land_construction(c);
+	// commit pass: completions are applied serially in the order of ids
+
+	// US1. Regiment construction
+	// US1AC7.
+	for(auto c : state.world.in_province_land_construction) {
+		if(!land_finished[c.id.index()])
+			continue;
+
+		auto pop_location = c.get_pop().get_province_from_pop_location();
+
+		auto new_reg = military::create_new_regiment(state, c.get_nation(), c.get_type());
+		auto a = fatten(state.world, state.world.create_army());
+
+		a.set_controller_from_army_control(c.get_nation());
+		state.world.try_create_army_membership(new_reg, a);
+		state.world.try_create_regiment_source(new_reg, c.get_pop());
+		military::army_arrives_in_province(state, a, pop_location, military::crossing_type::none);
+		military::move_land_to_merge(state, c.get_nation(), a, pop_location, c.get_template_province());
+
+		if(c.get_nation() == state.local_player_nation) {
+			notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
+					text::add_line(state, contents, "amsg_army_built");
+				},
+				"amsg_army_built",
+				state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
+				sys::message_base_type::army_built,
+				dcon::province_id{ }
+			});
 		}
+
+		state.world.delete_province_land_construction(c);
 	}
 
 	// US2 Ships construction
@@ -5166,211 +5390,135 @@ void resolve_constructions(sys::state& state) {
 		auto rng = state.world.province_get_province_naval_construction(p);
 		if(rng.begin() != rng.end()) {
 			auto c = *(rng.begin());
+			if(!naval_finished[c.id.index()])
+				return;
 
-			auto province = state.world.province_naval_construction_get_province(c);
-			float cost_factor = economy::build_cost_multiplier(state, province, false);
-
-			auto& base_cost = state.military_definitions.unit_base_definitions[c.get_type()].build_cost;
-			auto& current_purchased = c.get_purchased_goods();
-			auto construction_time = state.military_definitions.unit_base_definitions[c.get_type()].build_time;
-
-			// US2AC4.
-			bool ready_for_deployment = true;
-			if(!(c.get_nation().get_is_player_controlled() && state.cheat_data.instant_navy)) {
-				for(uint32_t i = 0; i < commodity_set::set_size && ready_for_deployment; ++i) {
-					if(base_cost.commodity_type[i]) {
-						if(current_purchased.commodity_amounts[i] < base_cost.commodity_amounts[i] * cost_factor) {
-							ready_for_deployment = false;
-						}
-					} else {
-						break;
-					}
-				}
-			}
+			auto new_ship = military::create_new_ship(state, c.get_nation(), c.get_type());
+			auto a = fatten(state.world, state.world.create_navy());
+			a.set_controller_from_navy_control(c.get_nation());
+			a.set_location_from_navy_location(p);
+			state.world.try_create_navy_membership(new_ship, a);
+			military::move_navy_to_merge(state, c.get_nation(), a, c.get_province(), c.get_template_province());
 
-			// US2AC5. But no faster than construction_time
-			if(!state.cheat_data.instant_navy) {
-				if(state.current_date < c.get_start_date() + construction_time) {
-					ready_for_deployment = false;
-				}
+			if(c.get_nation() == state.local_player_nation) {
+				notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
+						text::add_line(state, contents, "amsg_navy_built");
+					},
+					"amsg_navy_built",
+					state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
+					sys::message_base_type::navy_built,
+					dcon::province_id{ }
+				});
 			}
 
-			if(ready_for_deployment) {
-				auto new_ship = military::create_new_ship(state, c.get_nation(), c.get_type());
-				auto a = fatten(state.world, state.world.create_navy());
-				a.set_controller_from_navy_control(c.get_nation());
-				a.set_location_from_navy_location(p);
-				state.world.try_create_navy_membership(new_ship, a);
-				military::move_navy_to_merge(state, c.get_nation(), a, c.get_province(), c.get_template_province());
-
-				if(c.get_nation() == state.local_player_nation) {
-					notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
-							text::add_line(state, contents, "amsg_navy_built");
-						},
-						"amsg_navy_built",
-						state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
-						sys::message_base_type::navy_built,
-						dcon::province_id{ }
-					});
-				}
-
-				state.world.delete_province_naval_construction(c);
-			}
+			state.world.delete_province_naval_construction(c);
 		}
 	});
 
 	// Construction of province buildings
 	for(auto c : state.world.in_province_building_construction) {
-		auto for_province = c.get_province();
-		float cost_factor = economy::build_cost_multiplier(state, for_province, c.get_is_pop_project());
+		if(!building_finished[c.id.index()])
+			continue;
 
+		auto for_province = c.get_province();
 		auto t = province_building_type(state.world.province_building_construction_get_type(c));
-		assert(0 <= int32_t(t) && int32_t(t) < int32_t(economy::max_building_types));
-		auto& base_cost = state.economy_definitions.building_definitions[int32_t(t)].cost;
-		auto& current_purchased = state.world.province_building_construction_get_purchased_goods(c);
-		bool all_finished = true;
 
-		for(uint32_t j = 0; j < commodity_set::set_size && all_finished; ++j) {
-			if(base_cost.commodity_type[j]) {
-				if(current_purchased.commodity_amounts[j] < base_cost.commodity_amounts[j] * cost_factor) {
-					all_finished = false;
-				}
-			} else {
-				break;
-			}
-		}
+		if(state.world.province_get_building_level(for_province, uint8_t(t)) < state.world.nation_get_max_building_level(state.world.province_get_nation_from_province_ownership(for_province), uint8_t(t))) {
+			state.world.province_set_building_level(for_province, uint8_t(t), uint8_t(state.world.province_get_building_level(for_province, uint8_t(t)) + 1));
+			state.path_cache.invalidate();
 
-		if(all_finished) {
-			if(state.world.province_get_building_level(for_province, uint8_t(t)) < state.world.nation_get_max_building_level(state.world.province_get_nation_from_province_ownership(for_province), uint8_t(t))) {
-				state.world.province_set_building_level(for_province, uint8_t(t), uint8_t(state.world.province_get_building_level(for_province, uint8_t(t)) + 1));
+			if(t == province_building_type::naval_base) {
+				auto civilian = (uint8_t)(advanced_province_buildings::list::civilian_ports);
+				auto local_civilian_port = state.world.province_get_advanced_province_building_max_private_size(for_province, civilian);
+				state.world.province_set_advanced_province_building_max_private_size(for_province, civilian, local_civilian_port + 5000.f);
 
-				if(t == province_building_type::naval_base) {
-					auto civilian = (uint8_t)(advanced_province_buildings::list::civilian_ports);
-					auto local_civilian_port = state.world.province_get_advanced_province_building_max_private_size(for_province, civilian);
-					state.world.province_set_advanced_province_building_max_private_size(for_province, civilian, local_civilian_port + 5000.f);
-
-					auto town_size = state.world.province_get_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns);
-					state.world.province_set_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns, town_size + 5000.f);
-				}
+				auto town_size = state.world.province_get_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns);
+				state.world.province_set_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns, town_size + 5000.f);
+			}
 
-				if(t == province_building_type::railroad) {
-					auto town_size = state.world.province_get_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns);
-					state.world.province_set_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns, town_size + 2000.f);
-					/* Notify the railroad mesh builder to update the railroads! */
-					state.railroad_built.store(true, std::memory_order::release);
-				}
+			if(t == province_building_type::railroad) {
+				auto town_size = state.world.province_get_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns);
+				state.world.province_set_advanced_province_building_max_private_size(for_province, advanced_province_buildings::list::local_cities_and_towns, town_size + 2000.f);
+				/* Notify the railroad mesh builder to update the railroads! */
+				state.railroad_built.store(true, std::memory_order::release);
+			}
 
-				if(state.world.province_building_construction_get_nation(c) == state.local_player_nation) {
-					switch(t) {
-					case province_building_type::naval_base:
-						notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
-								text::add_line(state, contents, "amsg_naval_base_complete");
-							},
-							"amsg_naval_base_complete",
-							state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
-							sys::message_base_type::naval_base_complete,
-							dcon::province_id{ }
-						});
-						break;
-					case province_building_type::fort:
-						notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
-								text::add_line(state, contents, "amsg_fort_complete");
-							},
-							"amsg_fort_complete",
-							state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
-							sys::message_base_type::fort_complete,
-							dcon::province_id{ }
-						});
-						break;
-					case province_building_type::railroad:
-						notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
-								text::add_line(state, contents, "amsg_rr_complete");
-							},
-							"amsg_rr_complete",
-							state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
-							sys::message_base_type::rr_complete,
-							dcon::province_id{ }
-						});
-						break;
-					default:
-						break;
-					}
+			if(state.world.province_building_construction_get_nation(c) == state.local_player_nation) {
+				switch(t) {
+				case province_building_type::naval_base:
+					notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
+							text::add_line(state, contents, "amsg_naval_base_complete");
+						},
+						"amsg_naval_base_complete",
+						state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
+						sys::message_base_type::naval_base_complete,
+						dcon::province_id{ }
+					});
+					break;
+				case province_building_type::fort:
+					notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
+							text::add_line(state, contents, "amsg_fort_complete");
+						},
+						"amsg_fort_complete",
+						state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
+						sys::message_base_type::fort_complete,
+						dcon::province_id{ }
+					});
+					break;
+				case province_building_type::railroad:
+					notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
+							text::add_line(state, contents, "amsg_rr_complete");
+						},
+						"amsg_rr_complete",
+						state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
+						sys::message_base_type::rr_complete,
+						dcon::province_id{ }
+					});
+					break;
+				default:
+					break;
 				}
 			}
-			state.world.delete_province_building_construction(c);
 		}
+		state.world.delete_province_building_construction(c);
 	}
 
 	// Construction of factories
+	// cost of a refit depends on the size of factories in the province,
+	// so refits in provinces where a factory was already changed during this pass are checked again
+	static std::vector<dcon::province_id> changed_provinces;
+	changed_provinces.clear();
+
 	for(auto c : state.world.in_factory_construction) {
-		auto n = state.world.factory_construction_get_nation(c);
 		auto type = state.world.factory_construction_get_type(c);
-		auto base_cost = (c.get_refit_target()) ? calculate_factory_refit_goods_cost(state, n, c.get_province(), c.get_type(), c.get_refit_target()) : state.world.factory_type_get_construction_costs(type);
-		auto& current_purchased = state.world.factory_construction_get_purchased_goods(c);
-		float factory_mod = factory_build_cost_multiplier(state, n, c.get_province(), c.get_is_pop_project());
-
-		if(!state.world.factory_construction_get_is_pop_project(c)) {
-			bool all_finished = true;
-			if(!(n == state.local_player_nation && state.cheat_data.instant_industry)) {
-				for(uint32_t j = 0; j < commodity_set::set_size && all_finished; ++j) {
-					if(base_cost.commodity_type[j]) {
-						if(current_purchased.commodity_amounts[j] < base_cost.commodity_amounts[j] * factory_mod) {
-							all_finished = false;
-						}
-					} else {
-						break;
-					}
-				}
-			}
-			if(all_finished && c.get_refit_target()) {
-				change_factory_type_in_province(
-					state,
-					c.get_province(),
-					type,
-					c.get_refit_target()
-				);
-				state.world.delete_factory_construction(c);
-			}
-			else if (all_finished) {
-				add_factory_level_to_province(
-					state, c.get_province(), type
-				);
-				state.world.delete_factory_construction(c);
-			}
+		auto province = c.get_province();
+
+		bool all_finished = factory_finished[c.id.index()] != 0;
+		if(c.get_refit_target() && std::find(changed_provinces.begin(), changed_provinces.end(), province.id) != changed_provinces.end()) {
+			all_finished = factory_construction_is_finished(state, c);
+		}
+		if(!all_finished)
+			continue;
+
+		changed_provinces.push_back(province.id);
+
+		if(c.get_refit_target()) {
+			change_factory_type_in_province(state, province, type, c.get_refit_target());
 		} else {
-			bool all_finished = true;
-			if(!(n == state.local_player_nation && state.cheat_data.instant_industry)) {
-				for(uint32_t j = 0; j < commodity_set::set_size && all_finished; ++j) {
-					if(base_cost.commodity_type[j]) {
-						if(current_purchased.commodity_amounts[j] < base_cost.commodity_amounts[j] * factory_mod) {
-							all_finished = false;
-						}
-					} else {
-						break;
-					}
-				}
-			}
-			if(all_finished && c.get_refit_target()) {
-				change_factory_type_in_province(state, state.world.factory_construction_get_province(c), type,
-						c.get_refit_target());
-				state.world.delete_factory_construction(c);
-			} else if(all_finished) {
-				add_factory_level_to_province(state, state.world.factory_construction_get_province(c), type);
-
-				if(state.world.factory_construction_get_nation(c) == state.local_player_nation) {
-					notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
-							text::add_line(state, contents, "amsg_factory_complete");
-						},
-						"amsg_factory_complete",
-						state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
-						sys::message_base_type::factory_complete,
-						dcon::province_id{ }
-					});
-				}
+			add_factory_level_to_province(state, province, type);
 
-				state.world.delete_factory_construction(c);
+			if(state.world.factory_construction_get_is_pop_project(c) && state.world.factory_construction_get_nation(c) == state.local_player_nation) {
+				notification::post(state, notification::message{ [](sys::state& state, text::layout_base& contents) {
+						text::add_line(state, contents, "amsg_factory_complete");
+					},
+					"amsg_factory_complete",
+					state.local_player_nation, dcon::nation_id{}, dcon::nation_id{},
+					sys::message_base_type::factory_complete,
+					dcon::province_id{ }
+				});
 			}
 		}
+		state.world.delete_factory_construction(c);
 	}
 }
 
@@ -129,4 +129,26 @@ bool do_resource_potentials_allow_construction(sys::state& state, dcon::nation_i
 bool do_resource_potentials_allow_upgrade(sys::state& state, dcon::nation_id source, dcon::province_id location, dcon::factory_type_id type);
 bool do_resource_potentials_allow_refit(sys::state& state, dcon::nation_id source, dcon::province_id location, dcon::factory_type_id from, dcon::factory_type_id refit_target);
 
+// memoized versions of the queries above for tooltips and reports
+// results are reused until the next game state update, do not use outside of ui
+namespace cached {
+float estimate_gold_income(sys::state& state, dcon::nation_id n);
+float estimate_tariff_import_income(sys::state& state, dcon::nation_id n);
+float estimate_tariff_export_income(sys::state& state, dcon::nation_id n);
+float estimate_war_subsidies_income(sys::state& state, dcon::nation_id n);
+float estimate_war_subsidies_spending(sys::state& state, dcon::nation_id n);
+float estimate_reparations_income(sys::state& state, dcon::nation_id n);
+float estimate_reparations_spending(sys::state& state, dcon::nation_id n);
+float estimate_subject_payments_paid(sys::state& state, dcon::nation_id n);
+float estimate_diplomatic_income(sys::state& state, dcon::nation_id n);
+float estimate_private_construction_spendings(sys::state& state, dcon::nation_id n);
+float estimate_investment_pool_daily_loss(sys::state& state, dcon::nation_id n);
+std::vector<trade_breakdown_item> explain_national_tariff(sys::state& state, dcon::nation_id n, bool import_flag, bool export_flag);
+trade_and_tariff<dcon::trade_route_id> explain_trade_route_commodity(sys::state& state, dcon::trade_route_id route, dcon::commodity_id cid);
+// sum of the volumes of all commodities on the route, at their median prices, positive when flowing from its first market to the second
+float trade_route_value(sys::state& state, dcon::trade_route_id route);
+// the markets connected to m by a trade route, in the order of its trade routes
+std::vector<dcon::market_id> const& trade_partners(sys::state& state, dcon::market_id m);
+}
+
 } // namespace economy
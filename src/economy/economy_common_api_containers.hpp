@@ -2,6 +2,8 @@
 
 #include "dcon_generated_ids.hpp"
 #include "container_types_dcon.hpp"
+#include "unordered_dense.h"
+#include "economy_templates_pure.hpp"
 
 namespace economy {
 
@@ -114,6 +116,50 @@ static_assert(sizeof(global_economy_state) ==
 	+ sizeof(global_economy_state::immigrator_modifier)
 	+ sizeof(global_economy_state::craftsmen_fraction));
 
+struct trade_breakdown_item {
+	dcon::nation_id trade_partner;
+	dcon::commodity_id commodity;
+	float traded_amount;
+	float tariff;
+};
+
+enum class explanation_query : uint8_t {
+	gold_income,
+	tariff_import_income,
+	tariff_export_income,
+	war_subsidies_income,
+	war_subsidies_spending,
+	reparations_income,
+	reparations_spending,
+	subject_payments_paid,
+	diplomatic_income,
+	private_construction_spendings,
+	investment_pool_daily_loss,
+	national_tariff,
+	trade_route_commodity,
+	trade_route_value,
+	trade_partners,
+};
+
+// results of expensive queries used by tooltips and reports
+// they are reused until the next game state update, so it should be accessed only from the ui thread
+struct explanation_cache {
+	ankerl::unordered_dense::map<uint64_t, float> values;
+	ankerl::unordered_dense::map<uint64_t, std::vector<trade_breakdown_item>> lists;
+	ankerl::unordered_dense::map<uint64_t, trade_and_tariff<dcon::trade_route_id>> trade_routes;
+	ankerl::unordered_dense::map<uint64_t, std::vector<dcon::market_id>> markets;
+
+	static uint64_t key(explanation_query query, uint32_t a, uint32_t b = 0) {
+		return (uint64_t(query) << 56) | (uint64_t(a) << 28) | uint64_t(b);
+	}
+	void clear() {
+		values.clear();
+		lists.clear();
+		trade_routes.clear();
+		markets.clear();
+	}
+};
+
 namespace gdp {
 struct breakdown {
 	float primary;
@@ -2,6 +2,7 @@
 #include "demographics.hpp"
 #include "economy_stats.hpp"
 #include "economy_trade_routes.hpp"
+#include "economy.hpp"
 #include "economy_constants.hpp"
 #include "money.hpp"
 #include "economy_templates_pure.hpp"
@@ -1340,7 +1341,7 @@ market_budget breakdown_market_budget(sys::state& unsafe_state, dcon::market_id
 
 	unsafe_state.world.for_each_commodity([&](auto cid) {
 		state.world.market_for_each_trade_route(m, [&](auto route){
-			trade_and_tariff<dcon::trade_route_id> details = explain_trade_route_commodity(unsafe_state, route, cid);
+			trade_and_tariff<dcon::trade_route_id> details = economy::cached::explain_trade_route_commodity(unsafe_state, route, cid);
 			if(m == details.origin) {
 				result.exports += details.payment_received_per_unit * details.amount_origin;
 			} else {
@@ -428,6 +428,7 @@ struct market_budget {
 	float estimated_change;
 };
 
+// for tooltips only: trade routes are read through economy::cached
 market_budget breakdown_market_budget(sys::state& state, dcon::market_id m);
 
 struct nation_monetary_breakdown {
@@ -5,6 +5,7 @@
 #include "economy_stats.hpp"
 #include "adaptive_ve.hpp"
 #include "economy_templates_pure.hpp"
+#include "economy_common_api_containers.hpp"
 
 namespace sys {
 struct state;
@@ -71,12 +72,6 @@ embargo_explanation embargo_exists(
 	sys::state& state, dcon::nation_id n_A, dcon::nation_id n_B
 );
 
-struct trade_breakdown_item {
-	dcon::nation_id trade_partner;
-	dcon::commodity_id commodity;
-	float traded_amount;
-	float tariff;
-};
 std::vector<trade_breakdown_item> explain_national_tariff(sys::state& state, dcon::nation_id n, bool import_flag, bool export_flag);
 
 
@@ -0,0 +1,310 @@
+#include "serialization.hpp"
+#include "system_state.hpp"
+#include "military.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// builds synthetic land and naval battles of a given size on a scenario and fights them to the end, timing every day of combat
+// the game seed is fixed by the seed argument, so the same scenario, seed and sizes always fight the same battles
+// at the end a hash of every regiment, ship and battle score is printed; two builds which print different hashes do not
+// simulate combat the same way. When the expected hash is given, a mismatch makes the benchmark exit with status 2
+//
+// usage: AliceBattleBench <scenario file> [seed] [battles] [regiments per side] [ships per side] [expected hash]
+
+static sys::state game_state; // too big for the stack
+
+namespace battle_bench {
+
+// splitmix64: the battle sites must not depend on the standard library the benchmark was built with
+struct random_source {
+	uint64_t value = 0;
+
+	uint64_t next() {
+		value += 0x9E3779B97F4A7C15ull;
+		auto z = value;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+	uint32_t below(uint32_t bound) {
+		return bound == 0 ? 0 : uint32_t(next() % bound);
+	}
+};
+
+struct battle_site {
+	dcon::province_id land;
+	dcon::province_id sea;
+	dcon::nation_id attacker;
+	dcon::nation_id defender;
+};
+
+struct unit_types {
+	dcon::unit_type_id infantry;
+	dcon::unit_type_id cavalry;
+	dcon::unit_type_id support;
+	dcon::unit_type_id big_ship;
+	dcon::unit_type_id light_ship;
+};
+
+unit_types find_unit_types(sys::state& state) {
+	unit_types result;
+	for(uint32_t i = 0; i < uint32_t(state.military_definitions.unit_base_definitions.size()); ++i) {
+		dcon::unit_type_id id{ dcon::unit_type_id::value_base_t(i) };
+		auto& def = state.military_definitions.unit_base_definitions[id];
+		if(!def.active)
+			continue;
+		auto pick = [&](dcon::unit_type_id& slot) {
+			if(!slot)
+				slot = id;
+		};
+		switch(def.type) {
+		case military::unit_type::infantry:
+			pick(result.infantry);
+			break;
+		case military::unit_type::cavalry:
+			pick(result.cavalry);
+			break;
+		case military::unit_type::support:
+			pick(result.support);
+			break;
+		case military::unit_type::big_ship:
+			pick(result.big_ship);
+			break;
+		case military::unit_type::light_ship:
+			pick(result.light_ship);
+			break;
+		default:
+			break;
+		}
+	}
+	if(!result.cavalry)
+		result.cavalry = result.infantry;
+	if(!result.support)
+		result.support = result.infantry;
+	if(!result.light_ship)
+		result.light_ship = result.big_ship;
+	return result;
+}
+
+// land provinces with an empty neighbor owned by a different nation; the neighbor's owner attacks the province
+std::vector<battle_site> pick_sites(sys::state& state, random_source& rng, uint32_t count) {
+	std::vector<battle_site> candidates;
+	for(auto p : state.world.in_province) {
+		if(p.id.index() >= state.province_definitions.first_sea_province.index())
+			break;
+		auto owner = p.get_nation_from_province_ownership();
+		if(!owner || p.get_army_location().begin() != p.get_army_location().end())
+			continue;
+		for(auto adj : p.get_province_adjacency()) {
+			auto other = adj.get_connected_provinces(0) == p ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			auto other_owner = other.get_nation_from_province_ownership();
+			if(other_owner && other_owner != owner && (adj.get_type() & province::border::impassible_bit) == 0) {
+				candidates.push_back(battle_site{ p, dcon::province_id{ }, other_owner, owner });
+				break;
+			}
+		}
+	}
+
+	auto first_sea = uint32_t(state.province_definitions.first_sea_province.index());
+	auto sea_count = uint32_t(state.world.province_size()) - first_sea;
+
+	std::vector<battle_site> result;
+	for(uint32_t i = 0; i < count && !candidates.empty(); ++i) {
+		auto pick = rng.below(uint32_t(candidates.size()));
+		auto site = candidates[pick];
+		candidates[pick] = candidates.back();
+		candidates.pop_back();
+		site.sea = dcon::province_id{ dcon::province_id::value_base_t(first_sea + rng.below(sea_count)) };
+		result.push_back(site);
+	}
+	return result;
+}
+
+dcon::army_id make_army(sys::state& state, unit_types const& types, dcon::nation_id n, uint32_t regiments) {
+	auto a = fatten(state.world, state.world.create_army());
+	a.set_controller_from_army_control(n);
+	for(uint32_t i = 0; i < regiments; ++i) {
+		// two thirds infantry, the rest shared between artillery and cavalry
+		auto t = (i % 6 == 4) ? types.support : (i % 6 == 5) ? types.cavalry : types.infantry;
+		auto reg = military::create_new_regiment(state, n, t);
+		state.world.try_create_army_membership(reg, a);
+	}
+	return a;
+}
+
+dcon::navy_id make_navy(sys::state& state, unit_types const& types, dcon::nation_id n, uint32_t ships) {
+	auto a = fatten(state.world, state.world.create_navy());
+	a.set_controller_from_navy_control(n);
+	for(uint32_t i = 0; i < ships; ++i) {
+		auto shp = military::create_new_ship(state, n, (i % 2 == 0) ? types.big_ship : types.light_ship);
+		state.world.try_create_navy_membership(shp, a);
+	}
+	return a;
+}
+
+void start_battles(sys::state& state, std::vector<battle_site> const& sites, uint32_t regiments, uint32_t ships) {
+	auto types = find_unit_types(state);
+	for(auto& s : sites) {
+		if(!military::are_at_war(state, s.attacker, s.defender))
+			military::create_war(state, s.attacker, s.defender, dcon::cb_type_id{ }, dcon::state_definition_id{ }, dcon::national_identity_id{ }, dcon::nation_id{ });
+		if(regiments > 0 && types.infantry) {
+			military::army_arrives_in_province(state, make_army(state, types, s.defender, regiments), s.land, military::crossing_type::none);
+			military::army_arrives_in_province(state, make_army(state, types, s.attacker, regiments), s.land, military::crossing_type::none);
+		}
+		if(ships > 0 && types.big_ship) {
+			military::navy_arrives_in_province(state, make_navy(state, types, s.defender, ships), s.sea);
+			military::navy_arrives_in_province(state, make_navy(state, types, s.attacker, ships), s.sea);
+		}
+	}
+}
+
+uint32_t count_battles(sys::state& state) {
+	uint32_t total = 0;
+	for([[maybe_unused]] auto b : state.world.in_land_battle)
+		++total;
+	for([[maybe_unused]] auto b : state.world.in_naval_battle)
+		++total;
+	return total;
+}
+
+struct hasher {
+	uint64_t value = 0xCBF29CE484222325ull;
+
+	void add(uint64_t v) {
+		value = (value ^ v) * 0x100000001B3ull;
+	}
+	void add(float v) {
+		uint32_t bits = 0;
+		std::memcpy(&bits, &v, sizeof(bits));
+		add(uint64_t(bits));
+	}
+};
+
+// everything combat writes to: surviving units, their condition and where they ended up, and the battle scores of the wars
+uint64_t hash_combat_state(sys::state& state) {
+	hasher h;
+	for(auto r : state.world.in_regiment) {
+		h.add(uint64_t(r.id.index()));
+		h.add(r.get_strength());
+		h.add(r.get_org());
+		h.add(r.get_experience());
+		h.add(uint64_t(r.get_army_from_army_membership().id.index()));
+	}
+	for(auto s : state.world.in_ship) {
+		h.add(uint64_t(s.id.index()));
+		h.add(s.get_strength());
+		h.add(s.get_org());
+		h.add(s.get_experience());
+		h.add(uint64_t(s.get_navy_from_navy_membership().id.index()));
+	}
+	for(auto a : state.world.in_army) {
+		h.add(uint64_t(a.get_location_from_army_location().id.index()));
+		h.add(uint64_t(a.get_is_retreating()));
+	}
+	for(auto n : state.world.in_navy) {
+		h.add(uint64_t(n.get_location_from_navy_location().id.index()));
+		h.add(uint64_t(n.get_is_retreating()));
+	}
+	for(auto w : state.world.in_war) {
+		h.add(w.get_attacker_battle_score());
+		h.add(w.get_defender_battle_score());
+	}
+	return h.value;
+}
+
+uint64_t percentile(std::vector<uint64_t> values, uint32_t p) {
+	if(values.empty())
+		return 0;
+	auto k = (values.size() - 1) * p / 100;
+	std::nth_element(values.begin(), values.begin() + k, values.end());
+	return values[k];
+}
+
+template<typename F>
+uint64_t time_ns(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	if(argc < 2) {
+		std::fprintf(stderr, "usage: %s <scenario file> [seed] [battles] [regiments per side] [ships per side] [expected hash]\n", argv[0]);
+		return 1;
+	}
+	uint64_t seed = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 1836;
+	uint32_t battles = argc >= 4 ? uint32_t(std::strtoul(argv[3], nullptr, 10)) : 64;
+	uint32_t regiments = argc >= 5 ? uint32_t(std::strtoul(argv[4], nullptr, 10)) : 30;
+	uint32_t ships = argc >= 6 ? uint32_t(std::strtoul(argv[5], nullptr, 10)) : 20;
+	bool check_hash = argc >= 7;
+	uint64_t expected_hash = check_hash ? std::strtoull(argv[6], nullptr, 16) : 0;
+	constexpr uint32_t max_days = 730;
+
+	add_root(game_state.common_fs, NATIVE("."));
+	if(!sys::try_read_scenario_and_save_file(game_state, argv[1])) {
+		std::fprintf(stderr, "could not load the scenario %s\n", argv[1]);
+		return 1;
+	}
+	game_state.fill_unsaved_data();
+	game_state.game_seed = uint32_t(seed);
+
+	std::printf("scenario %s, seed %llu, %u battles, %u regiments and %u ships per side\n", argv[1], (unsigned long long)seed, battles, regiments, ships);
+
+	battle_bench::random_source rng{ seed };
+	auto sites = battle_bench::pick_sites(game_state, rng, battles);
+	if(sites.empty()) {
+		std::fprintf(stderr, "the scenario has no borders to fight over\n");
+		return 1;
+	}
+	battle_bench::start_battles(game_state, sites, regiments, ships);
+
+	// the daily combat steps of single_game_tick, in the same order
+	std::vector<uint64_t> naval_ns;
+	std::vector<uint64_t> land_ns;
+	std::vector<uint64_t> damage_ns;
+	std::printf("  %6s %8s %8s %12s %12s %12s\n", "day", "land", "naval", "naval us", "land us", "damage us");
+	uint32_t day = 0;
+	for(; day < max_days; ++day) {
+		uint32_t land_count = 0;
+		for([[maybe_unused]] auto b : game_state.world.in_land_battle)
+			++land_count;
+		uint32_t naval_count = 0;
+		for([[maybe_unused]] auto b : game_state.world.in_naval_battle)
+			++naval_count;
+		if(land_count + naval_count == 0)
+			break;
+
+		game_state.current_date += 1;
+		naval_ns.push_back(battle_bench::time_ns([&]() { military::update_naval_battles(game_state); }));
+		land_ns.push_back(battle_bench::time_ns([&]() { military::update_land_battles(game_state); }));
+		damage_ns.push_back(battle_bench::time_ns([&]() { military::apply_regiment_damage(game_state); }));
+
+		std::printf("  %6u %8u %8u %12.1f %12.1f %12.1f\n", day + 1, land_count, naval_count,
+			double(naval_ns.back()) / 1000.0, double(land_ns.back()) / 1000.0, double(damage_ns.back()) / 1000.0);
+	}
+
+	std::printf("%u days of combat%s\n", day, battle_bench::count_battles(game_state) != 0 ? ", stopped with battles still running" : "");
+	std::printf("  %-24s %12s %12s %12s\n", "step", "p50 us", "p99 us", "total ms");
+	for(auto [name, values] : { std::pair{ "update_naval_battles", &naval_ns }, std::pair{ "update_land_battles", &land_ns }, std::pair{ "apply_regiment_damage", &damage_ns } }) {
+		uint64_t total = 0;
+		for(auto v : *values)
+			total += v;
+		std::printf("  %-24s %12.1f %12.1f %12.2f\n", name, double(battle_bench::percentile(*values, 50)) / 1000.0,
+			double(battle_bench::percentile(*values, 99)) / 1000.0, double(total) / 1000000.0);
+	}
+
+	auto hash = battle_bench::hash_combat_state(game_state);
+	std::printf("combat state hash %016llx\n", (unsigned long long)hash);
+	if(check_hash && hash != expected_hash) {
+		std::printf("expected %016llx\n", (unsigned long long)expected_hash);
+		return 2;
+	}
+	return 0;
+}
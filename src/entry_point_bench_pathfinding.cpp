@@ -0,0 +1,273 @@
+#include "serialization.hpp"
+#include "system_state.hpp"
+#include "province_templates.hpp"
+#include "military.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// replays a seeded workload of unit pathfinding queries on a scenario and reports, per situation and kind of query,
+// the median and 99th percentile latency, the provinces expanded and the allocations made
+// the same scenario and seed always produce the same queries, and a hash of the resulting paths is printed
+// so that two builds can be compared both for speed and for finding the same routes
+//
+// usage: AlicePathfindingBench <scenario file> [seed] [queries per kind]
+
+static sys::state game_state; // too big for the stack
+static std::atomic<uint64_t> bench_allocations{ 0 };
+
+void* operator new(std::size_t size) {
+	bench_allocations.fetch_add(1, std::memory_order_relaxed);
+	if(auto ptr = std::malloc(size == 0 ? 1 : size); ptr)
+		return ptr;
+	std::abort();
+}
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace pathfinding_bench {
+
+// splitmix64: the workload must not depend on the standard library the benchmark was built with
+struct random_source {
+	uint64_t value = 0;
+
+	uint64_t next() {
+		value += 0x9E3779B97F4A7C15ull;
+		auto z = value;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+	uint32_t below(uint32_t bound) {
+		return bound == 0 ? 0 : uint32_t(next() % bound);
+	}
+};
+
+enum class query_kind : uint8_t {
+	land_unit, naval_unit, land_retreat, naval_retreat, nearest_coast, count
+};
+constexpr char const* query_kind_names[] = { "land unit path", "naval unit path", "land retreat path", "naval retreat path", "path to nearest coast" };
+
+struct query {
+	query_kind kind = query_kind::land_unit;
+	dcon::nation_id nation_as;
+	dcon::army_id army;
+	dcon::province_id start;
+	dcon::province_id end;
+};
+
+struct query_class_result {
+	std::vector<uint64_t> latencies_ns;
+	uint64_t provinces_expanded = 0;
+	uint64_t allocations = 0;
+	uint64_t found = 0;
+	uint64_t path_hash = 0xCBF29CE484222325ull;
+};
+
+// a random land province owned by the nation or by one of its neighbors, where an army would plausibly be sent
+dcon::province_id pick_land_target(sys::state& state, random_source& rng, dcon::nation_id n) {
+	static std::vector<dcon::nation_id> owners;
+	static std::vector<dcon::province_id> provinces;
+	owners.clear();
+	owners.push_back(n);
+	for(auto adj : state.world.nation_get_nation_adjacency(n)) {
+		auto other = adj.get_connected_nations(0).id == n ? adj.get_connected_nations(1).id : adj.get_connected_nations(0).id;
+		if(other)
+			owners.push_back(other);
+	}
+	auto owner = owners[rng.below(uint32_t(owners.size()))];
+	provinces.clear();
+	for(auto o : state.world.nation_get_province_ownership(owner))
+		provinces.push_back(o.get_province());
+	if(provinces.empty())
+		return dcon::province_id{ };
+	return provinces[rng.below(uint32_t(provinces.size()))];
+}
+
+dcon::province_id pick_sea_target(sys::state& state, random_source& rng) {
+	auto first_sea = uint32_t(state.province_definitions.first_sea_province.index());
+	auto sea_count = uint32_t(state.world.province_size()) - first_sea;
+	return dcon::province_id{ dcon::province_id::value_base_t(first_sea + rng.below(sea_count)) };
+}
+
+std::vector<query> make_workload(sys::state& state, random_source& rng, uint32_t queries_per_kind) {
+	std::vector<dcon::army_id> armies;
+	for(auto a : state.world.in_army) {
+		if(a.get_location_from_army_location() && a.get_controller_from_army_control())
+			armies.push_back(a);
+	}
+	std::vector<dcon::navy_id> navies;
+	for(auto n : state.world.in_navy) {
+		if(n.get_location_from_navy_location() && n.get_controller_from_navy_control())
+			navies.push_back(n);
+	}
+
+	std::vector<query> result;
+	if(armies.empty() || navies.empty())
+		return result;
+
+	for(uint32_t i = 0; i < queries_per_kind; ++i) {
+		auto a = armies[rng.below(uint32_t(armies.size()))];
+		auto owner = state.world.army_get_controller_from_army_control(a);
+		auto location = state.world.army_get_location_from_army_location(a);
+		if(auto target = pick_land_target(state, rng, owner); target && target != location)
+			result.push_back(query{ query_kind::land_unit, owner, a, location, target });
+		result.push_back(query{ query_kind::land_retreat, owner, a, location, dcon::province_id{ } });
+		result.push_back(query{ query_kind::nearest_coast, owner, a, location, dcon::province_id{ } });
+
+		auto n = navies[rng.below(uint32_t(navies.size()))];
+		auto navy_owner = state.world.navy_get_controller_from_navy_control(n);
+		auto navy_location = state.world.navy_get_location_from_navy_location(n);
+		if(auto target = pick_sea_target(state, rng); target != navy_location)
+			result.push_back(query{ query_kind::naval_unit, navy_owner, dcon::army_id{ }, navy_location, target });
+		result.push_back(query{ query_kind::naval_retreat, navy_owner, dcon::army_id{ }, navy_location, dcon::province_id{ } });
+	}
+	return result;
+}
+
+std::vector<dcon::province_id> run_query(sys::state& state, query const& q) {
+	switch(q.kind) {
+	case query_kind::land_unit:
+		return province::make_land_unit_path(state, q.start, q.end, q.nation_as, q.army);
+	case query_kind::naval_unit:
+		return province::make_naval_unit_path(state, q.start, q.end, q.nation_as);
+	case query_kind::land_retreat:
+		return province::make_land_auto_retreat_path(state, q.nation_as, q.start);
+	case query_kind::naval_retreat:
+		return province::make_naval_retreat_path(state, q.nation_as, q.start);
+	case query_kind::nearest_coast:
+		return province::make_path_to_nearest_coast(state, q.nation_as, q.start);
+	default:
+		return std::vector<dcon::province_id>{ };
+	}
+}
+
+uint64_t percentile(std::vector<uint64_t>& values, uint32_t p) {
+	if(values.empty())
+		return 0;
+	auto k = (values.size() - 1) * p / 100;
+	std::nth_element(values.begin(), values.begin() + k, values.end());
+	return values[k];
+}
+
+void run_situation(sys::state& state, char const* situation, std::vector<query> const& workload) {
+	query_class_result results[size_t(query_kind::count)];
+	auto& workspace = province::path_workspace::for_this_thread();
+
+	for(auto& q : workload) {
+		auto& r = results[size_t(q.kind)];
+		auto expanded_before = workspace.provinces_expanded;
+		auto allocations_before = bench_allocations.load(std::memory_order_relaxed);
+		auto start = std::chrono::steady_clock::now();
+
+		auto path = run_query(state, q);
+
+		auto end = std::chrono::steady_clock::now();
+		r.allocations += bench_allocations.load(std::memory_order_relaxed) - allocations_before;
+		r.provinces_expanded += workspace.provinces_expanded - expanded_before;
+		r.latencies_ns.push_back(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+		if(!path.empty())
+			++r.found;
+		for(auto p : path) {
+			r.path_hash = (r.path_hash ^ uint64_t(p.index())) * 0x100000001B3ull;
+		}
+		r.path_hash = (r.path_hash ^ uint64_t(path.size())) * 0x100000001B3ull;
+	}
+
+	std::printf("%s\n", situation);
+	std::printf("  %-24s %8s %8s %10s %10s %12s %12s %18s\n", "query", "count", "found", "p50 us", "p99 us", "expanded/q", "allocs/q", "path hash");
+	for(uint32_t k = 0; k < uint32_t(query_kind::count); ++k) {
+		auto& r = results[k];
+		auto count = uint64_t(r.latencies_ns.size());
+		if(count == 0)
+			continue;
+		std::printf("  %-24s %8llu %8llu %10.1f %10.1f %12.1f %12.1f   %016llx\n", query_kind_names[k],
+			(unsigned long long)count, (unsigned long long)r.found,
+			double(percentile(r.latencies_ns, 50)) / 1000.0, double(percentile(r.latencies_ns, 99)) / 1000.0,
+			double(r.provinces_expanded) / double(count), double(r.allocations) / double(count),
+			(unsigned long long)r.path_hash);
+	}
+}
+
+// every nation grants military access to all of its neighbors
+void grant_access_to_neighbors(sys::state& state) {
+	for(auto adj : state.world.in_nation_adjacency) {
+		auto a = adj.get_connected_nations(0);
+		auto b = adj.get_connected_nations(1);
+		if(!a || !b)
+			continue;
+		for(auto [asker, target] : { std::pair{ a.id, b.id }, std::pair{ b.id, a.id } }) {
+			auto urel = state.world.get_unilateral_relationship_by_unilateral_pair(asker, target);
+			if(!urel)
+				urel = state.world.force_create_unilateral_relationship(asker, target);
+			state.world.unilateral_relationship_set_military_access(urel, true);
+		}
+	}
+	state.path_cache.invalidate();
+}
+
+// puts some neighboring nations at war with each other, so that enemy territory and enemy armies come into play
+void start_wars(sys::state& state, random_source& rng, uint32_t count) {
+	std::vector<dcon::nation_adjacency_id> candidates;
+	for(auto adj : state.world.in_nation_adjacency) {
+		auto a = adj.get_connected_nations(0);
+		auto b = adj.get_connected_nations(1);
+		if(a && b && a.get_owned_province_count() > 0 && b.get_owned_province_count() > 0 && !military::are_at_war(state, a, b))
+			candidates.push_back(adj);
+	}
+	for(uint32_t i = 0; i < count && !candidates.empty(); ++i) {
+		auto pick = rng.below(uint32_t(candidates.size()));
+		auto a = state.world.nation_adjacency_get_connected_nations(candidates[pick], 0);
+		auto b = state.world.nation_adjacency_get_connected_nations(candidates[pick], 1);
+		candidates[pick] = candidates.back();
+		candidates.pop_back();
+		if(!military::are_at_war(state, a, b))
+			military::create_war(state, a, b, dcon::cb_type_id{ }, dcon::state_definition_id{ }, dcon::national_identity_id{ }, dcon::nation_id{ });
+	}
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	if(argc < 2) {
+		std::fprintf(stderr, "usage: %s <scenario file> [seed] [queries per kind]\n", argv[0]);
+		return 1;
+	}
+	uint64_t seed = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 1836;
+	uint32_t queries_per_kind = argc >= 4 ? uint32_t(std::strtoul(argv[3], nullptr, 10)) : 2000;
+
+	add_root(game_state.common_fs, NATIVE("."));
+	if(!sys::try_read_scenario_and_save_file(game_state, argv[1])) {
+		std::fprintf(stderr, "could not load the scenario %s\n", argv[1]);
+		return 1;
+	}
+	game_state.fill_unsaved_data();
+
+	std::printf("scenario %s, seed %llu, %u queries per kind\n", argv[1], (unsigned long long)seed, queries_per_kind);
+
+	pathfinding_bench::random_source rng{ seed };
+	auto workload = pathfinding_bench::make_workload(game_state, rng, queries_per_kind);
+	if(workload.empty()) {
+		std::fprintf(stderr, "the scenario has no armies or navies to move\n");
+		return 1;
+	}
+
+	pathfinding_bench::run_situation(game_state, "at peace", workload);
+
+	pathfinding_bench::grant_access_to_neighbors(game_state);
+	pathfinding_bench::run_situation(game_state, "military access between all neighbors", workload);
+
+	pathfinding_bench::start_wars(game_state, rng, 64);
+	pathfinding_bench::run_situation(game_state, "neighbors at war", workload);
+
+	return 0;
+}
@@ -1098,6 +1098,7 @@ void execute_make_vassal(sys::state& state, dcon::nation_id source, dcon::nation
 	auto holder = state.world.national_identity_get_nation_from_identity_holder(t);
 	state.world.force_create_overlord(holder, source);
 	state.trade_route_cached_values_out_of_date = true;
+	state.path_cache.relations_changed(holder, source);
 	if(state.world.nation_get_is_great_power(source)) {
 		nations::sphere_nation(state, holder, source);
 	}
@@ -1137,6 +1138,7 @@ void execute_release_and_play_as(sys::state& state, dcon::nation_id source, dcon
 	for(auto p : state.world.nation_get_province_ownership(holder)) {
 		auto pid = p.get_province();
 		state.world.province_set_is_colonial(pid, false);
+		province::mark_cached_values_dirty(state, pid.id);
 	}
 }
 
@@ -2650,6 +2652,7 @@ void execute_give_military_access(sys::state& state, dcon::nation_id asker, dcon
 		urel = state.world.force_create_unilateral_relationship(asker, target);
 	}
 	state.world.unilateral_relationship_set_military_access(urel, true);
+	state.path_cache.relations_changed(asker, target);
 	nations::adjust_relationship(state, asker, target, state.defines.givemilaccess_relation_on_accept);
 }
 
@@ -3229,6 +3232,7 @@ void execute_cancel_military_access(sys::state& state, dcon::nation_id source, d
 	auto rel = state.world.get_unilateral_relationship_by_unilateral_pair(target, source);
 	if(rel)
 		state.world.unilateral_relationship_set_military_access(rel, false);
+	state.path_cache.relations_changed(source, target);
 
 	auto& current_diplo = state.world.nation_get_diplomatic_points(source);
 	state.world.nation_set_diplomatic_points(source, current_diplo - state.defines.cancelaskmilaccess_diplomatic_cost);
@@ -3280,6 +3284,7 @@ void execute_cancel_given_military_access(sys::state& state, dcon::nation_id sou
 	auto rel = state.world.get_unilateral_relationship_by_unilateral_pair(source, target);
 	if(rel)
 		state.world.unilateral_relationship_set_military_access(rel, false);
+	state.path_cache.relations_changed(source, target);
 
 	auto& current_diplo = state.world.nation_get_diplomatic_points(source);
 	state.world.nation_set_diplomatic_points(source, current_diplo - state.defines.cancelgivemilaccess_diplomatic_cost);
@@ -3887,7 +3892,7 @@ void execute_send_crisis_peace_offer(sys::state& state, dcon::nation_id source)
 			if(!state.world.peace_offer_get_war_from_war_settlement(pending_offer))
 				nations::cleanup_crisis_peace_offer(state, pending_offer);
 			else
-				state.world.delete_peace_offer(pending_offer);
+				military::delete_peace_offer(state, pending_offer);
 		}
 		return;
 	}
@@ -5204,6 +5209,7 @@ bool can_move_capital(sys::state& state, dcon::nation_id source, dcon::province_
 
 void execute_move_capital(sys::state& state, dcon::nation_id source, dcon::province_id p) {
 	state.world.nation_set_capital(source, p);
+	province::mark_cached_values_dirty(state, source); // which provinces are overseas depends on the capital
 }
 
 void toggle_local_administration(sys::state& state, dcon::nation_id source, dcon::province_id prov) {
@@ -7976,8 +7982,12 @@ void execute_pending_commands(sys::state& state) {
 
 	if(command_executed) {
 		province::update_connected_regions(state);
+		province::update_region_hierarchy(state);
 		province::update_cached_values(state);
 		nations::update_cached_values(state);
+		military::update_war_relations(state);
+		military::update_war_scores(state);
+		military::update_supply_fields(state);
 		state.game_state_updated.store(true, std::memory_order::release);
 	}
 }
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
 #include "constants_state.hpp"
 #include "game_scene_default.hpp"
 #include "economy_common_api_containers.hpp"
@@ -17,6 +23,23 @@ struct global_provincial_state {
 	std::vector<dcon::province_id> canal_provinces;
 	ankerl::unordered_dense::map<dcon::modifier_id, dcon::gfx_object_id, sys::modifier_hash> terrain_to_gfx_map;
 	std::vector<bool> connected_region_is_coastal;
+
+	// bookkeeping for update_connected_regions, which only refills the regions touched by ownership changes
+	struct nation_border {
+		dcon::nation_id a;
+		dcon::nation_id b;
+		int32_t count = 0; // passable land borders between provinces of a and b
+	};
+	ankerl::unordered_dense::map<uint64_t, nation_border> nation_borders;
+	ankerl::unordered_dense::map<int32_t, dcon::nation_id> owner_before_change; // by province index, the owner at the last update
+	bool connected_regions_need_rebuild = true;
+
+	// bookkeeping for update_cached_values, which only recounts the nations touched by the provinces marked since the last update
+	std::vector<uint8_t> cached_values_dirty; // by province index
+	std::vector<dcon::province_id> cached_values_dirty_provinces;
+	std::vector<dcon::nation_id> cached_values_dirty_nations;
+	bool cached_values_need_rebuild = true;
+
 	dcon::province_id first_sea_province;
 	dcon::modifier_id europe;
 	dcon::modifier_id asia;
@@ -25,4 +48,194 @@ struct global_provincial_state {
 	dcon::modifier_id south_america;
 	dcon::modifier_id oceania;
 };
+
+// packed copy of the province adjacencies for graph walks: the edges of a province are contiguous and carry everything a search reads
+// built by fill_unsaved_data; the adjacencies themselves never change afterwards, only the type of a canal when it is enabled
+struct adjacency_graph {
+	struct edge {
+		float distance = 0.0f;
+		dcon::province_adjacency_id adjacency;
+		dcon::province_id neighbor;
+		uint8_t type = 0;
+	};
+
+	std::vector<uint32_t> offsets; // the edges of province p are [offsets[p], offsets[p + 1])
+	std::vector<edge> edges;
+
+	std::span<edge const> neighbors(dcon::province_id p) const {
+		assert(size_t(p.index()) + 1 < offsets.size());
+		return std::span<edge const>(edges.data() + offsets[p.index()], edges.data() + offsets[p.index() + 1]);
+	}
+};
+
+// table for distance estimates, built by fill_unsaved_data
+// landmark_distances: for every province, the shortest distance over the adjacency graph to each landmark; passability is ignored, so
+// |d(landmark, a) - d(landmark, b)| never exceeds a path between a and b whose steps cost at least the distance of their adjacency
+struct distance_oracle {
+	static constexpr uint32_t landmark_count = 16;
+
+	std::vector<dcon::province_id> landmarks;
+	std::vector<float> landmark_distances; // [province * landmarks.size() + landmark], infinity where the landmark cannot be reached
+};
+
+enum class path_kind : uint8_t {
+	safe_land, safe_land_estimate, naval_unit, land_trade
+};
+
+// results of the pathfinding functions which depend only on the map and the diplomatic situation
+// the epoch is advanced by changes which may affect any path: ownership, buildings, provincial modifiers, canals or a new map
+// an entry also records the dependency epochs it was found under, and is used only while none of them moved on:
+// - the territory of every nation controlling a province the search looked at, advanced when one of its provinces changes controller or siege state
+// - the relations of the nation the path is for, advanced on changes to its wars, military access, sphere or subjects
+// blockades of sea straits depend on fleet positions and are compared on every lookup instead, against a blocked set kept per nation
+// until either the epoch or the fleet epoch, advanced when a fleet enters, leaves or disappears from a strait, moves on
+struct path_cache {
+	static constexpr uint32_t shard_count = 16;
+	static constexpr uint32_t max_shard_entries = 2048;
+	static constexpr uint32_t nation_slots = 1024; // nations share a slot when their index is the same modulo this, which only costs extra misses
+
+	// the dependency epochs, by slot
+	static constexpr uint32_t any_territory_slot = 2 * nation_slots; // any territory, for searches which cannot tell which provinces they looked at
+	static constexpr uint32_t hierarchy_slot = 2 * nation_slots + 1; // the clusters of state.region_hierarchy
+	static constexpr uint32_t dependency_slot_count = 2 * nation_slots + 2;
+	static uint32_t territory_slot(dcon::nation_id n) { // provinces without a controller share the slot of the invalid nation
+		return uint32_t(n.index()) & (nation_slots - 1);
+	}
+	static uint32_t relations_slot(dcon::nation_id n) {
+		return nation_slots + (uint32_t(n.index()) & (nation_slots - 1));
+	}
+
+	struct dependency {
+		uint32_t slot = 0;
+		uint32_t epoch = 0;
+	};
+	struct entry {
+		std::vector<dcon::province_id> path;
+		std::vector<uint64_t> blocked_straits;
+		std::vector<dependency> dependencies;
+	};
+	struct shard {
+		std::shared_mutex lock;
+		uint32_t epoch = 0;
+		ankerl::unordered_dense::map<uint64_t, entry> entries;
+	};
+
+	std::array<shard, shard_count> shards;
+	std::atomic<uint32_t> epoch = 1;
+
+	std::mutex straits_lock;
+	std::atomic<bool> straits_ready = false;
+	std::vector<dcon::province_id> straits; // sea provinces which can blockade a crossing, sorted by index
+
+	struct blocked_straits_entry {
+		uint32_t epoch = 0;
+		uint32_t fleet_epoch = 0;
+		std::vector<uint64_t> bits; // one per entry of straits
+	};
+	std::shared_mutex blocked_straits_lock;
+	std::vector<blocked_straits_entry> blocked_straits; // by nation index
+	std::atomic<uint32_t> fleet_epoch = 1;
+
+	std::array<std::atomic<uint32_t>, dependency_slot_count> dependency_epochs{ };
+	std::atomic<uint32_t> dependency_changes = 0; // advanced with every dependency epoch, so that a search can tell whether any moved on while it ran
+
+	void invalidate() {
+		epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+	void dependency_changed(uint32_t slot) {
+		dependency_epochs[slot].fetch_add(1, std::memory_order_acq_rel);
+		dependency_changes.fetch_add(1, std::memory_order_acq_rel);
+	}
+	// to be called with the controller of a province before and after its controller or siege state changes
+	void territory_changed(dcon::nation_id controller) {
+		dependency_changed(territory_slot(controller));
+		dependency_changed(any_territory_slot);
+	}
+	// to be called with both sides when anything deciding whether one may pass through the provinces of the other changes
+	void relations_changed(dcon::nation_id a, dcon::nation_id b) {
+		dependency_changed(relations_slot(a));
+		dependency_changed(relations_slot(b));
+	}
+	void hierarchy_changed() {
+		dependency_changed(hierarchy_slot);
+	}
+	bool is_current(std::vector<dependency> const& dependencies) const {
+		for(auto& d : dependencies) {
+			if(dependency_epochs[d.slot].load(std::memory_order_acquire) != d.epoch)
+				return false;
+		}
+		return true;
+	}
+	// to be called with the province a fleet arrives in, leaves or is removed from
+	void fleet_moved(dcon::province_id p) {
+		if(straits_ready.load(std::memory_order_acquire)
+			&& !std::binary_search(straits.begin(), straits.end(), p, [](auto a, auto b) { return a.index() < b.index(); })) {
+			return;
+		}
+		fleet_epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+	void reset() { // a different map may be loaded
+		straits_ready.store(false, std::memory_order_release);
+		invalidate();
+	}
+};
+
+// paths of sea trade routes by the pair of coastal provinces they connect
+// they depend only on the map, so they are kept until a canal opens or a different map is loaded
+struct sea_trade_path_cache {
+	std::shared_mutex lock;
+	ankerl::unordered_dense::map<uint64_t, std::vector<dcon::province_id>> paths;
+
+	void reset() {
+		std::unique_lock guard{ lock };
+		paths.clear();
+	}
+};
+
+// two level view of the map used by make_hierarchical_path_to_prov
+// land provinces are clustered by state and controller; sea provinces and land provinces without a state are clusters of their own
+// portals are the passable adjacencies leading out of a cluster
+// provinces which change controller, owner or adjacencies are queued, and their clusters are rebuilt before the next search
+struct region_hierarchy {
+	struct portal {
+		dcon::province_adjacency_id adjacency;
+		dcon::province_id from; // inside the cluster
+		dcon::province_id to;
+		uint32_t to_cluster = 0;
+	};
+	struct cluster {
+		std::vector<dcon::province_id> provinces; // sorted by index
+		std::vector<portal> portals;
+		dcon::province_id center; // the member closest to all the others, used for distances between clusters
+		uint64_t key = 0;
+	};
+
+	std::vector<cluster> clusters; // emptied clusters are kept with no provinces and reused
+	std::vector<uint32_t> free_clusters;
+	std::vector<uint32_t> province_cluster; // by province index
+	ankerl::unordered_dense::map<uint64_t, uint32_t> cluster_by_key;
+	std::shared_mutex lock;
+
+	std::mutex pending_lock;
+	std::vector<dcon::province_id> pending;
+	bool pending_full_rebuild = true;
+	std::atomic<bool> has_pending = true;
+
+	void mark_changed(dcon::province_id p) {
+		std::lock_guard guard{ pending_lock };
+		pending.push_back(p);
+		has_pending.store(true, std::memory_order_release);
+	}
+	void mark_changed(std::span<const dcon::province_id> provinces) {
+		std::lock_guard guard{ pending_lock };
+		pending.insert(pending.end(), provinces.begin(), provinces.end());
+		has_pending.store(true, std::memory_order_release);
+	}
+	void reset() { // a different map may be loaded
+		std::lock_guard guard{ pending_lock };
+		pending.clear();
+		pending_full_rebuild = true;
+		has_pending.store(true, std::memory_order_release);
+	}
+};
 }
@@ -297,6 +297,7 @@ void accept(sys::state& state, message const& m) {
 			rel = state.world.force_create_unilateral_relationship(m.to, m.from);
 		}
 		state.world.unilateral_relationship_set_military_access(rel, true);
+		state.path_cache.relations_changed(m.to, m.from);
 
 		notification::post(state, notification::message{
 			[source = m.from, target = m.to](sys::state& state, text::layout_base& contents) {
@@ -383,8 +384,10 @@ void accept(sys::state& state, message const& m) {
 			}
 		}
 		province::update_connected_regions(state);
+		province::update_region_hierarchy(state);
 		province::update_cached_values(state);
 		nations::update_cached_values(state);
+		military::update_war_relations(state);
 		break;
 	}
 }
@@ -79,6 +79,7 @@ void add_modifier_to_nation(sys::state& state, dcon::nation_id target_nation, dc
 	lst.push_back(sys::dated_modifier{expiration, mod_id});
 }
 void add_modifier_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, sys::date expiration) {
+	state.path_cache.invalidate(); // movement costs may change
 	assert(state.world.province_is_valid(target_prov) && "Invalid write incoming!");
 	auto lst = state.world.province_get_current_modifiers(target_prov);
 	for(auto& m : lst) {
@@ -103,6 +104,7 @@ void remove_modifier_from_nation(sys::state& state, dcon::nation_id target_natio
 }
 
 void remove_modifier_from_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id) {
+	state.path_cache.invalidate(); // movement costs may change
 	auto modifiers_range = state.world.province_get_current_modifiers(target_prov);
 	auto count = modifiers_range.size();
 	for(uint32_t i = count; i-- > 0;) {
@@ -114,6 +116,7 @@ void remove_modifier_from_province(sys::state& state, dcon::province_id target_p
 }
 
 void toggle_modifier_from_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, sys::date expiration) {
+	state.path_cache.invalidate(); // movement costs may change
 	assert(state.world.province_is_valid(target_prov) && "Invalid write incoming!");
 	auto lst = state.world.province_get_current_modifiers(target_prov);
 	auto modifiers_range = state.world.province_get_current_modifiers(target_prov);
@@ -563,7 +566,8 @@ void update_single_nation_modifiers(sys::state& state, dcon::nation_id n) {
 }
 
 void recreate_province_modifiers(sys::state& state) {
-	
+	state.path_cache.invalidate(); // movement costs may change
+
 	concurrency::parallel_for(uint32_t(0), sys::provincial_mod_offsets::count, [&](uint32_t i) {
 		dcon::provincial_modifier_value mid{dcon::provincial_modifier_value::value_base_t(i)};
 		province::ve_for_each_land_province(state,
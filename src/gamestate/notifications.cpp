@@ -1,6 +1,8 @@
 #include "notifications.hpp"
 #include "system_state.hpp"
 
+#include <algorithm>
+
 namespace notification {
 
 void post(sys::state& state, message&& m) {
@@ -18,4 +20,49 @@ bool nation_is_interesting(sys::state& state, dcon::nation_id n) {
 	return state.world.nation_get_is_interesting(n);
 }
 
+namespace {
+std::atomic<uint32_t> next_staging_buffer_id{ 1 };
+}
+
+staging_buffer::staging_buffer() : id(next_staging_buffer_id.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+staging_buffer::thread_buffer& staging_buffer::local_buffer() {
+	thread_local std::vector<std::pair<uint32_t, thread_buffer*>> known;
+	for(auto& k : known) {
+		if(k.first == id)
+			return *k.second;
+	}
+	std::lock_guard guard{ registration_lock };
+	auto& b = threads.emplace_back(std::make_unique<thread_buffer>());
+	known.emplace_back(id, b.get());
+	return *b;
+}
+
+void staging_buffer::stage(uint32_t index, message&& m) {
+	local_buffer().entries.push_back(entry{ index, std::move(m) });
+}
+
+bool staging_buffer::empty() const {
+	for(auto& t : threads) {
+		if(!t->entries.empty())
+			return false;
+	}
+	return true;
+}
+
+void staging_buffer::flush(sys::state& state) {
+	// an index is staged by a single iteration, so all of its messages come from one thread buffer, already in order
+	merged.clear();
+	for(auto& t : threads) {
+		for(auto& e : t->entries)
+			merged.push_back(std::move(e));
+		t->entries.clear();
+	}
+	std::stable_sort(merged.begin(), merged.end(), [](entry const& a, entry const& b) { return a.index < b.index; });
+	for(auto& e : merged)
+		post(state, std::move(e.m));
+	merged.clear();
+}
+
 } // namespace notification
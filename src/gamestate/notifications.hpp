@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "container_types.hpp"
 #include "text.hpp"
 
@@ -17,7 +21,42 @@ struct message {
 	// if province_source is defined, it will go to said province instead
 };
 
+// messages reach the ui through a single producer queue: post must only be called from serial code
 void post(sys::state& state, message&& m);
 bool nation_is_interesting(sys::state& state, dcon::nation_id n);
 
+// messages produced inside a concurrency::parallel_for
+// each iteration stages its messages under its own index instead of posting them; every thread appends to a buffer of its own,
+// so staging takes no lock once a thread has used the buffer. The serial code after the parallel section calls flush, which posts
+// the messages by increasing index and, for the same index, in the order they were staged: the same order as a serial loop which
+// posted as it went, whatever the scheduling of the threads.
+// the other side effects of a parallel section follow the same rule: an iteration writes only to the rows of the objects it was
+// given, and anything shared is staged and applied by the serial code after it.
+class staging_buffer {
+public:
+	staging_buffer();
+	staging_buffer(staging_buffer const&) = delete;
+	staging_buffer& operator=(staging_buffer const&) = delete;
+
+	void stage(uint32_t index, message&& m);
+	void flush(sys::state& state); // serial code only
+	bool empty() const;
+
+private:
+	struct entry {
+		uint32_t index = 0;
+		message m;
+	};
+	struct thread_buffer {
+		std::vector<entry> entries;
+	};
+
+	thread_buffer& local_buffer();
+
+	uint32_t id = 0; // identifies the buffer to the threads which have registered with it; never reused
+	std::mutex registration_lock;
+	std::vector<std::unique_ptr<thread_buffer>> threads;
+	std::vector<entry> merged;
+};
+
 } // namespace notification
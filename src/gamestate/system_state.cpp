@@ -305,203 +305,204 @@ int state::get_edit_y(){
 }
 
 
-cache_response commodity_per_nation_cache_slot::update(sys::state& state) {
-	if(progress >= state.world.nation_size()) return cache_response::ready;
-	if(!commodity) return cache_response::ready;
-
-	int64_t counter_start_before = state.tick_start_counter.load();
-	int64_t counter_end_before = state.tick_end_counter.load();
-
-	if(counter_start_before != counter_end_before) {
-		// check that we are not in the update
-		// otherwise redo the work later
-		progress = 0;
-		return cache_response::busy;
+void ui_cache_worker_pool::start(uint32_t worker_count) {
+	for(uint32_t i = 0; i < worker_count; i++) {
+		threads.emplace_back([this]() { worker_loop(); });
 	}
+}
 
-	dcon::nation_id current_nation{ progress };
-
-	// ACTUAL CALCULATIONS BEGIN
-
-	auto export_temp = economy::export_volume(state, current_nation, commodity);
-	auto import_temp = economy::import_volume(state, current_nation, commodity);
-	auto consumption_temp = economy::consumption(state, current_nation, commodity);
-	auto production_temp = std::max(0.f, economy::supply(state, current_nation, commodity) - economy::trade_supply(state, current_nation, commodity));
-
-	// ACTUAL CALCULATIONS END
-
-	int64_t counter_start_after = state.tick_start_counter.load();
-	if(counter_start_after != counter_start_before) {
-		// check that new update haven't started yet
-		// otherwise redo the work later
-		progress = 0;
-		return cache_response::busy;
+void ui_cache_worker_pool::stop() {
+	{
+		std::unique_lock lock(job_mutex);
+		quit = true;
 	}
-
-	// SAFE PLACE TO STORE RESULTS
-
-	export_volume.set(progress, export_temp);
-	import_volume.set(progress, import_temp);
-	production_volume.set(progress, production_temp);
-	consumption_volume.set(progress, consumption_temp);
-
-	progress++;
-	return cache_response::in_progress;
+	job_cv.notify_all();
+	for(auto& t : threads) {
+		t.join();
+	}
+	threads.clear();
 }
 
-cache_response nation_per_nation_cache_slot::update(sys::state& state) {
-	if(!nation) return cache_response::ready;
-
-	int64_t counter_start_before = state.tick_start_counter.load();
-	int64_t counter_end_before = state.tick_end_counter.load();
-	if(counter_start_before != counter_end_before) {
-		return cache_response::busy;
+void ui_cache_worker_pool::drain(std::function<void(uint32_t)> const& f) {
+	for(auto chunk = next_chunk.fetch_add(1); chunk < chunk_count; chunk = next_chunk.fetch_add(1)) {
+		f(chunk);
 	}
+}
 
-	// ACTUAL CALCULATIONS BEGIN
-
-	auto import_temp = economy::trade_value_flow_all_to_nation(state, nation);
-	auto export_temp = economy::trade_value_flow_nation_to_all(state, nation);
-
-	// ACTUAL CALCULATIONS END
-
-
-	int64_t counter_start_after = state.tick_start_counter.load();
-	if(counter_start_after != counter_start_before) {
-		return cache_response::busy;
+void ui_cache_worker_pool::worker_loop() {
+	uint32_t seen_generation = 0;
+	while(true) {
+		std::function<void(uint32_t)> const* current_job = nullptr;
+		{
+			std::unique_lock lock(job_mutex);
+			job_cv.wait(lock, [&]() { return quit || job_generation != seen_generation; });
+			if(quit)
+				return;
+			seen_generation = job_generation;
+			current_job = job;
+			if(!current_job)
+				continue;
+			workers_busy++;
+		}
+		drain(*current_job);
+		{
+			std::unique_lock lock(job_mutex);
+			workers_busy--;
+		}
+		done_cv.notify_all();
 	}
-
-	// SAFE PLACE TO STORE RESULTS
-
-	export_value.assign_data(export_temp);
-	import_value.assign_data(import_temp);
-
-	return cache_response::ready;
 }
 
-cache_response nation_per_commodity_cache_slot::update(sys::state& state) {
-	if(progress >= state.world.commodity_size()) return cache_response::ready;
-	if(!nation) return cache_response::ready;
-
-	int64_t counter_start_before = state.tick_start_counter.load();
-	int64_t counter_end_before = state.tick_end_counter.load();
-
-	if(counter_start_before != counter_end_before) {
-		progress = 0;
-		return cache_response::busy;
+void ui_cache_worker_pool::run(uint32_t count, std::function<void(uint32_t)> const& f) {
+	{
+		std::unique_lock lock(job_mutex);
+		job = &f;
+		chunk_count = count;
+		next_chunk.store(0);
+		job_generation++;
+	}
+	job_cv.notify_all();
+	drain(f);
+	{
+		std::unique_lock lock(job_mutex);
+		done_cv.wait(lock, [&]() { return workers_busy == 0; });
+		job = nullptr;
 	}
+}
 
-	dcon::commodity_id current_item{ progress };
-
-	// ACTUAL CALCULATIONS BEGIN
-
-	auto export_temp = economy::export_volume(state, nation, current_item);
-	auto import_temp = economy::import_volume(state, nation, current_item);
+uint32_t commodity_per_nation_cache_slot::item_count(sys::state& state) {
+	if(!commodity) return 0;
+	return state.world.nation_size();
+}
 
-	// ACTUAL CALCULATIONS END
+void commodity_per_nation_cache_slot::begin_pass(sys::state& state) {
+	export_volume.back_data.resize(chunks.items);
+	import_volume.back_data.resize(chunks.items);
+	consumption_volume.back_data.resize(chunks.items);
+	production_volume.back_data.resize(chunks.items);
+}
 
-	int64_t counter_start_after = state.tick_start_counter.load();
-	if(counter_start_after != counter_start_before) {
-		progress = 0;
-		return cache_response::busy;
+void commodity_per_nation_cache_slot::compute_chunk(sys::state& state, uint32_t first, uint32_t last) {
+	for(uint32_t i = first; i < last; i++) {
+		dcon::nation_id current_nation{ dcon::nation_id::value_base_t(i) };
+		export_volume.back_data[i] = economy::export_volume(state, current_nation, commodity);
+		import_volume.back_data[i] = economy::import_volume(state, current_nation, commodity);
+		consumption_volume.back_data[i] = economy::consumption(state, current_nation, commodity);
+		production_volume.back_data[i] = std::max(0.f, economy::supply(state, current_nation, commodity) - economy::trade_supply(state, current_nation, commodity));
 	}
+}
 
-	// SAFE PLACE TO STORE RESULTS
+void commodity_per_nation_cache_slot::finalize(sys::state& state) {
+	export_volume.publish();
+	import_volume.publish();
+	consumption_volume.publish();
+	production_volume.publish();
+}
+
+uint32_t nation_per_nation_cache_slot::item_count(sys::state& state) {
+	if(!nation) return 0;
+	return 1;
+}
 
-	export_volume.set(progress, export_temp);
-	import_volume.set(progress, import_temp);
+void nation_per_nation_cache_slot::begin_pass(sys::state& state) {
 
-	progress++;
-	return cache_response::in_progress;
 }
 
-cache_response per_province_cache_slot::update(sys::state& state) {
-	// we can't create provinces thankfully
-	if(progress >= state.world.province_size()) {
-		// update sorting
-		std::sort(sorted_by_gdp_per_capita.unsafe_data.begin(), sorted_by_gdp_per_capita.unsafe_data.end(), [&](auto a, auto b) {
-			if(gdp.unsafe_data[a.index()].total_non_negative / (population.unsafe_data[a.index()] + 1) == gdp.unsafe_data[b.index()].total_non_negative / (population.unsafe_data[b.index()] + 1)) {
-				return a.index() > b.index();
-			} else {
-				return gdp.unsafe_data[a.index()].total_non_negative / (population.unsafe_data[a.index()] + 1) > gdp.unsafe_data[b.index()].total_non_negative / (population.unsafe_data[b.index()] + 1);
-			}
-		});
+void nation_per_nation_cache_slot::compute_chunk(sys::state& state, uint32_t first, uint32_t last) {
+	import_value.back_data = economy::trade_value_flow_all_to_nation(state, nation);
+	export_value.back_data = economy::trade_value_flow_nation_to_all(state, nation);
+}
 
-		std::sort(sorted_by_gdp.unsafe_data.begin(), sorted_by_gdp.unsafe_data.end(), [&](auto a, auto b) {
-			if(gdp.unsafe_data[a.index()].total_non_negative == gdp.unsafe_data[b.index()].total_non_negative) {
-				return a.index() > b.index();
-			} else {
-				return gdp.unsafe_data[a.index()].total_non_negative > gdp.unsafe_data[b.index()].total_non_negative;
-			}
-		});
-		return cache_response::ready;
-	}
+void nation_per_nation_cache_slot::finalize(sys::state& state) {
+	export_value.publish();
+	import_value.publish();
+}
 
-	// validate size
-	if(sorted_by_gdp.unsafe_data.size() < state.world.province_size()) {
-		sorted_by_gdp.clear();
-		sorted_by_gdp_per_capita.clear();
-		state.world.for_each_province([&](auto pid) {
-			sorted_by_gdp.push_back(pid);
-		});
-		state.world.for_each_province([&](auto pid) {
-			sorted_by_gdp_per_capita.push_back(pid);
-		});
-	}
+uint32_t nation_per_commodity_cache_slot::item_count(sys::state& state) {
+	if(!nation) return 0;
+	return state.world.commodity_size();
+}
 
-	int64_t counter_start_before = state.tick_start_counter.load();
-	int64_t counter_end_before = state.tick_end_counter.load();
+void nation_per_commodity_cache_slot::begin_pass(sys::state& state) {
+	export_volume.back_data.resize(chunks.items);
+	import_volume.back_data.resize(chunks.items);
+}
 
-	if(counter_start_before != counter_end_before) {
-		// check that we are not in the update
-		// otherwise redo the work later
-		progress = 0;
-		return cache_response::busy;
+void nation_per_commodity_cache_slot::compute_chunk(sys::state& state, uint32_t first, uint32_t last) {
+	for(uint32_t i = first; i < last; i++) {
+		dcon::commodity_id current_item{ dcon::commodity_id::value_base_t(i) };
+		export_volume.back_data[i] = economy::export_volume(state, nation, current_item);
+		import_volume.back_data[i] = economy::import_volume(state, nation, current_item);
 	}
+}
 
-	dcon::province_id current_item{ progress };
-
-	// ACTUAL CALCULATIONS BEGIN
+void nation_per_commodity_cache_slot::finalize(sys::state& state) {
+	export_volume.publish();
+	import_volume.publish();
+}
 
-	auto gdp_value = economy::gdp::breakdown_province(state, current_item);
-	auto population_value = state.world.province_get_demographics(current_item, demographics::total);
+uint32_t per_province_cache_slot::item_count(sys::state& state) {
+	// we can't create provinces thankfully
+	return state.world.province_size();
+}
 
-	// ACTUAL CALCULATIONS END
+void per_province_cache_slot::begin_pass(sys::state& state) {
+	gdp.back_data.resize(chunks.items);
+	population.back_data.resize(chunks.items);
+	sorted_by_gdp.back_data.clear();
+	sorted_by_gdp_per_capita.back_data.clear();
+	state.world.for_each_province([&](auto pid) {
+		sorted_by_gdp.back_data.push_back(pid);
+		sorted_by_gdp_per_capita.back_data.push_back(pid);
+	});
+}
 
-	int64_t counter_start_after = state.tick_start_counter.load();
-	if(counter_start_after != counter_start_before) {
-		// check that new update haven't started yet
-		// otherwise redo the work later
-		progress = 0;
-		return cache_response::busy;
+void per_province_cache_slot::compute_chunk(sys::state& state, uint32_t first, uint32_t last) {
+	for(uint32_t i = first; i < last; i++) {
+		dcon::province_id current_item{ dcon::province_id::value_base_t(i) };
+		gdp.back_data[i] = economy::gdp::breakdown_province(state, current_item);
+		population.back_data[i] = state.world.province_get_demographics(current_item, demographics::total);
 	}
-
-	// SAFE PLACE TO STORE RESULTS
-
-	gdp.set(progress, gdp_value);
-	population.set(progress, population_value);
-
-	progress++;
-	return cache_response::in_progress;
 }
 
-cache_response per_nation_cache_slot::update(sys::state& state) {
-	if(progress >= state.world.nation_size() && progress_sphere >= state.world.nation_size()) return cache_response::ready;
+void per_province_cache_slot::finalize(sys::state& state) {
+	auto& gdp_data = gdp.back_data;
+	auto& population_data = population.back_data;
 
-	int64_t counter_start_before = state.tick_start_counter.load();
-	int64_t counter_end_before = state.tick_end_counter.load();
+	std::sort(sorted_by_gdp_per_capita.back_data.begin(), sorted_by_gdp_per_capita.back_data.end(), [&](auto a, auto b) {
+		if(gdp_data[a.index()].total_non_negative / (population_data[a.index()] + 1) == gdp_data[b.index()].total_non_negative / (population_data[b.index()] + 1)) {
+			return a.index() > b.index();
+		} else {
+			return gdp_data[a.index()].total_non_negative / (population_data[a.index()] + 1) > gdp_data[b.index()].total_non_negative / (population_data[b.index()] + 1);
+		}
+	});
 
-	if(counter_start_before != counter_end_before) {
-		reset_progress();
-		return cache_response::busy;
-	}
+	std::sort(sorted_by_gdp.back_data.begin(), sorted_by_gdp.back_data.end(), [&](auto a, auto b) {
+		if(gdp_data[a.index()].total_non_negative == gdp_data[b.index()].total_non_negative) {
+			return a.index() > b.index();
+		} else {
+			return gdp_data[a.index()].total_non_negative > gdp_data[b.index()].total_non_negative;
+		}
+	});
 
-	if(progress < state.world.nation_size()) {
+	gdp.publish();
+	population.publish();
+	sorted_by_gdp.publish();
+	sorted_by_gdp_per_capita.publish();
+}
 
-		dcon::nation_id current_item{ progress };
+uint32_t per_nation_cache_slot::item_count(sys::state& state) {
+	return state.world.nation_size();
+}
 
-		// ACTUAL CALCULATIONS BEGIN
+void per_nation_cache_slot::begin_pass(sys::state& state) {
+	national_gdp.back_data.resize(chunks.items);
+	sphere_parent.back_data.resize(chunks.items);
+}
 
+void per_nation_cache_slot::compute_chunk(sys::state& state, uint32_t first, uint32_t last) {
+	for(uint32_t i = first; i < last; i++) {
+		dcon::nation_id current_item{ dcon::nation_id::value_base_t(i) };
 
 		auto gdp = std::max(0.f, economy::gdp::value_nation(state, current_item));
 
@@ -517,155 +518,163 @@ cache_response per_nation_cache_slot::update(sys::state& state) {
 			}
 		}
 
-		auto parent_of_current = current_item;
-		if(sphere) {
-			parent_of_current = sphere;
-		} else {
-			parent_of_current = temp;
-		}
-
-		// ACTUAL CALCULATIONS END
+		national_gdp.back_data[i] = gdp;
+		sphere_parent.back_data[i] = sphere ? sphere : temp;
+	}
+}
 
-		int64_t counter_start_after = state.tick_start_counter.load();
-		if(counter_start_after != counter_start_before) {
-			reset_progress();
-			return cache_response::busy;
+void per_nation_cache_slot::finalize(sys::state& state) {
+	// sphere totals need every parent, so they are summed once the whole pass is done
+	sphere_gdp.back_data.assign(chunks.items, 0.f);
+	for(uint32_t i = 0; i < chunks.items; i++) {
+		auto parent = sphere_parent.back_data[i];
+		if(parent && uint32_t(parent.index()) < chunks.items) {
+			sphere_gdp.back_data[parent.index()] += national_gdp.back_data[i];
 		}
+	}
 
-		// SAFE PLACE TO STORE RESULTS
-
-		national_gdp.set(progress, gdp);
-		sphere_parent.set(progress, parent_of_current);
+	national_gdp.publish();
+	sphere_parent.publish();
+	sphere_gdp.publish();
+}
 
-		progress++;
-		return cache_response::in_progress;
-	} else {
-		dcon::nation_id current_item{ progress_sphere };
+uint32_t commodity_per_province_cache_slot::item_count(sys::state& state) {
+	if(!commodity) return 0;
+	return state.world.province_size();
+}
 
-		// ACTUAL CALCULATIONS BEGIN
+void commodity_per_province_cache_slot::begin_pass(sys::state& state) {
+	consumption_volume.back_data.resize(chunks.items);
+	production_volume.back_data.resize(chunks.items);
+	sorted_by_production.back_data.clear();
+	sorted_by_consumption.back_data.clear();
+	state.world.for_each_province([&](auto pid) {
+		sorted_by_production.back_data.push_back(pid);
+		sorted_by_consumption.back_data.push_back(pid);
+	});
+}
 
-		auto total = 0.f;
-		state.world.for_each_nation([&](auto nid) {
-			if(sphere_parent.unsafe_data[nid.index()] == current_item) {
-				auto value = national_gdp.unsafe_data[nid.index()];
-				total += value;
-			}
-		});
+void commodity_per_province_cache_slot::compute_chunk(sys::state& state, uint32_t first, uint32_t last) {
+	for(uint32_t i = first; i < last; i++) {
+		dcon::province_id current_item{ dcon::province_id::value_base_t(i) };
+		consumption_volume.back_data[i] = economy::estimate_intermediate_consumption(state, commodity, current_item) + economy::estimate_pops_consumption(state, commodity, current_item);
+		production_volume.back_data[i] = economy::estimate_production(state, commodity, current_item);
+	}
+}
 
-		// ACTUAL CALCULATIONS END
+void commodity_per_province_cache_slot::finalize(sys::state& state) {
+	auto& production_data = production_volume.back_data;
+	auto& consumption_data = consumption_volume.back_data;
 
-		int64_t counter_start_after = state.tick_start_counter.load();
-		if(counter_start_after != counter_start_before) {
-			reset_progress();
-			return cache_response::busy;
+	std::sort(sorted_by_production.back_data.begin(), sorted_by_production.back_data.end(), [&](auto a, auto b) {
+		if(production_data[a.index()] == production_data[b.index()]) {
+			return a.index() > b.index();
+		} else {
+			return production_data[a.index()] > production_data[b.index()];
 		}
+	});
 
-		// SAFE PLACE TO STORE RESULTS
-
-		sphere_gdp.set(progress_sphere, total);
+	std::sort(sorted_by_consumption.back_data.begin(), sorted_by_consumption.back_data.end(), [&](auto a, auto b) {
+		if(consumption_data[a.index()] == consumption_data[b.index()]) {
+			return a.index() > b.index();
+		} else {
+			return consumption_data[a.index()] > consumption_data[b.index()];
+		}
+	});
 
-		progress_sphere++;
-		return cache_response::in_progress;
-	}
+	consumption_volume.publish();
+	production_volume.publish();
+	sorted_by_production.publish();
+	sorted_by_consumption.publish();
 }
 
-cache_response commodity_per_province_cache_slot::update(sys::state& state) {
-	if(progress >= state.world.province_size()) {
-		// update sorting
-		std::sort(sorted_by_production.unsafe_data.begin(), sorted_by_production.unsafe_data.end(), [&](auto a, auto b) {
-			if(production_volume.unsafe_data[a.index()] == production_volume.unsafe_data[b.index()]) {
-				return a.index() > b.index();
-			} else {
-				return production_volume.unsafe_data[a.index()] > production_volume.unsafe_data[b.index()];
-			}
-		});
-
-		std::sort(sorted_by_consumption.unsafe_data.begin(), sorted_by_consumption.unsafe_data.end(), [&](auto a, auto b) {
-			if(consumption_volume.unsafe_data[a.index()] == consumption_volume.unsafe_data[b.index()]) {
-				return a.index() > b.index();
-			} else {
-				return consumption_volume.unsafe_data[a.index()] > consumption_volume.unsafe_data[b.index()];
-			}
-		});
-		return cache_response::ready;
-	}
-	// validate size
-	if(sorted_by_production.unsafe_data.size() < state.world.province_size()) {
-		sorted_by_production.clear();
-		sorted_by_consumption.clear();
-		state.world.for_each_province([&](auto pid) {
-			sorted_by_production.push_back(pid);
-		});
-		state.world.for_each_province([&](auto pid) {
-			sorted_by_consumption.push_back(pid);
-		});
-	}
-
-	int64_t counter_start_before = state.tick_start_counter.load();
-	int64_t counter_end_before = state.tick_end_counter.load();
-
-	if(counter_start_before != counter_end_before) {
-		// check that we are not in the update
-		// otherwise redo the work later
-		progress = 0;
-		return cache_response::busy;
-	}
+void ui_cache::update_ui(sys::state& state) {
+	state.game_state_updated.store(true, std::memory_order_release);
+}
 
-	dcon::province_id current_item{ progress };
+template<typename SLOT>
+cache_response ui_cache::run_chunks(sys::state& state, SLOT& slot) {
+	std::atomic<bool> interrupted = false;
+	std::function<void(uint32_t)> job = [&](uint32_t chunk) {
+		if(slot.chunks.done[chunk] || interrupted.load(std::memory_order::relaxed))
+			return;
 
-	// ACTUAL CALCULATIONS BEGIN
+		int64_t counter_start_before = state.tick_start_counter.load();
+		int64_t counter_end_before = state.tick_end_counter.load();
+		if(counter_start_before != counter_end_before) {
+			// check that we are not in the update
+			// otherwise redo the work later
+			interrupted.store(true, std::memory_order::relaxed);
+			return;
+		}
 
-	auto consumption_value = economy::estimate_intermediate_consumption(state, commodity, current_item) + economy::estimate_pops_consumption(state, commodity, current_item);
-	auto production_value = economy::estimate_production(state, commodity, current_item);
+		slot.compute_chunk(state, slot.chunks.first_item(chunk), slot.chunks.last_item(chunk));
 
-	// ACTUAL CALCULATIONS END
+		int64_t counter_start_after = state.tick_start_counter.load();
+		if(counter_start_after != counter_start_before) {
+			// check that new update haven't started yet
+			// otherwise this chunk is redone later, chunks completed before the tick are kept
+			interrupted.store(true, std::memory_order::relaxed);
+			return;
+		}
+		slot.chunks.done[chunk] = 1;
+	};
+	workers.run(slot.chunks.count(), job);
 
-	int64_t counter_start_after = state.tick_start_counter.load();
-	if(counter_start_after != counter_start_before) {
-		// check that new update haven't started yet
-		// otherwise redo the work later
-		progress = 0;
+	if(!slot.chunks.finished())
 		return cache_response::busy;
-	}
 
 	// SAFE PLACE TO STORE RESULTS
-
-	production_volume.set(progress, production_value);
-	consumption_volume.set(progress, consumption_value);
-
-	progress++;
-	return cache_response::in_progress;
-}
-
-void ui_cache::update_ui(sys::state& state) {
-	state.game_state_updated.store(true, std::memory_order_release);
+	slot.finalize(state);
+	return cache_response::ready;
 }
 
 template<typename SLOT>
 void ui_cache::update_slot(sys::state& state, SLOT& slot, bool& updates_running) {
-	auto requested_update = slot.update_requested.exchange(false);
-	if(requested_update) {
-		slot.reset_progress();
-		updates_running = true;
+	if(slot.reset_requested.exchange(false)) {
+		// drop the current pass: it was computed for old parameters
+		slot.update_completed = true;
+		slot.update_requested.store(true);
+	}
+	if(slot.update_completed) {
+		// requests which arrive during a pass are served by the next pass
+		// so a pass is never restarted from zero by a new tick
+		if(!slot.update_requested.exchange(false))
+			return;
+		slot.update_completed = false;
+		slot.chunks.reset(0);
 	}
-	if(!slot.update_completed) {
-		std::shared_lock lock(state.game_state_resetting_lock);
-		state.game_state_resetting_cv.wait(lock, [&] { return !state.yield_game_state_resetting_lock; });
-		updates_running = true;
-		auto res = slot.update(state);
-		if(res == cache_response::ready) {
-			slot.update_completed = true;
-			update_ui(state);
-			delay = std::max(0.1f, delay * 0.95f);
-		} else if (res == cache_response::busy) {
-			delay = std::min(100.f, delay * 1.05f);
-		} else if(res == cache_response::in_progress) {
-			delay = std::max(0.1f, delay * 0.95f);
-		}
+
+	std::shared_lock lock(state.game_state_resetting_lock);
+	state.game_state_resetting_cv.wait(lock, [&] { return !state.yield_game_state_resetting_lock; });
+	updates_running = true;
+
+	auto items = slot.item_count(state);
+	if(items == 0) {
+		slot.update_completed = true;
+		return;
+	}
+	if(items != slot.chunks.items) {
+		slot.chunks.reset(items);
+		slot.begin_pass(state);
+	}
+
+	auto res = run_chunks(state, slot);
+	if(res == cache_response::ready) {
+		slot.update_completed = true;
+		update_ui(state);
+		delay = std::max(0.1f, delay * 0.95f);
+	} else if (res == cache_response::busy) {
+		delay = std::min(100.f, delay * 1.05f);
+	} else if(res == cache_response::in_progress) {
+		delay = std::max(0.1f, delay * 0.95f);
 	}
 }
 
 void ui_cache::process_update(sys::state& state) {
+	// the cache thread itself works on chunks as well, so workers are only added on machines with cores to spare
+	workers.start(std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u) - 1);
+
 	while(state.quit_signaled.load(std::memory_order::acquire) == false) {
 		bool updates_running = false;
 		update_slot(state, commodity_per_nation, updates_running);
@@ -686,6 +695,8 @@ void ui_cache::process_update(sys::state& state) {
 			std::this_thread::sleep_for(std::chrono::milliseconds((int)delay));
 		}
 	}
+
+	workers.stop();
 };
 
 GLuint request_query(std::vector<GLuint>& ids, std::vector<bool>& free_ids) {
@@ -715,6 +726,9 @@ void state::render() { // called to render the frame may (and should) delay retu
 
 
 	auto game_state_was_updated = game_state_updated.exchange(false, std::memory_order::acq_rel);
+	if(game_state_was_updated) {
+		economy_explanations.clear();
+	}
 	if(game_state_was_updated && !current_scene.starting_scene && !ui_state.lazy_load_in_game) {
 		window::change_cursor(*this, window::cursor_type::busy);
 		ui::create_in_game_windows(*this);
@@ -3543,9 +3557,17 @@ void state::clear_unsaved_data() {
 
 	// Set flags to update stuff as we are about to flush most of the cached data
 	adjacency_data_out_of_date = true;
+	province_definitions.connected_regions_need_rebuild = true;
+	province_definitions.cached_values_need_rebuild = true;
+	military_definitions.war_relations_out_of_date = true;
+	military_definitions.war_score_province_points.clear();
+	military_definitions.war_score_province_flags.clear();
+	military_definitions.gc_full_sweep = true;
+	national_definitions.gc_full_sweep = true;
 	national_cached_values_out_of_date = true;
 	diplomatic_cached_values_out_of_date = true;
 	trade_route_cached_values_out_of_date = true;
+	path_cache.invalidate();
 
 	auto reload_protected_record = world.make_serialize_record_store_reload_protected_state();
 	auto save_record = world.make_serialize_record_store_save();
@@ -3586,6 +3608,16 @@ void state::flush_pending_log_messages() {
 void state::preload() {
 
 	adjacency_data_out_of_date = true;
+	province_definitions.connected_regions_need_rebuild = true;
+	province_definitions.cached_values_need_rebuild = true;
+	military_definitions.war_relations_out_of_date = true;
+	military_definitions.war_score_province_points.clear();
+	military_definitions.war_score_province_flags.clear();
+	military_definitions.gc_full_sweep = true;
+	national_definitions.gc_full_sweep = true;
+	path_cache.reset();
+	region_hierarchy.reset();
+	sea_trade_paths.reset();
 	for(auto si : world.in_state_instance) {
 		si.set_naval_base_is_taken(false);
 		//si.set_capital(dcon::province_id{});
@@ -4020,7 +4052,10 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	culture::repopulate_invention_effects(*this);
 	military::apply_base_unit_stat_modifiers(*this);
 
+	province::rebuild_adjacency_graph(*this);
+	province::rebuild_distance_oracle(*this);
 	province::update_connected_regions(*this);
+	province::update_region_hierarchy(*this);
 	province::restore_unsaved_values(*this);
 
 	culture::update_all_nations_issue_rules(*this);
@@ -4118,6 +4153,10 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 
 	province::update_cached_values(*this);
 	nations::update_cached_values(*this);
+	military::update_war_relations(*this);
+	military::update_supply_fields(*this);
+	military::mark_all_war_scores_stale(*this, military::war_score_part::all);
+	military::update_war_scores(*this);
 
 	ai::identify_focuses(*this);
 	ai::initialize_ai_tech_weights(*this);
@@ -4181,6 +4220,7 @@ void state::single_game_tick() {
 
 	current_date += 1;
 	tick_start_counter.fetch_add(1, std::memory_order::seq_cst);
+	tick_arena.begin_tick();
 
 	if(!is_playable_date(current_date, start_date, end_date)) {
 		game_scene::switch_scene(*this, game_scene::scene_id::end_screen);
@@ -4436,12 +4476,17 @@ void state::single_game_tick() {
 			}
 		});
 
+		// the ticking war score of every war goal moved above
+		military::mark_all_war_scores_stale(*this, military::war_score_part::war_goals);
+		military::update_war_scores(*this);
+
 		economy::daily_update(*this, false, 1.f);
 
 		//
 		// ALTERNATE PAR DEMO START POINT B
 		//
 
+		military::update_war_relations(*this);
 		military::recover_org(*this);
 		military::update_siege_progress(*this);
 		military::update_movement(*this);
@@ -4684,8 +4729,12 @@ void state::single_game_tick() {
 		ai::daily_cleanup(*this);
 
 		province::update_connected_regions(*this);
+		province::update_region_hierarchy(*this);
 		province::update_cached_values(*this);
 		nations::update_cached_values(*this);
+		military::update_war_relations(*this);
+		military::update_supply_fields(*this);
+		military::update_war_scores(*this);
 
 	},
 	[&]() {
@@ -8,11 +8,14 @@
 #include <shared_mutex>
 
 #include <condition_variable>
+#include <thread>
+#include <functional>
 
 #include "window.hpp"
 #include "sound.hpp"
 #include "dcon_generated.hpp"
 #include "containers_state.hpp"
+#include "tick_arena.hpp"
 #include "constants_state.hpp"
 #include "constants_dcon.hpp"
 #include "constants.hpp"
@@ -496,6 +499,8 @@ template<typename T>
 struct ui_cached_vector {
 	std::mutex resize_mutex;
 	std::vector<T> unsafe_data;
+	// written only by the cache workers, becomes visible to readers on publish()
+	std::vector<T> back_data;
 
 	template<typename VAL>
 	void assign_data(VAL value) {
@@ -531,6 +536,12 @@ struct ui_cached_vector {
 		resize_mutex.unlock();
 	}
 
+	void publish() {
+		resize_mutex.lock();
+		std::swap(unsafe_data, back_data);
+		resize_mutex.unlock();
+	}
+
 	std::optional<size_t> size() {
 		if(resize_mutex.try_lock()) {
 			auto val = unsafe_data.size();
@@ -561,39 +572,87 @@ enum class cache_response {
 	busy, in_progress, ready
 };
 
+inline constexpr uint32_t ui_cache_chunk_size = 32;
+
+// progress of a single pass of a cache slot
+// chunks are marked as done by the workers and survive ticks, so a pass interrupted by a tick continues where it stopped
+struct ui_cache_chunks {
+	std::vector<uint8_t> done;
+	uint32_t items = 0;
+
+	void reset(uint32_t item_count) {
+		items = item_count;
+		done.assign((item_count + ui_cache_chunk_size - 1) / ui_cache_chunk_size, uint8_t(0));
+	}
+	uint32_t count() const {
+		return uint32_t(done.size());
+	}
+	uint32_t first_item(uint32_t chunk) const {
+		return chunk * ui_cache_chunk_size;
+	}
+	uint32_t last_item(uint32_t chunk) const {
+		return std::min(items, (chunk + 1) * ui_cache_chunk_size);
+	}
+	bool finished() const {
+		return std::find(done.begin(), done.end(), uint8_t(0)) == done.end();
+	}
+};
+
+struct ui_cache_worker_pool {
+	std::vector<std::thread> threads;
+	std::mutex job_mutex;
+	std::condition_variable job_cv;
+	std::condition_variable done_cv;
+	std::function<void(uint32_t)> const* job = nullptr;
+	std::atomic<uint32_t> next_chunk = 0;
+	uint32_t chunk_count = 0;
+	uint32_t job_generation = 0;
+	uint32_t workers_busy = 0;
+	bool quit = false;
+
+	void start(uint32_t worker_count);
+	void stop();
+	// calls f for every chunk in [0, count) on the workers and on the calling thread, returns once all calls are done
+	void run(uint32_t count, std::function<void(uint32_t)> const& f);
+private:
+	void drain(std::function<void(uint32_t)> const& f);
+	void worker_loop();
+};
+
 struct ui_cache_slot {
 	std::atomic<bool> update_requested = false;
-	std::mutex update_mutex;
+	std::atomic<bool> reset_requested = false;
 	bool update_completed = true;
-	void reset_progress() {
-		return;
-	}
-	cache_response update(sys::state& state) {
-		return cache_response::ready;
-	}
+	ui_cache_chunks chunks;
+
 	// can be used outside of cache thread
 	void request_update() {
 		update_requested.store(true);
 	}
-
-	template<typename F>
-	void access(F&){ }
+	// parameters of the slot were changed: results of the current pass are no longer valid
+	void request_reset() {
+		reset_requested.store(true);
+	}
 };
 
+// every slot provides:
+// item_count - size of the pass, zero if there is nothing to compute
+// begin_pass - prepares back buffers
+// compute_chunk - fills back buffers for items in [first, last), called concurrently for different chunks
+// finalize - post processing of the complete back buffers and their publication
+
 struct commodity_per_nation_cache_slot : ui_cache_slot {
 	dcon::commodity_id commodity{};
-	dcon::nation_id::value_base_t progress = 0;
 
 	ui_cached_vector<float> export_volume{};
 	ui_cached_vector<float> import_volume{};
 	ui_cached_vector<float> consumption_volume{};
 	ui_cached_vector<float> production_volume{};
 
-	void reset_progress() {
-		update_completed = false;
-		progress = 0;
-	}
-	cache_response update(sys::state& state);
+	uint32_t item_count(sys::state& state);
+	void begin_pass(sys::state& state);
+	void compute_chunk(sys::state& state, uint32_t first, uint32_t last);
+	void finalize(sys::state& state);
 };
 
 struct nation_per_nation_cache_slot : ui_cache_slot {
@@ -602,71 +661,59 @@ struct nation_per_nation_cache_slot : ui_cache_slot {
 	ui_cached_vector<float> export_value{};
 	ui_cached_vector<float> import_value{};
 
-	void reset_progress() {
-		update_completed = false;
-	}
-	cache_response update(sys::state& state);
+	uint32_t item_count(sys::state& state);
+	void begin_pass(sys::state& state);
+	void compute_chunk(sys::state& state, uint32_t first, uint32_t last);
+	void finalize(sys::state& state);
 };
 
 struct nation_per_commodity_cache_slot : ui_cache_slot {
 	dcon::nation_id nation{};
-	dcon::commodity_id::value_base_t progress = 0;
 
 	ui_cached_vector<float> import_volume{};
 	ui_cached_vector<float> export_volume{};
 
-	void reset_progress() {
-		update_completed = false;
-		progress = 0;
-	}
-	cache_response update(sys::state& state);
+	uint32_t item_count(sys::state& state);
+	void begin_pass(sys::state& state);
+	void compute_chunk(sys::state& state, uint32_t first, uint32_t last);
+	void finalize(sys::state& state);
 };
 
 struct commodity_per_province_cache_slot : ui_cache_slot {
 	dcon::commodity_id commodity{};
-	dcon::province_id::value_base_t progress = 0;
 
 	ui_cached_vector<float> consumption_volume{};
 	ui_cached_vector<float> production_volume{};
 	ui_cached_vector<dcon::province_id> sorted_by_consumption{ };
 	ui_cached_vector<dcon::province_id> sorted_by_production{ };
 
-	void reset_progress() {
-		update_completed = false;
-		progress = 0;
-	}
-	cache_response update(sys::state& state);
+	uint32_t item_count(sys::state& state);
+	void begin_pass(sys::state& state);
+	void compute_chunk(sys::state& state, uint32_t first, uint32_t last);
+	void finalize(sys::state& state);
 };
 
 struct per_province_cache_slot : ui_cache_slot {
-	dcon::province_id::value_base_t progress = 0;
-
 	ui_cached_vector<economy::gdp::breakdown> gdp{};
 	ui_cached_vector<float> population{};
 	ui_cached_vector<dcon::province_id> sorted_by_gdp{ };
 	ui_cached_vector<dcon::province_id> sorted_by_gdp_per_capita{ };
 
-	void reset_progress() {
-		update_completed = false;
-		progress = 0;
-	}
-	cache_response update(sys::state& state);
+	uint32_t item_count(sys::state& state);
+	void begin_pass(sys::state& state);
+	void compute_chunk(sys::state& state, uint32_t first, uint32_t last);
+	void finalize(sys::state& state);
 };
 
 struct per_nation_cache_slot : ui_cache_slot {
-	dcon::nation_id::value_base_t progress = 0;
-	dcon::nation_id::value_base_t progress_sphere = 0;
-
 	ui_cached_vector<dcon::nation_id> sphere_parent{};
 	ui_cached_vector<float> national_gdp{};
 	ui_cached_vector<float> sphere_gdp{};
 
-	void reset_progress() {
-		update_completed = false;
-		progress = 0;
-		progress_sphere = 0;
-	}
-	cache_response update(sys::state& state);
+	uint32_t item_count(sys::state& state);
+	void begin_pass(sys::state& state);
+	void compute_chunk(sys::state& state, uint32_t first, uint32_t last);
+	void finalize(sys::state& state);
 };
 
 struct ui_cache {
@@ -684,6 +731,8 @@ struct ui_cache {
 	nation_per_commodity_cache_slot nation_per_commodity{ };
 	per_nation_cache_slot per_nation{ };
 
+	ui_cache_worker_pool workers;
+
 	float delay;
 
 	void update_ui(sys::state& state);
@@ -693,8 +742,8 @@ struct ui_cache {
 		commodity = cid;
 		commodity_per_nation.commodity = cid;
 		commodity_per_province.commodity = cid;
-		commodity_per_nation.request_update();
-		commodity_per_province.request_update();
+		commodity_per_nation.request_reset();
+		commodity_per_province.request_reset();
 	};
 
 	void set_nation(const sys::state& state, dcon::nation_id nid) {
@@ -702,8 +751,8 @@ struct ui_cache {
 		nation = nid;
 		nation_per_nation.nation = nid;
 		nation_per_commodity.nation = nid;
-		nation_per_nation.request_update();
-		nation_per_commodity.request_update();
+		nation_per_nation.request_reset();
+		nation_per_commodity.request_reset();
 	};
 
 	void request_update() {
@@ -715,6 +764,8 @@ struct ui_cache {
 		per_nation.request_update();
 	}
 
+	template<typename SLOT>
+	cache_response run_chunks(sys::state& state, SLOT& slot);
 	template<typename SLOT>
 	void update_slot(sys::state& state, SLOT& slot, bool& updates_running);
 
@@ -915,6 +966,7 @@ struct alignas(64) state {
 	std::unique_ptr<sound::sound_impl> sound_ptr = nullptr;          // platform-dependent sound information
 	ui::state ui_state;                                              // transient information for the state of the ui
 	ui_cache ui_cached_data;					 // cached data to do heavy UI updates in separate thread
+	economy::explanation_cache economy_explanations;                 // memoized economy queries for the ui, cleared on game state update
 	ogl::animation ui_animation;
 	text::font_manager font_collection;
 	asvg::file_bank svg_image_files;
@@ -934,6 +986,12 @@ struct alignas(64) state {
 
 	std::atomic<int64_t> tick_start_counter;
 	std::atomic<int64_t> tick_end_counter;
+	per_tick_arena tick_arena;                                       // scratch memory for the serial parts of a game tick, released when the next one starts
+	province::adjacency_graph adjacency_graph;                       // contiguous copy of the province adjacencies for searches and flood fills
+	province::distance_oracle distance_oracle;                       // landmark lower bounds for the naval unit searches
+	province::path_cache path_cache;                                 // game logic only: the ui keeps calling the uncached pathfinding functions
+	province::region_hierarchy region_hierarchy;                     // clusters of provinces for long distance pathfinding
+	province::sea_trade_path_cache sea_trade_paths;                  // paths between coastal markets, see nations::generate_sea_trade_routes
 
 	// synchronization: notifications from the gamestate to ui
 	rigtorp::SPSCQueue<event::pending_human_n_event> new_n_event;
@@ -942,6 +1000,7 @@ struct alignas(64) state {
 	rigtorp::SPSCQueue<event::pending_human_f_p_event> new_f_p_event;
 	rigtorp::SPSCQueue<diplomatic_message::message> new_requests;
 	rigtorp::SPSCQueue<notification::message> new_messages;
+	notification::staging_buffer staged_messages; // messages from parallel sections, flushed into new_messages after each
 	rigtorp::SPSCQueue<military::naval_battle_report> naval_battle_reports;
 	rigtorp::SPSCQueue<military::land_battle_report> land_battle_reports;
 	rigtorp::SPSCQueue<ui::error_window> error_windows;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace sys {
+
+// bump allocator for scratch memory which is needed only until the end of the current game tick
+// everything is released at once by begin_tick, so containers using it must not outlive the tick
+// the backing storage grows to the largest amount requested during a previous tick,
+// so once the game settles scratch containers stop touching the general heap
+// it is not thread safe: use it only from the serial parts of the update, such as merging the results of a parallel pass;
+// scratch space inside parallel passes stays in reused thread_local containers
+class per_tick_arena final : public std::pmr::memory_resource {
+	std::vector<std::byte> storage;
+	std::optional<std::pmr::monotonic_buffer_resource> arena;
+	size_t bytes_requested = 0;
+	size_t bytes_reserved = 0; // includes worst case alignment padding
+	size_t bytes_last_tick = 0;
+
+	void start_arena() {
+		if(storage.empty())
+			arena.emplace(std::pmr::new_delete_resource());
+		else
+			arena.emplace(storage.data(), storage.size(), std::pmr::new_delete_resource());
+	}
+
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		if(!arena)
+			start_arena();
+		bytes_requested += bytes;
+		bytes_reserved += bytes + alignment;
+		return arena->allocate(bytes, alignment);
+	}
+	void do_deallocate(void*, size_t, size_t) override {
+		// memory is reclaimed in begin_tick
+	}
+	bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+		return this == &other;
+	}
+
+public:
+	void begin_tick() {
+		bytes_last_tick = bytes_requested;
+		arena.reset();
+		if(bytes_reserved > storage.size()) {
+			storage.resize(bytes_reserved);
+		}
+		bytes_requested = 0;
+		bytes_reserved = 0;
+		start_arena();
+	}
+	size_t bytes_allocated_last_tick() const {
+		return bytes_last_tick;
+	}
+	size_t bytes_allocated_this_tick() const {
+		return bytes_requested;
+	}
+	size_t capacity() const {
+		return storage.size();
+	}
+};
+
+}
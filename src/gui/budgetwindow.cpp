@@ -647,7 +647,7 @@ void  budgetwindow_main_income_table_t::update(sys::state& state, layout_window_
 	add_section_header(budget_categories::tariffs_import);
 	if(budget_categories::expanded[budget_categories::tariffs_import]) {
 		add_bottom_spacer();
-		auto totals = economy::explain_national_tariff(state, state.local_player_nation, true, false);
+		auto totals = economy::cached::explain_national_tariff(state, state.local_player_nation, true, false);
 		for(auto& item : totals) {
 			add_budget_row(
 				text::produce_simple_string(state,
@@ -672,7 +672,7 @@ void  budgetwindow_main_income_table_t::update(sys::state& state, layout_window_
 	add_section_header(budget_categories::tariffs_export);
 	if(budget_categories::expanded[budget_categories::tariffs_export]) {
 		add_bottom_spacer();
-		auto totals = economy::explain_national_tariff(state, state.local_player_nation, false, true);
+		auto totals = economy::cached::explain_national_tariff(state, state.local_player_nation, false, true);
 		for(auto& item : totals) {
 			add_budget_row(
 				text::produce_simple_string(state,
@@ -697,10 +697,10 @@ void  budgetwindow_main_income_table_t::update(sys::state& state, layout_window_
 	add_section_header(budget_categories::diplomatic_income);
 	if(budget_categories::expanded[budget_categories::diplomatic_income]) {
 		add_bottom_spacer();
-		add_budget_row(text::produce_simple_string(state, "warsubsidies_button"), economy::estimate_war_subsidies_income(state, state.local_player_nation));
-		add_budget_row(text::produce_simple_string(state, "alice_budget_indemnities"), economy::estimate_reparations_income(state, state.local_player_nation));
+		add_budget_row(text::produce_simple_string(state, "warsubsidies_button"), economy::cached::estimate_war_subsidies_income(state, state.local_player_nation));
+		add_budget_row(text::produce_simple_string(state, "alice_budget_indemnities"), economy::cached::estimate_reparations_income(state, state.local_player_nation));
 		for(auto n : state.world.nation_get_overlord_as_ruler(state.local_player_nation)) {
-			auto transferamt = economy::estimate_subject_payments_paid(state, n.get_subject());
+			auto transferamt = economy::cached::estimate_subject_payments_paid(state, n.get_subject());
 			add_budget_row(text::produce_simple_string(state, text::get_name(state, n.get_subject())), transferamt);
 		}
 	} 
@@ -1169,9 +1169,9 @@ void  budgetwindow_main_espenses_table_t::update(sys::state& state, layout_windo
 	add_section_header(budget_categories::diplomatic_expenses);
 	if(budget_categories::expanded[budget_categories::diplomatic_expenses]) {
 		add_bottom_spacer();
-		add_budget_row(text::produce_simple_string(state, "warsubsidies_button"), economy::estimate_war_subsidies_spending(state, state.local_player_nation));
-		add_budget_row(text::produce_simple_string(state, "alice_budget_indemnities"), economy::estimate_reparations_spending(state, state.local_player_nation));
-		add_budget_row(text::produce_simple_string(state, "alice_budget_overlord"), economy::estimate_subject_payments_paid(state, state.local_player_nation));
+		add_budget_row(text::produce_simple_string(state, "warsubsidies_button"), economy::cached::estimate_war_subsidies_spending(state, state.local_player_nation));
+		add_budget_row(text::produce_simple_string(state, "alice_budget_indemnities"), economy::cached::estimate_reparations_spending(state, state.local_player_nation));
+		add_budget_row(text::produce_simple_string(state, "alice_budget_overlord"), economy::cached::estimate_subject_payments_paid(state, state.local_player_nation));
 		add_bottom_spacer();
 	} 
 	add_neutral_spacer();
@@ -1348,14 +1348,14 @@ void budgetwindow_main_income_amount_t::on_update(sys::state& state) noexcept {
 	budgetwindow_main_t& main = *((budgetwindow_main_t*)(parent)); 
 // BEGIN main::income_amount::update
 	float total = 0.0f;
-	total += economy::estimate_diplomatic_income(state, state.local_player_nation);
+	total += economy::cached::estimate_diplomatic_income(state, state.local_player_nation);
 	auto tax_info = economy::explain_tax_income(state, state.local_player_nation);
 	total += tax_info.poor;
 	total += tax_info.mid;
 	total += tax_info.rich;
-	total += economy::estimate_tariff_import_income(state, state.local_player_nation);
-	total += economy::estimate_tariff_export_income(state, state.local_player_nation);
-	total += economy::estimate_gold_income(state, state.local_player_nation);
+	total += economy::cached::estimate_tariff_import_income(state, state.local_player_nation);
+	total += economy::cached::estimate_tariff_export_income(state, state.local_player_nation);
+	total += economy::cached::estimate_gold_income(state, state.local_player_nation);
 	set_text(state, text::prettify_currency(total));
 // END
 }
@@ -3077,9 +3077,9 @@ void budgetwindow_section_header_expand_button_t::on_update(sys::state& state) n
 	case budget_categories::poor_tax: disabled = false; break;
 	case budget_categories::middle_tax: disabled = false; break;
 	case budget_categories::rich_tax: disabled = false; break;
-	case budget_categories::tariffs_import: disabled = (economy::estimate_tariff_import_income(state, state.local_player_nation) <= 0); break;
-	case budget_categories::tariffs_export: disabled = (economy::estimate_tariff_export_income(state, state.local_player_nation) <= 0); break;
-	case budget_categories::gold: disabled = (economy::estimate_gold_income(state, state.local_player_nation) <= 0); break;
+	case budget_categories::tariffs_import: disabled = (economy::cached::estimate_tariff_import_income(state, state.local_player_nation) <= 0); break;
+	case budget_categories::tariffs_export: disabled = (economy::cached::estimate_tariff_export_income(state, state.local_player_nation) <= 0); break;
+	case budget_categories::gold: disabled = (economy::cached::estimate_gold_income(state, state.local_player_nation) <= 0); break;
 	case budget_categories::diplomatic_expenses: disabled = (spending_details.diplomacy.actual_spending <= 0); break;
 	case budget_categories::social: disabled = (spending_details.social.actual_spending <= 0); break;
 	case budget_categories::military: disabled = false; break;
@@ -3125,13 +3125,13 @@ void budgetwindow_section_header_total_amount_t::on_update(sys::state& state) no
 	};
 
 	switch(section_header.section_type) {
-	case budget_categories::diplomatic_income: set_text(state, adjust_income_value(economy::estimate_diplomatic_income(state, state.local_player_nation))); break;
+	case budget_categories::diplomatic_income: set_text(state, adjust_income_value(economy::cached::estimate_diplomatic_income(state, state.local_player_nation))); break;
 	case budget_categories::poor_tax: set_text(state, adjust_income_value(info.poor)); break;
 	case budget_categories::middle_tax: set_text(state, adjust_income_value(info.mid)); break;
 	case budget_categories::rich_tax: set_text(state, adjust_income_value(info.rich)); break;
-	case budget_categories::tariffs_import: set_text(state, adjust_income_value(economy::estimate_tariff_import_income(state, state.local_player_nation))); break;
-	case budget_categories::tariffs_export: set_text(state, adjust_income_value(economy::estimate_tariff_export_income(state, state.local_player_nation))); break;
-	case budget_categories::gold: set_text(state, adjust_income_value(economy::estimate_gold_income(state, state.local_player_nation))); break;
+	case budget_categories::tariffs_import: set_text(state, adjust_income_value(economy::cached::estimate_tariff_import_income(state, state.local_player_nation))); break;
+	case budget_categories::tariffs_export: set_text(state, adjust_income_value(economy::cached::estimate_tariff_export_income(state, state.local_player_nation))); break;
+	case budget_categories::gold: set_text(state, adjust_income_value(economy::cached::estimate_gold_income(state, state.local_player_nation))); break;
 	case budget_categories::diplomatic_expenses: set_text(state, adjust_spending_value(spending_details.diplomacy.actual_spending)); break;
 	case budget_categories::social: set_text(state, adjust_spending_value(spending_details.social.actual_spending)); break;
 	case budget_categories::military: set_text(state, adjust_spending_value(spending_details.military_wages.actual_spending)); break;
@@ -489,13 +489,13 @@ public:
 
 				if(overlord == state.local_player_nation) {
 					bool temp = false;
-					float est_private_const_spending = economy::estimate_private_construction_spendings(state, n);
+					float est_private_const_spending = economy::cached::estimate_private_construction_spendings(state, n);
 					auto craved_constructions = economy::estimate_private_investment_construct(state, n, true, est_private_const_spending, temp);
 					//auto upgrades = economy::estimate_private_investment_upgrade(state, n, est_private_const_spending);
 					auto constructions = economy::estimate_private_investment_construct(state, n, false, est_private_const_spending, temp);
 					auto province_constr = economy::estimate_private_investment_province(state, n, est_private_const_spending);
 
-					if(economy::estimate_private_construction_spendings(state, n) < 1.0f /* && upgrades.size() == 0 */ && constructions.size() == 0 && province_constr.size() == 0) {
+					if(economy::cached::estimate_private_construction_spendings(state, n) < 1.0f /* && upgrades.size() == 0 */ && constructions.size() == 0 && province_constr.size() == 0) {
 						auto amt = state.world.nation_get_private_investment(n) * state.defines.alice_privateinvestment_subject_transfer / 100.f;
 
 						text::substitution_map sub{};
@@ -512,13 +512,13 @@ public:
 		text::add_line_break_to_layout(state, contents);
 		{
 			text::substitution_map sub{};
-			text::add_to_substitution_map(sub, text::variable_type::x, text::fp_currency{ economy::estimate_investment_pool_daily_loss(state, state.local_player_nation) });
+			text::add_to_substitution_map(sub, text::variable_type::x, text::fp_currency{ economy::cached::estimate_investment_pool_daily_loss(state, state.local_player_nation) });
 			auto box = text::open_layout_box(contents, 0);
 			text::localised_format_box(state, contents, box, "investment_pool_spending_1", sub);
 			text::close_layout_box(contents, box);
 		}
 
-		auto private_constr = economy::estimate_private_construction_spendings(state, state.local_player_nation);
+		auto private_constr = economy::cached::estimate_private_construction_spendings(state, state.local_player_nation);
 		{
 			text::substitution_map sub{};
 			text::add_to_substitution_map(sub, text::variable_type::x, text::fp_currency{ private_constr });
@@ -528,7 +528,7 @@ public:
 		}
 		{
 			bool temp = false;
-			float est_private_const_spending = economy::estimate_private_construction_spendings(state, state.local_player_nation);
+			float est_private_const_spending = economy::cached::estimate_private_construction_spendings(state, state.local_player_nation);
 			auto craved_constructions = economy::estimate_private_investment_construct(state, state.local_player_nation, true, est_private_const_spending, temp);
 			//auto upgrades = economy::estimate_private_investment_upgrade(state, state.local_player_nation, est_private_const_spending);
 			auto constructions = economy::estimate_private_investment_construct(state, state.local_player_nation, false, est_private_const_spending, temp);
@@ -610,16 +610,9 @@ void  market_trade_report_body_list_t::update(sys::state& state, layout_window_e
 	auto sid = state.world.province_get_state_membership(pid);
 	auto mid = state.world.state_instance_get_market_from_local_market(sid);
 
-	state.world.market_for_each_trade_route(mid, [&](auto trid) {
-		auto mid_0 = state.world.trade_route_get_connected_markets(trid, 0);
-		auto mid_1 = state.world.trade_route_get_connected_markets(trid, 1);
-
-		if(mid_0 == mid) {
-			add_trade_item(mid_1);
-		} else {
-			add_trade_item(mid_0);
-		}
-	});
+	for(auto other : economy::cached::trade_partners(state, mid)) {
+		add_trade_item(other);
+	}
 
 // END
 	{
@@ -724,14 +717,8 @@ void  market_trade_report_body_list_t::update(sys::state& state, layout_window_e
 
 							result = cmp3(value_a * price, value_b * price);
 						} else {
-							auto value_a = 0.f;
-							auto value_b = 0.f;
-
-							state.world.for_each_commodity([&](auto cid) {
-								auto price = state.world.commodity_get_median_price(cid);
-								value_a += price * state.world.trade_route_get_volume(trade_route_a, cid) * mult_a;
-								value_b += price * state.world.trade_route_get_volume(trade_route_b, cid) * mult_b;
-							});
+							auto value_a = economy::cached::trade_route_value(state, trade_route_a) * mult_a;
+							auto value_b = economy::cached::trade_route_value(state, trade_route_b) * mult_b;
 
 							result = cmp3(value_a, value_b);
 						}
@@ -1931,13 +1918,7 @@ void market_trade_report_trade_item_trade_item_c_t::on_update(sys::state& state)
 	} else {
 		set_volume_text(state, "");
 
-		float total = 0.f;
-		state.world.for_each_commodity([&](auto cid) {
-			auto median_price = state.world.commodity_get_median_price(cid);
-			auto volume = state.world.trade_route_get_volume(route, cid);
-			total += median_price * volume;
-		});
-		set_value_text(state, text::format_money(total * mult));
+		set_value_text(state, text::format_money(economy::cached::trade_route_value(state, route) * mult));
 
 		set_price_text(state, "");
 	}
@@ -231,11 +231,8 @@ void display_data::update_fog_of_war(sys::state& state) {
 		for(auto p : direct_provinces) {
 			if(bool(p)) {
 				state.map_state.visible_provinces[province::to_map_id(p)] = true;
-				for(auto c : state.world.province_get_province_adjacency(p)) {
-					auto pc = c.get_connected_provinces(0) == p ? c.get_connected_provinces(1) : c.get_connected_provinces(0);
-					if(bool(pc)) {
-						state.map_state.visible_provinces[province::to_map_id(pc)] = true;
-					}
+				for(auto& e : state.adjacency_graph.neighbors(p)) {
+					state.map_state.visible_provinces[province::to_map_id(e.neighbor)] = true;
 				}
 			}
 		}
@@ -440,6 +440,7 @@ void invalidate_unowned_wargoals(sys::state& state) {
 					}
 				}
 				if(!found_state) {
+					mark_war_score_stale(state, wg.get_war_from_wargoals_attached(), war_score_part::war_goals);
 					state.world.delete_wargoal(wg);
 				}
 			}
@@ -889,9 +890,68 @@ bool are_enemies(sys::state const& state, dcon::nation_id a, dcon::nation_id b)
 	}
 }
 
+bool war_relation_is_current(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	auto& md = state.military_definitions;
+	return !md.war_relations_out_of_date && a && b && uint32_t(a.index()) < md.war_relation_nations && uint32_t(b.index()) < md.war_relation_nations;
+}
+bool war_relation_bit(sys::state const& state, std::vector<uint64_t> const& rows, dcon::nation_id a, dcon::nation_id b) {
+	auto word = size_t(a.index()) * state.military_definitions.war_relation_row_words + size_t(b.index() / 64);
+	return ((rows[word] >> (b.index() % 64)) & 1) != 0;
+}
+
+void mark_war_relations_out_of_date(sys::state& state) {
+	state.military_definitions.war_relations_out_of_date = true;
+}
+
+// b counts as an enemy or an ally of a according to the first war of a, in the order of its war participations, that b takes part in
+// which is the answer are_at_war and are_allied_in_war give when they walk the wars
+void update_war_relations(sys::state& state) {
+	auto& md = state.military_definitions;
+	if(!md.war_relations_out_of_date)
+		return;
+
+	auto nation_count = state.world.nation_size();
+	auto row_words = (nation_count + 63) / 64;
+	md.war_relation_nations = nation_count;
+	md.war_relation_row_words = row_words;
+	md.enemies_in_war.assign(size_t(nation_count) * row_words, 0);
+	md.allies_in_war.assign(size_t(nation_count) * row_words, 0);
+
+	concurrency::parallel_for(uint32_t(0), nation_count, [&](uint32_t i) {
+		dcon::nation_id a{ dcon::nation_id::value_base_t(i) };
+		if(!state.world.nation_is_valid(a))
+			return;
+		auto wars = state.world.nation_get_war_participant(a);
+		if(wars.begin() == wars.end())
+			return;
+
+		static thread_local std::vector<uint64_t> decided;
+		decided.assign(row_words, 0);
+		auto row = size_t(i) * row_words;
+		for(auto wa : wars) {
+			auto is_attacker = wa.get_is_attacker();
+			for(auto o : wa.get_war().get_war_participant()) {
+				auto b = uint32_t(o.get_nation().id.index());
+				auto bit = uint64_t(1) << (b % 64);
+				if((decided[b / 64] & bit) != 0)
+					continue;
+				decided[b / 64] |= bit;
+				if(o.get_is_attacker() != is_attacker)
+					md.enemies_in_war[row + b / 64] |= bit;
+				else
+					md.allies_in_war[row + b / 64] |= bit;
+			}
+		}
+	});
+
+	md.war_relations_out_of_date = false;
+}
+
 bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
 	if(!state.world.nation_get_is_at_war(a) || !state.world.nation_get_is_at_war(b))
 		return false;
+	if(war_relation_is_current(state, a, b))
+		return war_relation_bit(state, state.military_definitions.enemies_in_war, a, b);
 	for(auto wa : state.world.nation_get_war_participant(a)) {
 		auto is_attacker = wa.get_is_attacker();
 		for(auto o : wa.get_war().get_war_participant()) {
@@ -903,6 +963,8 @@ bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
 }
 
 bool are_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	if(war_relation_is_current(state, a, b))
+		return war_relation_bit(state, state.military_definitions.allies_in_war, a, b);
 	for(auto wa : state.world.nation_get_war_participant(a)) {
 		auto is_attacker = wa.get_is_attacker();
 		for(auto o : wa.get_war().get_war_participant()) {
@@ -1067,30 +1129,34 @@ float get_war_exhaustion_from_land_losses(sys::state& state, float strength_loss
 	}
 }
 
-int32_t supply_limit_in_province(sys::state& state, dcon::nation_id n, dcon::province_id p) {
-	/*
-	(province-supply-limit-modifier + 1) x (2.5 if it is owned an controlled or 2 if it is just controlled, you are allied to the
-	controller, have military access with the controller, a rebel controls it, it is one of your core provinces, or you are
-	sieging it) x (technology-supply-limit-modifier + 1)
-	*/
-	float modifier = 1.0f;
+supply_class supply_class_in_province(sys::state& state, dcon::nation_id n, dcon::province_id p) {
 	auto prov_controller = state.world.province_get_nation_from_province_control(p);
 	auto self_controlled = prov_controller == n;
 	if(state.world.province_get_nation_from_province_ownership(p) == n && self_controlled) {
-		modifier = 2.5f;
+		return supply_class::owned;
 	} else if(self_controlled ||
 						bool(state.world.province_get_rebel_faction_from_province_rebel_control(p))) { // TODO: check for sieging
-		modifier = 2.0f;
+		return supply_class::friendly;
 	} else if(auto dip_rel = state.world.get_diplomatic_relation_by_diplomatic_pair(prov_controller, n);
 						state.world.diplomatic_relation_get_are_allied(dip_rel)) {
-		modifier = 2.0f;
+		return supply_class::friendly;
 	} else if(province::has_safe_access_to_province(state, n, p)) {
-		modifier = 2.0f;
+		return supply_class::friendly;
 	} else if(bool(state.world.get_core_by_prov_tag_key(p, state.world.nation_get_identity_from_identity_holder(n)))) {
-		modifier = 2.0f;
+		return supply_class::friendly;
 	} else if(state.world.province_get_siege_progress(p) > 0.0f) {
-		modifier = 2.0f;
+		return supply_class::friendly;
 	}
+	return supply_class::foreign;
+}
+
+int32_t supply_limit_in_province(sys::state& state, dcon::nation_id n, dcon::province_id p) {
+	/*
+	(province-supply-limit-modifier + 1) x (2.5 if it is owned an controlled or 2 if it is just controlled, you are allied to the
+	controller, have military access with the controller, a rebel controls it, it is one of your core provinces, or you are
+	sieging it) x (technology-supply-limit-modifier + 1)
+	*/
+	float modifier = supply_class_multiplier[uint8_t(supply_class_in_province(state, n, p))];
 	auto base_supply_lim = (state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::supply_limit) + 1.0f);
 	auto national_supply_lim = (state.world.nation_get_modifier_values(n, sys::national_mod_offsets::supply_limit) + 1.0f);
 	return std::max(int32_t(base_supply_lim * modifier * national_supply_lim), 0);
@@ -2710,11 +2776,13 @@ void give_military_access(sys::state& state, dcon::nation_id accessing_nation, d
 		ur = state.world.force_create_unilateral_relationship(target, accessing_nation);
 	}
 	state.world.unilateral_relationship_set_military_access(ur, true);
+	state.path_cache.relations_changed(accessing_nation, target);
 }
 void remove_military_access(sys::state& state, dcon::nation_id accessing_nation, dcon::nation_id target) {
 	auto ur = state.world.get_unilateral_relationship_by_unilateral_pair(target, accessing_nation);
 	if(ur) {
 		state.world.unilateral_relationship_set_military_access(ur, false);
+		state.path_cache.relations_changed(accessing_nation, target);
 	}
 }
 
@@ -2743,15 +2811,25 @@ void populate_war_text_subsitutions(sys::state& state, dcon::war_id w, text::sub
 	text::add_to_substitution_map(sub, text::variable_type::country_adj, state.world.national_identity_get_adjective(war.get_over_tag()));
 }
 
+// n joins or leaves w, which changes whether it may pass through the provinces of every other participant and the other way round
+void war_paths_changed(sys::state& state, dcon::war_id w, dcon::nation_id n) {
+	for(auto p : state.world.war_get_war_participant(w))
+		state.path_cache.relations_changed(n, p.get_nation());
+	state.path_cache.relations_changed(n, n);
+}
+
 void add_to_war(sys::state& state, dcon::war_id w, dcon::nation_id n, bool as_attacker, bool on_war_creation) {
 	assert(n);
 	if(state.world.nation_get_owned_province_count(n) == 0)
 		return;
 
 	state.trade_route_cached_values_out_of_date = true;
+	war_paths_changed(state, w, n);
 
 	auto participant = state.world.force_create_war_participant(w, n);
 	state.world.war_participant_set_is_attacker(participant, as_attacker);
+	mark_war_relations_out_of_date(state);
+	mark_all_war_scores_stale(state, war_score_part::all);
 	state.world.nation_set_is_at_war(n, true);
 	state.world.nation_set_disarmed_until(n, sys::date{});
 
@@ -3072,6 +3150,7 @@ void call_attacker_allies(sys::state& state, dcon::war_id wfor) {
 }
 void add_wargoal(sys::state& state, dcon::war_id wfor, dcon::nation_id added_by, dcon::nation_id target, dcon::cb_type_id type,
 		dcon::state_definition_id sd, dcon::national_identity_id tag, dcon::nation_id secondary_nation) {
+	mark_war_score_stale(state, wfor, war_score_part::war_goals);
 	auto for_attacker = is_attacker(state, wfor, added_by);
 
 	if(sd) {
@@ -3164,6 +3243,7 @@ void add_wargoal(sys::state& state, dcon::war_id wfor, dcon::nation_id added_by,
 }
 
 void remove_from_war(sys::state& state, dcon::war_id w, dcon::nation_id n, bool as_loss) {
+	war_paths_changed(state, w, n);
 	for(auto vas : state.world.nation_get_overlord_as_ruler(n)) {
 		remove_from_war(state, w, vas.get_subject(), as_loss);
 	}
@@ -3222,6 +3302,8 @@ void remove_from_war(sys::state& state, dcon::war_id w, dcon::nation_id n, bool
 	}
 
 	state.world.delete_war_participant(par);
+	mark_war_relations_out_of_date(state);
+	mark_all_war_scores_stale(state, war_score_part::all);
 	auto rem_wars = state.world.nation_get_war_participant(n);
 	if(rem_wars.begin() == rem_wars.end()) {
 		// give back units if said nation is a puppet and there are no remaining wars
@@ -3283,6 +3365,10 @@ void cleanup_war(sys::state& state, dcon::war_id w, war_result result) {
 		end_battle(state, (*lbattles.begin()).get_battle().id, battle_result::indecisive);
 	}
 
+	for(auto po : state.world.war_get_war_settlement(w))
+		queue_for_gc(state, po.get_peace_offer().id);
+	for(auto wg : state.world.war_get_wargoals_attached(w))
+		queue_for_gc(state, wg.get_wargoal().id);
 	state.world.delete_war(w);
 }
 
@@ -3457,6 +3543,7 @@ void implement_war_goal(sys::state& state, dcon::war_id war, dcon::cb_type_id wa
 
 	// po_destory_forts: reduces fort levels to zero in any targeted states
 	if((bits & cb_flag::po_destroy_forts) != 0) {
+		state.path_cache.invalidate();
 		if((bits & cb_flag::all_allowed_states) == 0) {
 			for(auto prov : state.world.state_definition_get_abstract_state_membership(wargoal_state)) {
 				if(prov.get_province().get_nation_from_province_ownership() == target) {
@@ -3476,6 +3563,7 @@ void implement_war_goal(sys::state& state, dcon::war_id war, dcon::cb_type_id wa
 
 	// po_destory_naval_bases: as above
 	if((bits & cb_flag::po_destroy_naval_bases) != 0) {
+		state.path_cache.invalidate();
 		if((bits & cb_flag::all_allowed_states) == 0) {
 			for(auto prov : state.world.state_definition_get_abstract_state_membership(wargoal_state)) {
 				if(prov.get_province().get_nation_from_province_ownership() == target) {
@@ -3810,6 +3898,7 @@ void merge_navies_impl(sys::state& state, dcon::navy_id a, dcon::navy_id b) {
 		auto reg = (*regs.begin()).get_ship();
 		reg.set_navy_from_navy_membership(a);
 	}
+	queue_for_gc(state, b);
 
 	auto transported = state.world.navy_get_army_transport(b);
 	while(transported.begin() != transported.end()) {
@@ -3818,31 +3907,95 @@ void merge_navies_impl(sys::state& state, dcon::navy_id a, dcon::navy_id b) {
 	}
 }
 
+void queue_for_gc(sys::state& state, dcon::army_id a) {
+	state.military_definitions.gc_armies.push_back(a);
+}
+void queue_for_gc(sys::state& state, dcon::navy_id n) {
+	state.military_definitions.gc_navies.push_back(n);
+}
+void queue_for_gc(sys::state& state, dcon::peace_offer_id p) {
+	state.military_definitions.gc_peace_offers.push_back(p);
+}
+void queue_for_gc(sys::state& state, dcon::wargoal_id w) {
+	state.military_definitions.gc_wargoals.push_back(w);
+}
+void queue_units_for_gc(sys::state& state, dcon::nation_id n) {
+	for(auto a : state.world.nation_get_army_control(n))
+		queue_for_gc(state, a.get_army().id);
+	for(auto v : state.world.nation_get_navy_control(n))
+		queue_for_gc(state, v.get_navy().id);
+}
+void queue_units_for_gc(sys::state& state, dcon::rebel_faction_id r) {
+	for(auto a : state.world.rebel_faction_get_army_rebel_control(r))
+		queue_for_gc(state, a.get_army().id);
+}
+
+void delete_peace_offer(sys::state& state, dcon::peace_offer_id p) {
+	for(auto item : state.world.peace_offer_get_peace_offer_item(p))
+		queue_for_gc(state, item.get_wargoal().id);
+	state.world.delete_peace_offer(p);
+}
+
+// sorts the queued ids into the order in which a sweep over all of them visits them, dropping duplicates
+template<typename T>
+void order_gc_queue(std::vector<T>& queue, bool descending) {
+	std::sort(queue.begin(), queue.end(), [descending](T a, T b) {
+		return descending ? a.index() > b.index() : a.index() < b.index();
+	});
+	queue.erase(std::unique(queue.begin(), queue.end()), queue.end());
+}
+
 void run_gc(sys::state& state) {
+	auto& md = state.military_definitions;
 
 	//
 	// peace offers from dead nations
 	//
 
-	auto remove_pending_offer = [&](dcon::peace_offer_id id) {
+	// an ending crisis makes every crisis offer stale at once
+	bool crisis_ended = md.gc_crisis_was_active && state.current_crisis_state == sys::crisis_state::inactive;
+	md.gc_crisis_was_active = state.current_crisis_state != sys::crisis_state::inactive;
+
+	static std::vector<dcon::peace_offer_id> offers;
+	offers.clear();
+	if(md.gc_full_sweep || crisis_ended) {
+		for(auto po : state.world.in_peace_offer)
+			offers.push_back(po);
+	} else {
+		offers.swap(md.gc_peace_offers);
+		order_gc_queue(offers, false);
+	}
+	md.gc_peace_offers.clear();
+
+	static std::vector<dcon::peace_offer_id> stale_offers;
+	stale_offers.clear();
+	for(auto id : offers) {
+		if(!state.world.peace_offer_is_valid(id))
+			continue;
+		auto po = fatten(state.world, id);
+		if(!po.get_nation_from_pending_peace_offer()
+			|| (!po.get_war_from_war_settlement() && !po.get_is_crisis_offer())
+			|| (state.current_crisis_state == sys::crisis_state::inactive && po.get_is_crisis_offer())) {
+			stale_offers.push_back(id);
+		}
+	}
+	if(!stale_offers.empty()) {
+		// the first pending message of each stale offer is dropped
+		static std::vector<bool> message_removed;
+		message_removed.assign(stale_offers.size(), false);
 		for(auto& m : state.pending_messages) {
-			if(m.type == diplomatic_message::type::peace_offer && m.data.peace == id) {
+			if(m.type != diplomatic_message::type::peace_offer)
+				continue;
+			auto it = std::lower_bound(stale_offers.begin(), stale_offers.end(), m.data.peace, [](dcon::peace_offer_id a, dcon::peace_offer_id b) {
+				return a.index() < b.index();
+			});
+			if(it != stale_offers.end() && *it == m.data.peace && !message_removed[it - stale_offers.begin()]) {
+				message_removed[it - stale_offers.begin()] = true;
 				m.type = diplomatic_message::type::none;
-				return;
 			}
 		}
-		};
-	for(auto po : state.world.in_peace_offer) {
-		if(!po.get_nation_from_pending_peace_offer()) {
-			remove_pending_offer(po);
-			state.world.delete_peace_offer(po);
-		} else if(!po.get_war_from_war_settlement() && !po.get_is_crisis_offer()) {
-			remove_pending_offer(po);
-			state.world.delete_peace_offer(po);
-		} else if(state.current_crisis_state == sys::crisis_state::inactive && po.get_is_crisis_offer()) {
-			remove_pending_offer(po);
-			state.world.delete_peace_offer(po);
-		}
+		for(auto id : stale_offers)
+			delete_peace_offer(state, id);
 	}
 
 	//
@@ -3853,8 +4006,10 @@ void run_gc(sys::state& state) {
 	to_delete.clear();
 	for(auto w : state.world.in_war) {
 		for(auto wg : w.get_wargoals_attached()) {
-			if(get_role(state, w, wg.get_wargoal().get_added_by()) == war_role::none || get_role(state, w, wg.get_wargoal().get_target_nation()) == war_role::none)
+			if(get_role(state, w, wg.get_wargoal().get_added_by()) == war_role::none || get_role(state, w, wg.get_wargoal().get_target_nation()) == war_role::none) {
+				mark_war_score_stale(state, w, war_score_part::war_goals);
 				to_delete.push_back(wg.get_wargoal());
+			}
 		}
 	}
 	for(auto g : to_delete)
@@ -3877,6 +4032,7 @@ void run_gc(sys::state& state) {
 				continue;
 			}
 			w.set_primary_attacker(n);
+			mark_war_score_stale(state, w, war_score_part::all);
 		}
 		if(get_role(state, w, w.get_primary_defender()) != war_role::defender || w.get_primary_defender().get_overlord_as_subject().get_ruler()) {
 			int32_t best_rank = 0;
@@ -3894,6 +4050,7 @@ void run_gc(sys::state& state) {
 				continue;
 			}
 			w.set_primary_defender(n);
+			mark_war_score_stale(state, w, war_score_part::all);
 		}
 		bool non_sq_war_goal = false;
 		for(auto wg : w.get_wargoals_attached()) {
@@ -3913,38 +4070,82 @@ void run_gc(sys::state& state) {
 	//
 	// wargoals that do not belong to a peace offer or war
 	//
-	for(auto wg : state.world.in_wargoal) {
-		auto po = wg.get_peace_offer_from_peace_offer_item();
-		auto wr = wg.get_war_from_wargoals_attached();
-		if(!po && !wr)
-			state.world.delete_wargoal(wg);
+
+	static std::vector<dcon::wargoal_id> wargoals;
+	wargoals.clear();
+	if(md.gc_full_sweep) {
+		for(auto wg : state.world.in_wargoal)
+			wargoals.push_back(wg);
+	} else {
+		wargoals.swap(md.gc_wargoals);
+		order_gc_queue(wargoals, false);
+	}
+	md.gc_wargoals.clear();
+	for(auto id : wargoals) {
+		if(!state.world.wargoal_is_valid(id))
+			continue;
+		if(!state.world.wargoal_get_peace_offer_from_peace_offer_item(id) && !state.world.wargoal_get_war_from_wargoals_attached(id))
+			state.world.delete_wargoal(id);
 	}
 
 	//
 	// empty armies / navies or leaderless ones
+	// units in a battle stay queued until a later run finds them out of it
 	//
-	for(uint32_t i = state.world.navy_size(); i-- > 0; ) {
-		dcon::navy_id n{ dcon::navy_id::value_base_t(i) };
+
+	static std::vector<dcon::navy_id> navies;
+	navies.clear();
+	if(md.gc_full_sweep) {
+		for(uint32_t i = state.world.navy_size(); i-- > 0; ) {
+			dcon::navy_id n{ dcon::navy_id::value_base_t(i) };
+			if(state.world.navy_is_valid(n))
+				navies.push_back(n);
+		}
+	} else {
+		navies.swap(md.gc_navies);
+		order_gc_queue(navies, true);
+	}
+	md.gc_navies.clear();
+	for(auto n : navies) {
 		if(state.world.navy_is_valid(n)) {
 			auto rng = state.world.navy_get_navy_membership(n);
 			if(!state.world.navy_get_battle_from_navy_battle_participation(n)) {
 				if(rng.begin() == rng.end() || !state.world.navy_get_controller_from_navy_control(n)) {
 					military::cleanup_navy(state, n);
 				}
+			} else {
+				queue_for_gc(state, n);
 			}
 		}
 	}
-	for(uint32_t i = state.world.army_size(); i-- > 0; ) {
-		dcon::army_id n{ dcon::army_id::value_base_t(i) };
+
+	static std::vector<dcon::army_id> armies;
+	armies.clear();
+	if(md.gc_full_sweep) {
+		for(uint32_t i = state.world.army_size(); i-- > 0; ) {
+			dcon::army_id n{ dcon::army_id::value_base_t(i) };
+			if(state.world.army_is_valid(n))
+				armies.push_back(n);
+		}
+	} else {
+		armies.swap(md.gc_armies);
+		order_gc_queue(armies, true);
+	}
+	md.gc_armies.clear();
+	for(auto n : armies) {
 		if(state.world.army_is_valid(n)) {
 			auto rng = state.world.army_get_army_membership(n);
 			if(!state.world.army_get_battle_from_army_battle_participation(n)) {
 				if(rng.begin() == rng.end() || (!state.world.army_get_controller_from_army_rebel_control(n) && !state.world.army_get_controller_from_army_control(n))) {
 					military::cleanup_army(state, n);
 				}
+			} else {
+				queue_for_gc(state, n);
 			}
 		}
 	}
+
+	md.gc_full_sweep = false;
 }
 
 void add_truce_between_sides(sys::state& state, dcon::war_id w, int32_t months) {
@@ -4005,6 +4206,7 @@ void add_truce(sys::state& state, dcon::nation_id a, dcon::nation_id b, int32_t
 }
 
 void implement_peace_offer(sys::state& state, dcon::peace_offer_id offer) {
+	mark_all_war_scores_stale(state, war_score_part::all); // war goals are removed and added, and wars may end
 	dcon::nation_id from = state.world.peace_offer_get_nation_from_pending_peace_offer(offer);
 	dcon::nation_id target = state.world.peace_offer_get_target(offer);
 
@@ -4301,6 +4503,7 @@ void implement_peace_offer(sys::state& state, dcon::peace_offer_id offer) {
 
 	state.world.peace_offer_set_war_from_war_settlement(offer, dcon::war_id{});
 	state.world.peace_offer_set_is_crisis_offer(offer, false);
+	queue_for_gc(state, offer);
 }
 
 void reject_peace_offer(sys::state& state, dcon::peace_offer_id offer) {
@@ -4342,6 +4545,7 @@ void reject_peace_offer(sys::state& state, dcon::peace_offer_id offer) {
 
 	state.world.peace_offer_set_war_from_war_settlement(offer, dcon::war_id{});
 	state.world.peace_offer_set_is_crisis_offer(offer, false);
+	queue_for_gc(state, offer);
 }
 
 void update_ticking_war_score(sys::state& state) {
@@ -4477,41 +4681,94 @@ void update_ticking_war_score(sys::state& state) {
 	}
 }
 
-float primary_warscore_from_blockades(sys::state& state, dcon::war_id w) {
-	auto pattacker = state.world.war_get_primary_attacker(w);
-	auto pdefender = state.world.war_get_primary_defender(w);
+namespace {
+// the province flags compared by update_war_scores
+constexpr uint8_t war_score_province_overseas = 0x01;
+constexpr uint8_t war_score_province_blockaded = 0x02;
 
-	auto d_cpc = state.world.nation_get_central_ports(pdefender);
-	int32_t d_blockaded_in_war = 0;
-	for(auto p : state.world.nation_get_province_ownership(pdefender)) {
+struct occupation_points {
+	int32_t total = 0;
+	int32_t occupied = 0;
+};
+
+// the victory points of the territory of n, and how many of them count as occupied towards the occupation war score of w
+// province points are small integers and the occupied share of a province is all or nothing, so the sums are exact
+occupation_points count_occupation_points(sys::state& state, dcon::war_id w, dcon::nation_id n) {
+	occupation_points result;
+	for(auto prv : state.world.nation_get_province_ownership(n)) {
+		auto v = province_point_cost(state, prv.get_province(), n);
+		result.total += v;
+		if(share_province_score_for_war_occupation(state, w, prv.get_province()) > 0.0f)
+			result.occupied += v;
+	}
+	return result;
+}
+
+// the blockaded central ports of n with a navy on the side of enemy in w in front of them
+int32_t count_blockaded_ports(sys::state& state, dcon::war_id w, dcon::nation_id n, war_role enemy) {
+	int32_t blockaded_in_war = 0;
+	for(auto p : state.world.nation_get_province_ownership(n)) {
 		if(military::province_is_blockaded(state, p.get_province()) && !province::is_overseas(state, p.get_province().id)) {
 			for(auto v : state.world.province_get_navy_location(p.get_province().get_port_to())) {
 				if(!v.get_navy().get_is_retreating() && !v.get_navy().get_battle_from_navy_battle_participation()) {
-					if(military::get_role(state, w, v.get_navy().get_controller_from_navy_control()) == military::war_role::attacker) {
-						++d_blockaded_in_war;
+					if(military::get_role(state, w, v.get_navy().get_controller_from_navy_control()) == enemy) {
+						++blockaded_in_war;
 						break; // out of inner loop
 					}
 				}
 			}
 		}
 	}
-	auto def_b_frac = std::clamp(d_cpc > 0 ? float(d_blockaded_in_war) / float(d_cpc) : 0.0f, 0.0f, 1.0f);
+	return blockaded_in_war;
+}
 
-	int32_t a_blockaded_in_war = 0;
-	for(auto p : state.world.nation_get_province_ownership(pattacker)) {
-		if(military::province_is_blockaded(state, p.get_province()) && !province::is_overseas(state, p.get_province().id)) {
-			for(auto v : state.world.province_get_navy_location(p.get_province().get_port_to())) {
-				if(!v.get_navy().get_is_retreating() && !v.get_navy().get_battle_from_navy_battle_participation()) {
-					if(military::get_role(state, w, v.get_navy().get_controller_from_navy_control()) == military::war_role::defender) {
-						++a_blockaded_in_war;
-						break; // out of inner loop
-					}
-				}
-			}
+float count_war_goal_score(sys::state& state, dcon::war_id w) {
+	float total = 0.0f;
+	for(auto wg : state.world.war_get_wargoals_attached(w)) {
+		if(is_attacker(state, w, wg.get_wargoal().get_added_by())) {
+			total += wg.get_wargoal().get_ticking_war_score();
+		} else {
+			total -= wg.get_wargoal().get_ticking_war_score();
 		}
 	}
+	return total;
+}
+
+bool war_score_part_is_current(sys::state const& state, dcon::war_id w, uint8_t part) {
+	return (state.world.war_get_war_score_current_parts(w) & part) == part;
+}
+
+occupation_points attacker_occupation_points(sys::state& state, dcon::war_id w) {
+	if(war_score_part_is_current(state, w, war_score_part::attacker_occupation))
+		return occupation_points{ state.world.war_get_attacker_points(w), state.world.war_get_attacker_occupied_points(w) };
+	return count_occupation_points(state, w, state.world.war_get_primary_attacker(w));
+}
+occupation_points defender_occupation_points(sys::state& state, dcon::war_id w) {
+	if(war_score_part_is_current(state, w, war_score_part::defender_occupation))
+		return occupation_points{ state.world.war_get_defender_points(w), state.world.war_get_defender_occupied_points(w) };
+	return count_occupation_points(state, w, state.world.war_get_primary_defender(w));
+}
+int32_t attacker_blockaded_ports(sys::state& state, dcon::war_id w) {
+	if(war_score_part_is_current(state, w, war_score_part::attacker_blockades))
+		return state.world.war_get_attacker_blockaded_ports(w);
+	return count_blockaded_ports(state, w, state.world.war_get_primary_attacker(w), war_role::defender);
+}
+int32_t defender_blockaded_ports(sys::state& state, dcon::war_id w) {
+	if(war_score_part_is_current(state, w, war_score_part::defender_blockades))
+		return state.world.war_get_defender_blockaded_ports(w);
+	return count_blockaded_ports(state, w, state.world.war_get_primary_defender(w), war_role::attacker);
+}
+}
+
+float primary_warscore_from_blockades(sys::state& state, dcon::war_id w) {
+	auto pattacker = state.world.war_get_primary_attacker(w);
+	auto pdefender = state.world.war_get_primary_defender(w);
+
+	auto d_cpc = state.world.nation_get_central_ports(pdefender);
+	auto def_b_frac = std::clamp(d_cpc > 0 ? float(defender_blockaded_ports(state, w)) / float(d_cpc) : 0.0f, 0.0f, 1.0f);
+
 	auto a_cpc = state.world.nation_get_central_ports(pattacker);
-	auto att_b_frac = std::clamp(a_cpc > 0 ? float(a_blockaded_in_war) / float(a_cpc) : 0.0f, 0.0f, 1.0f);
+	auto att_b_frac = std::clamp(a_cpc > 0 ? float(attacker_blockaded_ports(state, w)) / float(a_cpc) : 0.0f, 0.0f, 1.0f);
 
 	return 25.0f * (def_b_frac - att_b_frac);
 }
@@ -4536,27 +4793,12 @@ float primary_warscore(sys::state& state, dcon::war_id w) {
 float primary_warscore_from_occupation(sys::state& state, dcon::war_id w) {
 	float total = 0.0f;
 
-	auto pattacker = state.world.war_get_primary_attacker(w);
-	auto pdefender = state.world.war_get_primary_defender(w);
-
-	float sum_attacker_prov_values = 0;
-	float sum_attacker_occupied_values = 0;
-	for(auto prv : state.world.nation_get_province_ownership(pattacker)) {
-		auto v = (float) province_point_cost(state, prv.get_province(), pattacker);
-		sum_attacker_prov_values += v;
-		sum_attacker_occupied_values += share_province_score_for_war_occupation(state, w, prv.get_province()) * v;
-	}
+	auto attacker = attacker_occupation_points(state, w);
+	auto defender = defender_occupation_points(state, w);
 
-	float sum_defender_prov_values = 0;
-	float sum_defender_occupied_values = 0;
-	for(auto prv : state.world.nation_get_province_ownership(pdefender)) {
-		auto v = (float) province_point_cost(state, prv.get_province(), pdefender);
-		sum_defender_prov_values += v;
-		sum_defender_occupied_values += share_province_score_for_war_occupation(state, w, prv.get_province()) * v;
-	}
 	// if one side occupues 100% of victory points, then it is 100 warscore no matter what the other side may occupy
-	if(sum_defender_prov_values > 0) {
-		float defender_total = (sum_defender_occupied_values * 100.0f) / sum_defender_prov_values;
+	if(defender.total > 0) {
+		float defender_total = (float(defender.occupied) * 100.0f) / float(defender.total);
 		if(defender_total >= 100.0f) {
 			return defender_total;
 		}
@@ -4565,8 +4807,8 @@ float primary_warscore_from_occupation(sys::state& state, dcon::war_id w) {
 		}
 	}
 		
-	if(sum_attacker_prov_values > 0) {
-		float attacker_total = (sum_attacker_occupied_values * 100.0f) / sum_attacker_prov_values;
+	if(attacker.total > 0) {
+		float attacker_total = (float(attacker.occupied) * 100.0f) / float(attacker.total);
 		if(attacker_total >= 100.0f) {
 			return -attacker_total;
 		}
@@ -4582,17 +4824,119 @@ float primary_warscore_from_battles(sys::state& state, dcon::war_id w) {
 			-state.defines.max_warscore_from_battles, state.defines.max_warscore_from_battles);
 }
 float primary_warscore_from_war_goals(sys::state& state, dcon::war_id w) {
-	float total = 0.0f;
+	if(war_score_part_is_current(state, w, war_score_part::war_goals))
+		return state.world.war_get_war_goal_score(w);
+	return count_war_goal_score(state, w);
+}
 
-	for(auto wg : state.world.war_get_wargoals_attached(w)) {
-		if(is_attacker(state, w, wg.get_wargoal().get_added_by())) {
-			total += wg.get_wargoal().get_ticking_war_score();
-		} else {
-			total -= wg.get_wargoal().get_ticking_war_score();
+void mark_war_score_stale(sys::state& state, dcon::war_id w, uint8_t parts) {
+	state.world.war_set_war_score_current_parts(w, uint8_t(state.world.war_get_war_score_current_parts(w) & ~parts));
+}
+
+void mark_war_scores_stale(sys::state& state, dcon::nation_id n, uint8_t parts) {
+	for(auto wp : state.world.nation_get_war_participant(n)) {
+		auto w = wp.get_war();
+		if(w.get_primary_attacker() == n)
+			mark_war_score_stale(state, w, uint8_t(parts & (war_score_part::attacker_occupation | war_score_part::attacker_blockades)));
+		if(w.get_primary_defender() == n)
+			mark_war_score_stale(state, w, uint8_t(parts & (war_score_part::defender_occupation | war_score_part::defender_blockades)));
+	}
+}
+
+void mark_all_war_scores_stale(sys::state& state, uint8_t parts) {
+	for(auto w : state.world.in_war)
+		mark_war_score_stale(state, w, parts);
+}
+
+void mark_port_war_scores_stale(sys::state& state, dcon::province_id sea) {
+	if(!sea)
+		return;
+	for(auto adj : state.world.province_get_province_adjacency(sea)) {
+		auto indx = adj.get_connected_provinces(0).id != sea ? 0 : 1;
+		auto coast = adj.get_connected_provinces(indx);
+		if(coast.get_port_to() == sea) {
+			if(auto owner = coast.get_nation_from_province_ownership(); owner)
+				mark_war_scores_stale(state, owner, war_score_part::blockades);
 		}
 	}
+}
 
-	return total;
+// events mark the parts of the war scores they change stale as they happen, except for the point values, overseas status and blockades of
+// provinces, which are compared against what the cache last saw here; stale parts are then recounted, one war at a time
+void update_war_scores(sys::state& state) {
+	if(state.world.war_size() == 0)
+		return;
+
+	auto& md = state.military_definitions;
+	if(md.war_score_province_points.size() < size_t(state.world.province_size())) {
+		md.war_score_province_points.resize(state.world.province_size(), -1);
+		md.war_score_province_flags.resize(state.world.province_size(), uint8_t(0));
+	}
+	province::for_each_land_province(state, [&](dcon::province_id p) {
+		auto owner = state.world.province_get_nation_from_province_ownership(p);
+		if(!owner || !state.world.nation_get_is_at_war(owner))
+			return;
+		auto points = province_point_cost(state, p, owner);
+		auto flags = uint8_t((province::is_overseas(state, p) ? war_score_province_overseas : 0)
+			| (state.world.province_get_is_blockaded(p) ? war_score_province_blockaded : 0));
+		if(md.war_score_province_points[p.index()] != points || md.war_score_province_flags[p.index()] != flags) {
+			md.war_score_province_points[p.index()] = points;
+			md.war_score_province_flags[p.index()] = flags;
+			mark_war_scores_stale(state, owner, war_score_part::occupation | war_score_part::blockades);
+		}
+	});
+
+#ifndef NDEBUG
+	// whatever is still marked current must not have changed without an event saying so
+	for(auto w : state.world.in_war) {
+		if(war_score_part_is_current(state, w, war_score_part::attacker_occupation)) {
+			auto counted = count_occupation_points(state, w, w.get_primary_attacker());
+			assert(counted.total == w.get_attacker_points() && counted.occupied == w.get_attacker_occupied_points());
+		}
+		if(war_score_part_is_current(state, w, war_score_part::defender_occupation)) {
+			auto counted = count_occupation_points(state, w, w.get_primary_defender());
+			assert(counted.total == w.get_defender_points() && counted.occupied == w.get_defender_occupied_points());
+		}
+		if(war_score_part_is_current(state, w, war_score_part::attacker_blockades)) {
+			assert(count_blockaded_ports(state, w, w.get_primary_attacker(), war_role::defender) == w.get_attacker_blockaded_ports());
+		}
+		if(war_score_part_is_current(state, w, war_score_part::defender_blockades)) {
+			assert(count_blockaded_ports(state, w, w.get_primary_defender(), war_role::attacker) == w.get_defender_blockaded_ports());
+		}
+		if(war_score_part_is_current(state, w, war_score_part::war_goals)) {
+			assert(count_war_goal_score(state, w) == w.get_war_goal_score());
+		}
+	}
+#endif
+
+	concurrency::parallel_for(uint32_t(0), state.world.war_size(), [&](uint32_t i) {
+		dcon::war_id w{ dcon::war_id::value_base_t(i) };
+		if(!state.world.war_is_valid(w))
+			return;
+		auto current = state.world.war_get_war_score_current_parts(w);
+		if(current == war_score_part::all)
+			return;
+		if((current & war_score_part::attacker_occupation) == 0) {
+			auto counted = count_occupation_points(state, w, state.world.war_get_primary_attacker(w));
+			state.world.war_set_attacker_points(w, counted.total);
+			state.world.war_set_attacker_occupied_points(w, counted.occupied);
+		}
+		if((current & war_score_part::defender_occupation) == 0) {
+			auto counted = count_occupation_points(state, w, state.world.war_get_primary_defender(w));
+			state.world.war_set_defender_points(w, counted.total);
+			state.world.war_set_defender_occupied_points(w, counted.occupied);
+		}
+		if((current & war_score_part::attacker_blockades) == 0) {
+			state.world.war_set_attacker_blockaded_ports(w, count_blockaded_ports(state, w, state.world.war_get_primary_attacker(w), war_role::defender));
+		}
+		if((current & war_score_part::defender_blockades) == 0) {
+			state.world.war_set_defender_blockaded_ports(w, count_blockaded_ports(state, w, state.world.war_get_primary_defender(w), war_role::attacker));
+		}
+		if((current & war_score_part::war_goals) == 0) {
+			state.world.war_set_war_goal_score(w, count_war_goal_score(state, w));
+		}
+		state.world.war_set_war_score_current_parts(w, war_score_part::all);
+	});
 }
 
 float directed_warscore(
@@ -4912,18 +5256,20 @@ float effective_military_distance(sys::state& state, dcon::nation_id as_nation,
 
 float movement_time_from_to(sys::state& state, dcon::army_id a, dcon::province_id from, dcon::province_id to) {
 	auto controller = state.world.army_get_controller_from_army_control(a);
-	float effective_distance = effective_military_distance(state, controller, from, to);
-
+	return movement_time_for_distance(state, a, effective_military_distance(state, controller, from, to));
+}
+float movement_time_from_to(sys::state& state, dcon::navy_id n, dcon::province_id from, dcon::province_id to) {
+	auto controller = state.world.navy_get_controller_from_navy_control(n);
+	return movement_time_for_distance(state, n, effective_military_distance(state, controller, from, to));
+}
+float movement_time_for_distance(sys::state& state, dcon::army_id a, float effective_distance) {
 	float effective_speed = effective_army_speed(state, a);
 
 	float days = effective_speed > 0.0f ? effective_distance / (effective_speed * state.defines.alice_army_marching_hours_per_day) : 50;
 	assert(days > 0.0f);
 	return days;
 }
-float movement_time_from_to(sys::state& state, dcon::navy_id n, dcon::province_id from, dcon::province_id to) {
-	auto controller = state.world.navy_get_controller_from_navy_control(n);
-	float effective_distance = effective_military_distance(state, controller, from, to);
-
+float movement_time_for_distance(sys::state& state, dcon::navy_id n, float effective_distance) {
 	float effective_speed = effective_navy_speed(state, n);
 
 	float days = effective_speed > 0.0f ? effective_distance / (effective_speed * state.defines.alice_navy_sailing_hours_per_day) : 50;
@@ -4931,22 +5277,19 @@ float movement_time_from_to(sys::state& state, dcon::navy_id n, dcon::province_i
 	return days;
 }
 
-arrival_time_info_raw arrival_time_to_in_days(sys::state& state, dcon::army_id a, dcon::province_id to, dcon::province_id from) {
-	auto float_days = movement_time_from_to(state, a, from, to);
-
+arrival_time_info_raw arrival_time_in_days(float float_days) {
 	float travel_days = std::ceil(float_days);
 	float extra_days = travel_days - float_days;
 
 	return arrival_time_info_raw{ .travel_days = int32_t(travel_days), .unused_travel_days = extra_days };
 }
 
-arrival_time_info_raw arrival_time_to_in_days(sys::state& state, dcon::navy_id n, dcon::province_id to, dcon::province_id from) {
-	auto float_days = movement_time_from_to(state, n, from, to);
-
-	float travel_days = std::ceil(float_days);
-	float extra_days = travel_days - float_days;
+arrival_time_info_raw arrival_time_to_in_days(sys::state& state, dcon::army_id a, dcon::province_id to, dcon::province_id from) {
+	return arrival_time_in_days(movement_time_from_to(state, a, from, to));
+}
 
-	return arrival_time_info_raw{ .travel_days = int32_t(travel_days), .unused_travel_days = extra_days };
+arrival_time_info_raw arrival_time_to_in_days(sys::state& state, dcon::navy_id n, dcon::province_id to, dcon::province_id from) {
+	return arrival_time_in_days(movement_time_from_to(state, n, from, to));
 }
 
 arrival_time_info arrival_time_to(sys::state& state, dcon::army_id a, dcon::province_id p) {
@@ -5116,6 +5459,7 @@ void army_arrives_in_province(sys::state& state, dcon::army_id a, dcon::province
 
 
 	state.world.army_set_location_from_army_location(a, p);
+	update_army_supply_weight(state, a);
 	auto regs = state.world.army_get_army_membership(a);
 	if(!state.world.army_get_black_flag(a) && !state.world.army_get_is_retreating(a) && regs.begin() != regs.end()) {
 		auto owner_nation = state.world.army_get_controller_from_army_control(a);
@@ -5297,6 +5641,7 @@ void add_navy_to_battle(sys::state& state, dcon::navy_id n, dcon::naval_battle_i
 	}
 
 	state.world.navy_set_battle_from_navy_battle_participation(n, b);
+	mark_port_war_scores_stale(state, state.world.navy_get_location_from_navy_location(n));
 
 	update_battle_leaders(state, b);
 }
@@ -5756,6 +6101,7 @@ void delete_regiment_safe_wrapper(sys::state& state, dcon::regiment_id reg) {
 			}
 			
 		}
+		queue_for_gc(state, army);
 		state.world.delete_regiment(reg);
 	}
 }
@@ -5826,6 +6172,8 @@ void cleanup_navy(sys::state& state, dcon::navy_id n) {
 	auto b = state.world.navy_get_battle_from_navy_battle_participation(n);
 
 	state.world.navy_set_is_retreating(n, true); // prevents navy from re-entering battles
+	state.path_cache.fleet_moved(state.world.navy_get_location_from_navy_location(n));
+	mark_port_war_scores_stale(state, state.world.navy_get_location_from_navy_location(n));
 	if(b && controller) {
 		bool should_end = true;
 		// TODO: Do they have to be in common war or can they just be "hostile against"?
@@ -5918,6 +6266,7 @@ void end_battle(sys::state& state, dcon::land_battle_id b, battle_result result,
 		state.world.army_set_controller_from_army_control(a, dcon::nation_id{});
 		state.world.army_set_controller_from_army_rebel_control(a, dcon::rebel_faction_id{});
 		state.world.army_set_is_retreating(a, true);
+		queue_for_gc(state, a);
 		};
 
 	auto a_nation = get_land_battle_lead_attacker(state, b);
@@ -6313,6 +6662,7 @@ void end_battle(sys::state& state, dcon::naval_battle_id b, battle_result result
 		}
 	}
 
+	mark_port_war_scores_stale(state, location); // the navies which are left stop being in a battle
 	state.world.delete_naval_battle(b);
 }
 
@@ -6381,6 +6731,7 @@ dcon::nation_id tech_nation_for_army(const sys::state& state, dcon::army_id army
 void delete_ship_safe(sys::state& state, dcon::ship_id ship) {
 	auto navy = state.world.ship_get_navy_from_navy_membership(ship);
 	assert(navy);
+	queue_for_gc(state, navy);
 	auto battle = state.world.navy_get_battle_from_navy_battle_participation(navy);
 	if(battle) {
 		auto slots = state.world.naval_battle_get_slots(battle);
@@ -6552,15 +6903,8 @@ float sum_army_weight(sys::state& state, const std::vector<dcon::army_id>& armie
 }
 
 float local_army_weight(sys::state& state, dcon::province_id prov) {
-	float total_army_weight = 0;
-	for(auto ar : state.world.province_get_army_location(prov)) {
-		if(ar.get_army().get_black_flag() == false && ar.get_army().get_is_retreating() == false) {
-			for(auto rg : ar.get_army().get_army_membership()) {
-				total_army_weight += (state.defines.pop_size_per_regiment / 1000.0f) * rg.get_regiment().get_strength();
-			}
-		}
-	}
-	return total_army_weight;
+	assert(size_t(prov.index()) < state.military_definitions.supply_army_weight.size());
+	return state.military_definitions.supply_army_weight[prov.index()];
 }
 float local_army_weight_max(sys::state& state, dcon::province_id prov) {
 	float total_army_weight = 0;
@@ -6575,6 +6919,8 @@ float local_army_weight_max(sys::state& state, dcon::province_id prov) {
 }
 float local_enemy_army_weight_max(sys::state& state, dcon::province_id prov, dcon::nation_id nation) {
 	float total_army_weight = 0;
+	if(!state.world.nation_get_is_at_war(nation))
+		return total_army_weight;
 	for(auto ar : state.world.province_get_army_location(prov)) {
 		if(
 			ar.get_army().get_black_flag() == false
@@ -6620,25 +6966,91 @@ float relative_attrition_amount(sys::state& state, dcon::army_id a, dcon::provin
 		logic will be adjusted to deal damage relatively to current regiment size
 	*/
 
+	auto& md = state.military_definitions;
 	float total_army_weight = local_army_weight(state, prov) + additional_army_weight;
 
-	auto supply_limit = supply_limit_in_province(state, army_controller, prov);
+	// supply_limit_in_province, with the province term read from the fields
+	auto national_supply_lim = (army_controller.get_modifier_values(sys::national_mod_offsets::supply_limit) + 1.0f);
+	auto supply_limit = std::max(int32_t(md.supply_limit_base[prov.index()] * supply_class_multiplier[uint8_t(supply_class_in_province(state, army_controller, prov))] * national_supply_lim), 0);
 	auto attrition_mods = std::max( 1.0f + army_controller.get_modifier_values(sys::national_mod_offsets::land_attrition) + state.world.province_get_modifier_values(prov, sys::provincial_mod_offsets::attrition), 0.0f);
 
-	float hostile_fort = state.world.province_get_building_level(prov, uint8_t(economy::province_building_type::fort));
-
-	auto max_attrition = std::max(0.f, state.world.province_get_modifier_values(prov, sys::provincial_mod_offsets::max_attrition));
-
+	auto max_attrition = md.supply_max_attrition[prov.index()];
 	// US101AC3 Forts increase hostile siege attrition by state.defines.alice_fort_siege_attrition_per_level per level
-	float siege_attrition = 0.0f;
-	if(state.world.province_get_siege_progress(prov) > 0.f) {
-		siege_attrition = state.defines.siege_attrition + hostile_fort * state.defines.alice_fort_siege_attrition_per_level;
-	}
+	auto siege_attrition = md.supply_siege_attrition[prov.index()];
 
 	// Multiplying army weight by local attrition modifier (often coming from terrain) wasn't a correct approach
 	auto value = std::clamp((total_army_weight - supply_limit) * attrition_mods, 0.0f, max_attrition) + siege_attrition;
 	return std::min(1.f, value * 0.01f);
 }
+
+namespace {
+// what a counts for towards local_army_weight where it stands
+float army_supply_weight(sys::state& state, dcon::army_id a) {
+	float total_army_weight = 0;
+	if(state.world.army_get_black_flag(a) == false && state.world.army_get_is_retreating(a) == false) {
+		for(auto rg : state.world.army_get_army_membership(a)) {
+			total_army_weight += (state.defines.pop_size_per_regiment / 1000.0f) * rg.get_regiment().get_strength();
+		}
+	}
+	return total_army_weight;
+}
+}
+
+void update_supply_fields(sys::state& state) {
+	auto& md = state.military_definitions;
+	auto province_count = state.world.province_size();
+	md.supply_army_weight.resize(province_count);
+	md.supply_limit_base.resize(province_count);
+	md.supply_max_attrition.resize(province_count);
+	md.supply_siege_attrition.resize(province_count);
+	md.supply_weight_of_army.assign(state.world.army_size(), 0.0f);
+	md.supply_weight_location.assign(state.world.army_size(), dcon::province_id{});
+
+	concurrency::parallel_for(uint32_t(0), province_count, [&](uint32_t i) {
+		dcon::province_id prov{ dcon::province_id::value_base_t(i) };
+
+		// summed in the same order as a count of the whole province, so that a refill gives the weight such a count would
+		float total_army_weight = 0;
+		for(auto ar : state.world.province_get_army_location(prov)) {
+			float army_weight = 0;
+			if(ar.get_army().get_black_flag() == false && ar.get_army().get_is_retreating() == false) {
+				for(auto rg : ar.get_army().get_army_membership()) {
+					auto w = (state.defines.pop_size_per_regiment / 1000.0f) * rg.get_regiment().get_strength();
+					total_army_weight += w;
+					army_weight += w;
+				}
+			}
+			md.supply_weight_of_army[ar.get_army().id.index()] = army_weight;
+			md.supply_weight_location[ar.get_army().id.index()] = prov;
+		}
+		md.supply_army_weight[i] = total_army_weight;
+
+		md.supply_limit_base[i] = state.world.province_get_modifier_values(prov, sys::provincial_mod_offsets::supply_limit) + 1.0f;
+		md.supply_max_attrition[i] = std::max(0.f, state.world.province_get_modifier_values(prov, sys::provincial_mod_offsets::max_attrition));
+		float hostile_fort = state.world.province_get_building_level(prov, uint8_t(economy::province_building_type::fort));
+		md.supply_siege_attrition[i] = state.world.province_get_siege_progress(prov) > 0.f
+			? state.defines.siege_attrition + hostile_fort * state.defines.alice_fort_siege_attrition_per_level
+			: 0.0f;
+	});
+}
+
+void update_army_supply_weight(sys::state& state, dcon::army_id a) {
+	auto& md = state.military_definitions;
+	if(size_t(a.index()) >= md.supply_weight_of_army.size()) {
+		return; // created since the last update_supply_fields, which will count it
+	}
+	if(auto counted_in = md.supply_weight_location[a.index()]; counted_in) {
+		md.supply_army_weight[counted_in.index()] -= md.supply_weight_of_army[a.index()];
+	}
+	auto prov = state.world.army_get_location_from_army_location(a);
+	auto weight = prov ? army_supply_weight(state, a) : 0.0f;
+	if(prov) {
+		md.supply_army_weight[prov.index()] += weight;
+	}
+	md.supply_weight_of_army[a.index()] = weight;
+	md.supply_weight_location[a.index()] = prov;
+}
+
 float attrition_amount(sys::state& state, dcon::navy_id a) {
 	return relative_attrition_amount(state, a, state.world.navy_get_location_from_navy_location(a));
 }
@@ -6655,6 +7067,8 @@ void apply_attrition_to_army(sys::state& state, dcon::army_id army) {
 	for(auto rg : state.world.army_get_army_membership(army)) {
 		military::regiment_take_str_damage<military::regiment_dmg_source::attrition>(state, rg.get_regiment(), attrition_value * rg.get_regiment().get_strength());
 	}
+	// the next army in the province sees the reduced weight
+	update_army_supply_weight(state, army);
 }
 void apply_monthly_attrition_to_navy(sys::state& state, dcon::navy_id navy) {
 	auto prov = state.world.navy_get_location_from_navy_location(navy);
@@ -6673,11 +7087,13 @@ void apply_monthly_attrition_to_navy(sys::state& state, dcon::navy_id navy) {
 }
 
 void apply_attrition(sys::state& state) {
+	update_supply_fields(state);
 
 	concurrency::parallel_for(uint32_t(0), state.world.province_size(), [&](int32_t i) {
 		dcon::province_id prov{ dcon::province_id::value_base_t(i) };
 		assert(state.world.province_is_valid(prov));
 
+		// only the armies of prov update the weight of prov, so the provinces can go in parallel
 		for(auto ar : state.world.province_get_army_location(prov)) {
 			apply_attrition_to_army(state, ar.get_army());
 		}
@@ -6688,47 +7104,83 @@ void apply_attrition(sys::state& state) {
 }
 
 void apply_regiment_damage(sys::state& state) {
+	// the pop losses and the war exhaustion of every regiment depend only on its own pending damage, its army and nation values
+	// that do not change below, so they are computed over the regiment columns first
+	static auto combat_damage = ve::vectorizable_buffer<float, dcon::regiment_id>(uint32_t(1));
+	static auto attrition_damage = ve::vectorizable_buffer<float, dcon::regiment_id>(uint32_t(1));
+	static auto combat_pop_loss = ve::vectorizable_buffer<float, dcon::regiment_id>(uint32_t(1));
+	static auto attrition_pop_loss = ve::vectorizable_buffer<float, dcon::regiment_id>(uint32_t(1));
+	static auto combat_war_ex = ve::vectorizable_buffer<float, dcon::regiment_id>(uint32_t(1));
+	static auto attrition_war_ex = ve::vectorizable_buffer<float, dcon::regiment_id>(uint32_t(1));
+	{
+		static uint32_t old_count = 1;
+		auto new_count = state.world.regiment_size();
+		if(new_count > old_count) {
+			combat_damage = state.world.regiment_make_vectorizable_float_buffer();
+			attrition_damage = state.world.regiment_make_vectorizable_float_buffer();
+			combat_pop_loss = state.world.regiment_make_vectorizable_float_buffer();
+			attrition_pop_loss = state.world.regiment_make_vectorizable_float_buffer();
+			combat_war_ex = state.world.regiment_make_vectorizable_float_buffer();
+			attrition_war_ex = state.world.regiment_make_vectorizable_float_buffer();
+			old_count = new_count;
+		}
+	}
+
+	state.world.execute_parallel_over_regiment([&](auto ids) {
+		auto pending_combat_damage = state.world.regiment_get_pending_combat_damage(ids);
+		auto pending_attrition_damage = state.world.regiment_get_pending_attrition_damage(ids);
+		auto in_nation = state.world.army_get_controller_from_army_control(state.world.regiment_get_army_from_army_membership(ids));
+		auto damage_modifier = ve::apply([&](dcon::regiment_id r) {
+			return std::max(state.defines.soldier_to_pop_damage - state.world.nation_get_modifier_values(tech_nation_for_regiment(state, r), sys::national_mod_offsets::soldier_to_pop_loss), 0.0f);
+		}, ids);
+		auto recruitable = ve::max(1.0f, ve::to_float(state.world.nation_get_recruitable_regiments(in_nation)));
+
+		// same operations in the same order as get_war_exhaustion_from_land_losses and the scalar pop loss
+		combat_damage.set(ids, pending_combat_damage);
+		attrition_damage.set(ids, pending_attrition_damage);
+		combat_pop_loss.set(ids, state.defines.pop_size_per_regiment * pending_combat_damage * damage_modifier);
+		attrition_pop_loss.set(ids, state.defines.pop_size_per_regiment * pending_attrition_damage * damage_modifier);
+		combat_war_ex.set(ids, state.defines.combatloss_war_exhaustion * pending_combat_damage / recruitable);
+		attrition_war_ex.set(ids, state.defines.alice_attrition_war_exhaustion * pending_attrition_damage / recruitable);
+
+		state.world.regiment_set_pending_combat_damage(ids, ve::select(pending_combat_damage > 0.0f, 0.0f, pending_combat_damage));
+		state.world.regiment_set_pending_attrition_damage(ids, ve::select(pending_attrition_damage > 0.0f, 0.0f, pending_attrition_damage));
+	});
+
+	// war exhaustion is capped after every addition, so the additions are recorded in the order of the loop below
+	// and applied per nation afterwards
+	struct war_exhaustion_addition {
+		dcon::nation_id n;
+		float amount = 0.0f;
+	};
+	static std::vector<war_exhaustion_addition> additions;
+	additions.clear();
+
+	// pops are shared between regiments and may be deleted or replaced along the way, so losses and replacements
+	// are applied in the original order
 	for(uint32_t i = state.world.regiment_size(); i-- > 0;) {
 		dcon::regiment_id s{ dcon::regiment_id::value_base_t(i) };
 		if(state.world.regiment_is_valid(s)) {
-			auto& pending_combat_damage = state.world.regiment_get_pending_combat_damage(s);
-			auto& pending_attrition_damage = state.world.regiment_get_pending_attrition_damage(s);
-			auto& current_strength = state.world.regiment_get_strength(s);
 			auto backing_pop = state.world.regiment_get_pop_from_regiment_source(s);
 			auto in_nation = state.world.army_get_controller_from_army_control(state.world.regiment_get_army_from_army_membership(s));
 
-		
-			if(pending_combat_damage > 0) {
-				auto tech_nation = tech_nation_for_regiment(state, s);
+			if(combat_damage.get(s) > 0) {
 				if(bool(in_nation)) {
-					// give war exhaustion for the losses
-					auto& current_war_ex = state.world.nation_get_war_exhaustion(in_nation);
-					auto extra_war_ex = get_war_exhaustion_from_land_losses<regiment_dmg_source::combat>(state, pending_combat_damage, in_nation);
-					state.world.nation_set_war_exhaustion(in_nation, std::min(current_war_ex + extra_war_ex, state.world.nation_get_modifier_values(in_nation, sys::national_mod_offsets::max_war_exhaustion)));
+					additions.push_back(war_exhaustion_addition{ in_nation, combat_war_ex.get(s) });
 				}
 				if(backing_pop) {
-					auto& psize = state.world.pop_get_size(backing_pop);
-					float damage_modifier = std::max(state.defines.soldier_to_pop_damage - state.world.nation_get_modifier_values(tech_nation, sys::national_mod_offsets::soldier_to_pop_loss), 0.0f);
-					state.world.pop_set_size(backing_pop, psize - state.defines.pop_size_per_regiment * pending_combat_damage * damage_modifier);
+					state.world.pop_set_size(backing_pop, state.world.pop_get_size(backing_pop) - combat_pop_loss.get(s));
 				}
-				state.world.regiment_set_pending_combat_damage(s, 0.0f);
 			}
-			if(pending_attrition_damage > 0) {
-				auto tech_nation = tech_nation_for_regiment(state, s);
+			if(attrition_damage.get(s) > 0) {
 				if(bool(in_nation)) {
-					// give war exhaustion for the losses
-					auto& current_war_ex = state.world.nation_get_war_exhaustion(in_nation);
-					auto extra_war_ex = get_war_exhaustion_from_land_losses<regiment_dmg_source::attrition>(state, pending_attrition_damage, in_nation);
-					state.world.nation_set_war_exhaustion(in_nation, std::min(current_war_ex + extra_war_ex, state.world.nation_get_modifier_values(in_nation, sys::national_mod_offsets::max_war_exhaustion)));
+					additions.push_back(war_exhaustion_addition{ in_nation, attrition_war_ex.get(s) });
 				}
 				if(backing_pop) {
-					auto& psize = state.world.pop_get_size(backing_pop);
-					float damage_modifier = std::max(state.defines.soldier_to_pop_damage - state.world.nation_get_modifier_values(tech_nation, sys::national_mod_offsets::soldier_to_pop_loss), 0.0f);
-					state.world.pop_set_size(backing_pop, psize - state.defines.pop_size_per_regiment * pending_attrition_damage * damage_modifier);
+					state.world.pop_set_size(backing_pop, state.world.pop_get_size(backing_pop) - attrition_pop_loss.get(s));
 				}
-				state.world.regiment_set_pending_attrition_damage(s, 0.0f);
 			}
-			
+
 			auto psize = state.world.pop_get_size(backing_pop);
 			// Check if the regiment has no attached pop without having been deleted (from demotion, migration etc).
 			// The find soldier function cannot find a pop for an invalid nation id (rebel armies) so it will take care of that
@@ -6755,6 +7207,28 @@ void apply_regiment_damage(sys::state& state) {
 			}
 		}
 	}
+
+	// the sort keeps the order of the additions of each nation
+	std::stable_sort(additions.begin(), additions.end(), [](war_exhaustion_addition const& a, war_exhaustion_addition const& b) {
+		return a.n.index() < b.n.index();
+	});
+	static std::vector<uint32_t> nation_starts;
+	nation_starts.clear();
+	for(uint32_t i = 0; i < uint32_t(additions.size()); ++i) {
+		if(i == 0 || additions[i].n != additions[i - 1].n)
+			nation_starts.push_back(i);
+	}
+	nation_starts.push_back(uint32_t(additions.size()));
+
+	concurrency::parallel_for(uint32_t(0), uint32_t(nation_starts.size() - 1), [&](uint32_t j) {
+		auto n = additions[nation_starts[j]].n;
+		auto max_war_ex = state.world.nation_get_modifier_values(n, sys::national_mod_offsets::max_war_exhaustion);
+		auto war_ex = state.world.nation_get_war_exhaustion(n);
+		for(uint32_t i = nation_starts[j]; i < nation_starts[j + 1]; ++i) {
+			war_ex = std::min(war_ex + additions[i].amount, max_war_ex);
+		}
+		state.world.nation_set_war_exhaustion(n, war_ex);
+	});
 }
 
 uint16_t unit_type_to_battle_regiment_type(unit_type utype) {
@@ -7616,6 +8090,7 @@ int16_t get_naval_battle_target(sys::state& state, const ship_in_battle& ship, d
 
 }
 
+// runs inside the parallel pass of update_land_battles: the messages are staged, and posted once the pass ends
 void notify_on_new_land_battle(sys::state& state, dcon::land_battle_id battle, dcon::nation_id nation_as) {
 	war_role battle_role = war_role::none;
 	for(auto n : state.world.land_battle_get_army_battle_participation(battle)) {
@@ -7639,7 +8114,7 @@ void notify_on_new_land_battle(sys::state& state, dcon::land_battle_id battle, d
 	dcon::nation_id enemy_nation = (battle_role == war_role::attacker) ? get_land_battle_lead_defender(state, battle) : get_land_battle_lead_attacker(state, battle);
 	bool show_notification = ((enemy_nation == dcon::nation_id{ } && state.user_settings.notify_rebels_defeat) || enemy_nation != dcon::nation_id{ });
 	if(battle_role == war_role::attacker && show_notification) {
-		notification::post(state, notification::message{
+		state.staged_messages.stage(uint32_t(battle.index()), notification::message{
 			.body = [=](sys::state& state, text::layout_base& layout) {
 
 				auto identity = state.world.nation_get_identity_from_identity_holder(nation_as);
@@ -7668,7 +8143,7 @@ void notify_on_new_land_battle(sys::state& state, dcon::land_battle_id battle, d
 	}
 	// notify if defending
 	else if(battle_role == war_role::defender && show_notification) {
-		notification::post(state, notification::message{
+		state.staged_messages.stage(uint32_t(battle.index()), notification::message{
 			.body = [=](sys::state& state, text::layout_base& layout) {
 
 				auto identity = state.world.nation_get_identity_from_identity_holder(nation_as);
@@ -7840,6 +8315,7 @@ void update_land_battles(sys::state& state) {
 			return;
 		}
 	});
+	state.staged_messages.flush(state); // new battle notifications, by battle
 
 	for(auto i = isize; i-- > 0;) {
 		dcon::land_battle_id b{ dcon::land_battle_id::value_base_t(i) };
@@ -8126,6 +8602,7 @@ void single_ship_start_retreat(sys::state& state, ship_in_battle& ship, dcon::na
 }
 
 
+// runs inside the parallel pass of update_naval_battles: the messages are staged, and posted once the pass ends
 void notify_on_new_naval_battle(sys::state& state, dcon::naval_battle_id battle, dcon::nation_id nation_as) {
 	war_role battle_role = war_role::none;
 	for(auto n : state.world.naval_battle_get_navy_battle_participation(battle)) {
@@ -8148,7 +8625,7 @@ void notify_on_new_naval_battle(sys::state& state, dcon::naval_battle_id battle,
 	auto location = state.world.naval_battle_get_location_from_naval_battle_location(battle);
 	// notify if attacking
 	if(battle_role == war_role::attacker) {
-		notification::post(state, notification::message{
+		state.staged_messages.stage(uint32_t(battle.index()), notification::message{
 			.body = [=](sys::state& state, text::layout_base& layout) {
 
 				auto identity = state.world.nation_get_identity_from_identity_holder(nation_as);
@@ -8179,7 +8656,7 @@ void notify_on_new_naval_battle(sys::state& state, dcon::naval_battle_id battle,
 	}
 	// notify if defending
 	else if(battle_role == war_role::defender) {
-		notification::post(state, notification::message{
+		state.staged_messages.stage(uint32_t(battle.index()), notification::message{
 			.body = [=](sys::state& state, text::layout_base& layout) {
 
 				auto identity = state.world.nation_get_identity_from_identity_holder(nation_as);
@@ -8581,6 +9058,7 @@ void update_naval_battles(sys::state& state) {
 			return;
 		}
 	});
+	state.staged_messages.flush(state); // new battle notifications, by battle
 
 
 	for(auto i = isize; i-- > 0;) {
@@ -8635,6 +9113,10 @@ void navy_arrives_in_province(sys::state& state, dcon::navy_id n, dcon::province
 	assert(!state.world.navy_get_battle_from_navy_battle_participation(n));
 
 
+	state.path_cache.fleet_moved(state.world.navy_get_location_from_navy_location(n));
+	state.path_cache.fleet_moved(p);
+	mark_port_war_scores_stale(state, state.world.navy_get_location_from_navy_location(n));
+	mark_port_war_scores_stale(state, p);
 	state.world.navy_set_location_from_navy_location(n, p);
 	if(p.index() < state.province_definitions.first_sea_province.index()) {
 		state.world.navy_set_months_outside_naval_range(n, uint8_t(0));
@@ -8709,9 +9191,79 @@ void navy_arrives_in_province(sys::state& state, dcon::navy_id n, dcon::province
 	}
 }
 
+// armies that are neither moving nor following a special order do nothing in update_movement, which skips them before reading their path
+bool army_has_movement_work(sys::state& state, dcon::army_id a) {
+	if(!state.world.army_is_valid(a))
+		return false;
+	if(state.world.army_get_arrival_time(a) != sys::date{})
+		return true;
+	auto order = military::special_army_order(state.world.army_get_special_order(a));
+	return order == military::special_army_order::strategic_redeployment
+		|| (order == military::special_army_order::move_to_siege && state.world.army_get_path(a).size() > 0);
+}
+
+namespace {
+// what update_movement needs to know about a unit arriving today which depends only on the map, the control of provinces, diplomacy and, for armies,
+// the fleets, none of which the arrivals of the same kind of unit change; it is found for every arriving unit in parallel before any of them moves
+// the arrivals are then applied serially in unit order, as before, and use these values only while the unit still goes from and to the same provinces
+struct arrival_intent {
+	dcon::province_id from;
+	dcon::province_id dest;
+	dcon::province_id next_dest; // the step after dest, if there is one
+	float next_distance = 0.0f; // effective_military_distance from dest to next_dest
+	bool arrives = false;
+	bool has_access = false; // has_access_to_province for an army, has_naval_access_to_province for a navy going ashore
+	bool crossing_blocked = false; // armies only: a strait crossing blocked by an enemy fleet or a canal held by an enemy
+};
+
+template<typename T>
+arrival_intent find_arrival_intent(sys::state& state, T unit, dcon::province_id from, dcon::nation_id controller) {
+	arrival_intent result;
+	auto path = [&]() {
+		if constexpr(std::is_same_v<T, dcon::army_id>)
+			return state.world.army_get_path(unit);
+		else
+			return state.world.navy_get_path(unit);
+	}();
+	if(path.size() == 0)
+		return result;
+
+	result.arrives = true;
+	result.from = from;
+	result.dest = path.at(path.size() - 1);
+	if(result.dest.index() < state.province_definitions.first_sea_province.index()) {
+		if constexpr(std::is_same_v<T, dcon::army_id>) {
+			result.has_access = province::has_access_to_province(state, controller, result.dest);
+			auto adj = state.world.get_province_adjacency_by_province_pair(result.dest, from);
+			result.crossing_blocked = (state.world.province_adjacency_get_type(adj) & province::border::non_adjacent_bit) != 0
+				&& province::is_crossing_blocked(state, controller, from, result.dest);
+		} else {
+			result.has_access = province::has_naval_access_to_province(state, controller, result.dest);
+		}
+	}
+	if(path.size() > 1) {
+		result.next_dest = path.at(path.size() - 2);
+		result.next_distance = effective_military_distance(state, controller, result.dest, result.next_dest);
+	}
+	return result;
+}
+}
+
 void update_movement(sys::state& state) {
+	// arrival attrition reads the supply fields, which sieges may have changed since the end of the last tick
+	update_supply_fields(state);
+
+	std::pmr::vector<arrival_intent> army_intents(state.world.army_size(), &state.tick_arena);
+	concurrency::parallel_for(uint32_t(0), state.world.army_size(), [&](uint32_t i) {
+		dcon::army_id a{ dcon::army_id::value_base_t(i) };
+		if(state.world.army_is_valid(a) && state.world.army_get_arrival_time(a) == state.current_date && !state.world.army_get_battle_from_army_battle_participation(a))
+			army_intents[i] = find_arrival_intent(state, a, state.world.army_get_location_from_army_location(a), state.world.army_get_controller_from_army_control(a));
+	});
+
 	// Army movement
 	for(auto a : state.world.in_army) {
+		if(!army_has_movement_work(state, a))
+			continue;
 		auto arrival = a.get_arrival_time();
 		auto path = a.get_path();
 		auto from = state.world.army_get_location_from_army_location(a);
@@ -8761,6 +9313,13 @@ void update_movement(sys::state& state) {
 			auto dest = path.at(path.size() - 1);
 			path.pop_back();
 
+			arrival_intent const* intent = nullptr;
+			if(a.id.index() < int32_t(army_intents.size())) {
+				auto& found = army_intents[a.id.index()];
+				if(found.arrives && found.from == from && found.dest == dest)
+					intent = &found;
+			}
+
 			state.world.army_set_is_retreating(a, false); // can only be in the retreating state for max 1 province arrivial
 			auto adj = state.world.get_province_adjacency_by_province_pair(dest, from);
 			crossing_type crossing = get_crossing_type(state, adj);
@@ -8788,7 +9347,7 @@ void update_movement(sys::state& state) {
 					}
 					army_arrives_in_province<apply_attrition_on_arrival::yes>(state, a, dest, crossing, dcon::land_battle_id{});
 					a.set_navy_from_army_transport(dcon::navy_id{});
-				} else if(province::has_access_to_province(state, a.get_controller_from_army_control(), dest)) {
+				} else if(intent ? intent->has_access : province::has_access_to_province(state, a.get_controller_from_army_control(), dest)) {
 					if(auto n = a.get_navy_from_army_transport()) {
 						if(!n.get_battle_from_navy_battle_participation()) {
 							army_arrives_in_province<apply_attrition_on_arrival::yes>(state, a, dest, crossing, dcon::land_battle_id{});
@@ -8798,7 +9357,8 @@ void update_movement(sys::state& state) {
 						}
 					} else {
 						auto path_bits = state.world.province_adjacency_get_type(adj);
-						if((path_bits & province::border::non_adjacent_bit) != 0 && province::is_crossing_blocked(state, a.get_controller_from_army_control(), from, dest)) { // strait crossing which is blocked
+						bool crossing_blocked = intent ? intent->crossing_blocked : ((path_bits & province::border::non_adjacent_bit) != 0 && province::is_crossing_blocked(state, a.get_controller_from_army_control(), from, dest));
+						if(crossing_blocked) { // strait crossing which is blocked
 							// if the strait is blocked by the time the movement happens, stop the unit and check for enemy armies to collide with
 							stop_army_movement(state, a);
 							a.set_is_retreating(false);
@@ -8844,7 +9404,10 @@ void update_movement(sys::state& state) {
 			if(path.size() > 0) {
 				// Army was ordered chain move
 				auto next_dest = path.at(path.size() - 1);
-				update_movement_arrival_days_on_unit(state, next_dest, a.get_location_from_army_location(), a.id);
+				if(intent && a.get_location_from_army_location() == intent->dest && next_dest == intent->next_dest)
+					set_movement_arrival_days_on_unit(state, arrival_time_in_days(movement_time_for_distance(state, a, intent->next_distance)), a.id);
+				else
+					update_movement_arrival_days_on_unit(state, next_dest, a.get_location_from_army_location(), a.id);
 			} else {
 				a.set_arrival_time(sys::date{});
 				a.set_unused_travel_days(0.0f);
@@ -8860,6 +9423,7 @@ void update_movement(sys::state& state) {
 								while(regs.begin() != regs.end()) {
 									(*regs.begin()).set_army(ar.get_army());
 								}
+								queue_for_gc(state, a.id);
 								return;
 							}
 						}
@@ -8877,8 +9441,17 @@ void update_movement(sys::state& state) {
 		}
 		}
 
+	std::pmr::vector<arrival_intent> navy_intents(state.world.navy_size(), &state.tick_arena);
+	concurrency::parallel_for(uint32_t(0), state.world.navy_size(), [&](uint32_t i) {
+		dcon::navy_id n{ dcon::navy_id::value_base_t(i) };
+		if(state.world.navy_is_valid(n) && state.world.navy_get_arrival_time(n) == state.current_date && !state.world.navy_get_battle_from_navy_battle_participation(n))
+			navy_intents[i] = find_arrival_intent(state, n, state.world.navy_get_location_from_navy_location(n), state.world.navy_get_controller_from_navy_control(n));
+	});
+
 	// Navy movement
 	for(auto n : state.world.in_navy) {
+		if(n.get_arrival_time() == sys::date{}) // only the navies that are moving do anything
+			continue;
 		auto arrival = n.get_arrival_time();
 		assert(!arrival || arrival >= state.current_date);
 		if(arrival != sys::date{} && n.get_battle_from_navy_battle_participation()) {
@@ -8891,8 +9464,15 @@ void update_movement(sys::state& state) {
 			auto dest = path.at(path.size() - 1);
 			path.pop_back();
 
+			arrival_intent const* intent = nullptr;
+			if(n.id.index() < int32_t(navy_intents.size())) {
+				auto& found = navy_intents[n.id.index()];
+				if(found.arrives && found.from == from && found.dest == dest)
+					intent = &found;
+			}
+
 			if(dest.index() < state.province_definitions.first_sea_province.index()) { // land province
-				if(province::has_naval_access_to_province(state, n.get_controller_from_navy_control(), dest)) {
+				if(intent ? intent->has_access : province::has_naval_access_to_province(state, n.get_controller_from_navy_control(), dest)) {
 
 					navy_arrives_in_province(state, n, dest, dcon::naval_battle_id{ });
 
@@ -8958,12 +9538,16 @@ void update_movement(sys::state& state) {
 
 			if(path.size() > 0) {
 				auto next_dest = path.at(path.size() - 1);
-				update_movement_arrival_days_on_unit(state, next_dest, n.get_location_from_navy_location(), n.id);
+				if(intent && n.get_location_from_navy_location() == intent->dest && next_dest == intent->next_dest)
+					set_movement_arrival_days_on_unit(state, arrival_time_in_days(movement_time_for_distance(state, n, intent->next_distance)), n.id);
+				else
+					update_movement_arrival_days_on_unit(state, next_dest, n.get_location_from_navy_location(), n.id);
 			} else {
 				n.set_arrival_time(sys::date{});
 				n.set_unused_travel_days(0.0f);
 				if(n.get_is_retreating()) {
 					n.set_is_retreating(false);
+					mark_port_war_scores_stale(state, n.get_location_from_navy_location());
 				}
 				if(n.get_moving_to_merge()) {
 					n.set_moving_to_merge(false);
@@ -8978,6 +9562,7 @@ void update_movement(sys::state& state) {
 								while(a.begin() != a.end()) {
 									(*a.begin()).set_navy(ar.get_navy());
 								}
+								queue_for_gc(state, n.id);
 								return;
 							}
 						}
@@ -8990,7 +9575,13 @@ void update_movement(sys::state& state) {
 
 template<typename T>
 void update_movement_arrival_days_on_unit(sys::state& state, dcon::province_id to, dcon::province_id from, T army) {
-	auto arrival_data = military::arrival_time_to_in_days(state, army, to, from);
+	set_movement_arrival_days_on_unit(state, military::arrival_time_to_in_days(state, army, to, from), army);
+}
+template void update_movement_arrival_days_on_unit<dcon::army_id>(sys::state& state, dcon::province_id to, dcon::province_id from, dcon::army_id army);
+template void update_movement_arrival_days_on_unit<dcon::navy_id>(sys::state& state, dcon::province_id to, dcon::province_id from, dcon::navy_id army);
+
+template<typename T>
+void set_movement_arrival_days_on_unit(sys::state& state, arrival_time_info_raw arrival_data, T army) {
 	if constexpr(std::is_same<dcon::army_id, T>()) {
 		auto& unused_travel_days = state.world.army_get_unused_travel_days(army);
 		state.world.army_set_unused_travel_days(army, unused_travel_days + arrival_data.unused_travel_days);
@@ -9013,8 +9604,8 @@ void update_movement_arrival_days_on_unit(sys::state& state, dcon::province_id t
 	}
 	
 }
-template void update_movement_arrival_days_on_unit<dcon::army_id>(sys::state& state, dcon::province_id to, dcon::province_id from, dcon::army_id army);
-template void update_movement_arrival_days_on_unit<dcon::navy_id>(sys::state& state, dcon::province_id to, dcon::province_id from, dcon::navy_id army);
+template void set_movement_arrival_days_on_unit<dcon::army_id>(sys::state& state, arrival_time_info_raw arrival_data, dcon::army_id army);
+template void set_movement_arrival_days_on_unit<dcon::navy_id>(sys::state& state, arrival_time_info_raw arrival_data, dcon::navy_id army);
 
 
 template<typename T>
@@ -9210,6 +9801,8 @@ void update_siege_progress(sys::state& state) {
 				// ongoing battle: do nothing
 			} else {
 				auto& progress = state.world.province_get_siege_progress(prov);
+				if(progress > 0.0f && progress <= 0.1f)
+					state.path_cache.territory_changed(state.world.province_get_nation_from_province_control(prov)); // safe paths avoid provinces under siege
 				state.world.province_set_siege_progress(prov, std::max(0.0f, progress - 0.1f));
 			}
 		} else {
@@ -9262,10 +9855,13 @@ void update_siege_progress(sys::state& state) {
 				(owner_involved ? 1.25f : (core_owner_involved ? 1.1f : 1.0f)) / (effective_fort_level * state.defines.alice_fort_siege_slowdown + 1.0f); // US101AC2 Forts reduce siege speed by alice_fort_siege_slowdown factor (0.75 by default) per level.
 
 			auto& progress = state.world.province_get_siege_progress(prov);
+			if(progress == 0.0f && siege_speed_mul * added_progress != 0.0f)
+				state.path_cache.territory_changed(state.world.province_get_nation_from_province_control(prov)); // safe paths avoid provinces under siege
 			state.world.province_set_siege_progress(prov, progress + siege_speed_mul * added_progress);
 
 			if(progress >= 1.0f) {
 				progress = 0.0f;
+				state.path_cache.territory_changed(state.world.province_get_nation_from_province_control(prov));
 
 				/*
 				The garrison returns to 100% immediately after the siege is complete and the controller changes. If your siege returns a
@@ -9299,11 +9895,27 @@ void update_siege_progress(sys::state& state) {
 		}
 	});
 
+	// all control changes of the day are applied together, in province order, and their shared follow-ups are marked once
+	static std::vector<province::controller_change> changes;
+	changes.clear();
 	province::for_each_land_province(state, [&](dcon::province_id prov) {
 		if(auto nc = new_nation_controller.get(prov); nc) {
-			province::set_province_controller(state, prov, nc);
-			eject_ships(state, prov);
+			changes.push_back(province::controller_change{ prov, nc, dcon::rebel_faction_id{ } });
+		} else if(auto nr = new_rebel_controller.get(prov); nr) {
+			changes.push_back(province::controller_change{ prov, dcon::nation_id{ }, nr });
+		}
+	});
+	if(changes.empty())
+		return;
+	province::set_province_controllers(state, changes);
 
+	// the per province consequences then see the map as it stands at the end of the day
+	for(auto& c : changes) {
+		eject_ships(state, c.province);
+	}
+	for(auto& c : changes) {
+		auto prov = c.province;
+		if(c.nation) {
 			auto cc = state.world.province_get_nation_from_province_control(prov);
 			auto oc = state.world.province_get_former_controller(prov);
 
@@ -9350,20 +9962,15 @@ void update_siege_progress(sys::state& state) {
 			*/
 			// is controler != owner ...
 			// event::fire_fixed_event(state, );
-		}
-		if(auto nr = new_rebel_controller.get(prov); nr) {
-			province::set_province_controller(state, prov, nr);
-			eject_ships(state, prov);
-
-			auto cc = state.world.province_get_nation_from_province_control(prov);
-			auto oc = state.world.province_get_former_controller(prov);
+		} else {
+			auto nr = c.rebels;
 			auto within = state.world.rebel_faction_get_ruler_from_rebellion_within(nr);
 			auto t = state.world.rebel_faction_get_type(nr);
 			if(trigger::evaluate(state, state.world.rebel_type_get_siege_won_trigger(t), trigger::to_generic(prov), trigger::to_generic(prov), trigger::to_generic(nr))) {
 				effect::execute(state, state.world.rebel_type_get_siege_won_effect(t), trigger::to_generic(prov), trigger::to_generic(prov), trigger::to_generic(nr), uint32_t(state.current_date.value), uint32_t(within.index() ^ (nr.index() << 4)));
 			}
 		}
-	});
+	}
 }
 
 void update_blackflag_status(sys::state& state, dcon::province_id p) {
@@ -9401,18 +10008,23 @@ void eject_ships(sys::state& state, dcon::province_id p) {
 
 void increase_dig_in(sys::state& state) {
 	if(state.current_date.value % int32_t(state.defines.dig_in_increase_each_days) == 0) {
-		for(auto ar : state.world.in_army) {
+		// every army only writes its own dig in
+		concurrency::parallel_for(uint32_t(0), state.world.army_size(), [&](uint32_t i) {
+			dcon::army_id id{ dcon::army_id::value_base_t(i) };
+			if(!state.world.army_is_valid(id))
+				return;
+			auto ar = fatten(state.world, id);
 			if(ar.get_is_retreating() || ar.get_black_flag() || bool(ar.get_battle_from_army_battle_participation()) ||
 					bool(ar.get_navy_from_army_transport()) || bool(ar.get_arrival_time())) {
 
-				continue;
+				return;
 			}
 			auto& current_dig_in = ar.get_dig_in();
 			if(current_dig_in <
 					int32_t(ar.get_controller_from_army_control().get_modifier_values(sys::national_mod_offsets::dig_in_cap))) {
 				ar.set_dig_in(uint8_t(current_dig_in + 1));
 			}
-		}
+		});
 	}
 }
 
@@ -9486,9 +10098,14 @@ void recover_org(sys::state& state) {
 	- Similarly, unit-max-org + (leader-prestige x defines:LEADER_PRESTIGE_TO_MAX_ORG_FACTOR) allows for maximum org.
 	*/
 
-	for(auto ar : state.world.in_army) {
+	// every unit only writes the org of its own regiments or ships, so the units are updated in parallel
+	concurrency::parallel_for(uint32_t(0), state.world.army_size(), [&](uint32_t i) {
+		dcon::army_id id{ dcon::army_id::value_base_t(i) };
+		if(!state.world.army_is_valid(id))
+			return;
+		auto ar = fatten(state.world, id);
 		if(ar.get_navy_from_army_transport() || ar.get_black_flag())
-			continue;
+			return;
 
 		auto in_nation = ar.get_controller_from_army_control();
 		auto tech_nation = in_nation ? in_nation : ar.get_controller_from_army_rebel_control().get_ruler_from_rebellion_within();
@@ -9521,12 +10138,16 @@ void recover_org(sys::state& state) {
 			auto max_org = 1.f;
 			reg.get_regiment().set_org(std::min(c_org + reg_regen, max_org));
 		}
-	}
+	});
 
 	// US17
-	for(auto ar : state.world.in_navy) {
+	concurrency::parallel_for(uint32_t(0), state.world.navy_size(), [&](uint32_t i) {
+		dcon::navy_id id{ dcon::navy_id::value_base_t(i) };
+		if(!state.world.navy_is_valid(id))
+			return;
+		auto ar = fatten(state.world, id);
 		if(ar.get_navy_battle_participation().get_battle())
-			continue;
+			return;
 
 		auto in_nation = ar.get_controller_from_navy_control();
 
@@ -9551,7 +10172,7 @@ void recover_org(sys::state& state) {
 			auto max_org = std::max(c_org, 0.25f + 0.75f * spending_level);
 			reg.get_ship().set_org(std::min(c_org + ship_regen, max_org));
 		}
-	}
+	});
 }
 // stops the unit movement completly and clears all other auxillary movement effects (arrival date, path etc)
 void stop_army_movement(sys::state& state, dcon::army_id army) {
@@ -9586,6 +10207,9 @@ bool province_has_enemy_army(sys::state& state, dcon::province_id location, dcon
 	if(armies.begin() == armies.end()) {
 		return false; // no armies present
 	}
+	if(our_nation && !state.world.nation_get_is_at_war(our_nation)) {
+		return false; // a nation at peace has no enemies: are_enemies counts rebel armies only as enemies of other rebels
+	}
 	for(auto army : armies) {
 		if(are_enemies(state, our_nation, army.get_army().get_controller_from_army_control())) {
 			return true;
@@ -9612,6 +10236,9 @@ bool province_has_enemy_fleet(sys::state& state, dcon::province_id location, dco
 	if(navies.begin() == navies.end()) {
 		return false; // no navies present
 	}
+	if(!state.world.nation_get_is_at_war(our_nation)) {
+		return false;
+	}
 	for(auto navy : state.world.province_get_navy_location(location)) {
 		if(are_at_war(state, our_nation, navy.get_navy().get_controller_from_navy_control())) {
 			// someone who we are at war with has a fleet in the province
@@ -9935,9 +10562,14 @@ and 0.1 in any other hostile province) x (national-reinforce-speed-modifier + 1)
 max possible regiments (feels like a bug to me) or 0.5 if mobilized)
 	*/
 
-	for(auto ar : state.world.in_army) {
+	// reinforcement is capped by the size of the source pop but does not draw from it, so every army only writes its own regiments
+	concurrency::parallel_for(uint32_t(0), state.world.army_size(), [&](uint32_t i) {
+		dcon::army_id id{ dcon::army_id::value_base_t(i) };
+		if(!state.world.army_is_valid(id))
+			return;
+		auto ar = fatten(state.world, id);
 		if(ar.get_navy_from_army_transport() || ar.get_is_retreating())
-			continue;
+			return;
 
 		auto in_nation = ar.get_controller_from_army_control();
 		auto combined = calculate_army_combined_reinforce<reinforcement_estimation_type::today>(state, ar);
@@ -9949,7 +10581,7 @@ max possible regiments (feels like a bug to me) or 0.5 if mobilized)
 			auto lost_xp = old_experience - (old_experience / (reinforcement / 3 + 1));
 			adjust_regiment_experience(state, in_nation.id, reg.get_regiment(), -lost_xp);
 		}
-	}
+	});
 	// reset all reinforcement buffers
 	for(auto nation : state.world.in_nation) {
 		if(bool(nation)) {
@@ -10016,7 +10648,11 @@ void repair_ships(sys::state& state) {
 	US18. A ship that is docked at a naval base is repaired (has its strength increase) by:
 maximum-strength x (technology-repair-rate + provincial-modifier-to-repair-rate + 1) x (national-reinforce-speed-modifier + 1) x navy-supplies x DEFINE:REINFORCE_SPEED
 	*/
-	for(auto n : state.world.in_navy) {
+	concurrency::parallel_for(uint32_t(0), state.world.navy_size(), [&](uint32_t i) {
+		dcon::navy_id id{ dcon::navy_id::value_base_t(i) };
+		if(!state.world.navy_is_valid(id))
+			return;
+		auto n = fatten(state.world, id);
 		auto nb_level = n.get_location_from_navy_location().get_building_level(uint8_t(economy::province_building_type::naval_base));
 		if(!n.get_arrival_time() && nb_level > 0) {
 			auto in_nation = n.get_controller_from_navy_control();
@@ -10031,7 +10667,7 @@ maximum-strength x (technology-repair-rate + provincial-modifier-to-repair-rate
 				adjust_ship_experience(state, in_nation.id, reg.get_ship(),  -lost_xp);
 			}
 		}
-	}
+	});
 	// reset all reinforcement buffers
 	for(auto nation : state.world.in_nation) {
 		if(bool(nation)) {
@@ -10183,6 +10819,7 @@ void advance_mobilizations(sys::state& state) {
 										auto new_army = fatten(state.world, state.world.create_army());
 										new_army.set_controller_from_army_control(n);
 										new_army.set_is_ai_controlled(n.get_mobilized_is_ai_controlled()); //toggle
+										military::queue_for_gc(state, new_army.id);
 
 										army_is_new = true;
 										return new_army.id;
@@ -10420,6 +11057,7 @@ void move_land_to_merge(sys::state& state, dcon::nation_id by, dcon::army_id a,
 				while(regs.begin() != regs.end()) {
 					(*regs.begin()).set_army(ar.get_army());
 				}
+				queue_for_gc(state, a);
 				return;
 			}
 		}
@@ -10470,7 +11108,7 @@ bool set_navy_path(sys::state& state, dcon::navy_id navy, std::span<const dcon::
 template<ai_path_length path_length_to_use>
 bool move_navy_ai(sys::state& state, dcon::navy_id navy, dcon::province_id destination, bool reset) {
 	if(reset || state.world.navy_get_path(navy).size() == 0) {
-		auto naval_path = province::make_naval_unit_path(state, state.world.navy_get_location_from_navy_location(navy), destination, state.world.navy_get_controller_from_navy_control(navy));
+		auto naval_path = province::cached::make_naval_unit_path(state, state.world.navy_get_location_from_navy_location(navy), destination, state.world.navy_get_controller_from_navy_control(navy));
 		if constexpr(path_length_to_use.length != 0) {
 			while(naval_path.size() > path_length_to_use.length) {
 				naval_path.erase(naval_path.begin());
@@ -10480,7 +11118,7 @@ bool move_navy_ai(sys::state& state, dcon::navy_id navy, dcon::province_id desti
 		return set_navy_path(state, navy, naval_path, reset);
 	} else {
 		auto from_prov = state.world.navy_get_path(navy).at(0);
-		auto naval_path = province::make_naval_unit_path(state, from_prov, destination, state.world.navy_get_controller_from_navy_control(navy));
+		auto naval_path = province::cached::make_naval_unit_path(state, from_prov, destination, state.world.navy_get_controller_from_navy_control(navy));
 		if constexpr(path_length_to_use.length != 0) {
 			while(naval_path.size() > path_length_to_use.length) {
 				naval_path.erase(naval_path.begin());
@@ -10572,11 +11210,12 @@ void move_navy_to_merge(sys::state& state, dcon::nation_id by, dcon::navy_id a,
 				while(regs.begin() != regs.end()) {
 					(*regs.begin()).set_navy(ar.get_navy());
 				}
+				queue_for_gc(state, a);
 				return;
 			}
 		}
 	} else {
-		auto path = province::make_naval_unit_path(state, start, dest, state.world.navy_get_controller_from_navy_control(a));
+		auto path = province::cached::make_naval_unit_path(state, start, dest, state.world.navy_get_controller_from_navy_control(a));
 		if(!path.empty()) {
 			military::set_navy_path(state, a, path);
 			state.world.navy_set_moving_to_merge(a, true);
@@ -10650,6 +11289,8 @@ void split_navy(sys::state& state, dcon::nation_id source, dcon::navy_id navy, s
 		for(auto t : ships_to_split) {
 			state.world.ship_set_navy_from_navy_membership(t, new_u);
 		}
+		queue_for_gc(state, navy);
+		queue_for_gc(state, new_u.id);
 		if constexpr(Actor == command::actor::player) {
 			if(source == state.local_player_nation) {
 				state.ui_state.invoke_on_ui_thread([](sys::state& state, ui::ui_function_argument arg) {
@@ -10724,6 +11365,8 @@ void split_army(sys::state& state, dcon::nation_id source, dcon::army_id army, s
 		for(auto t : regiments_to_split) {
 			state.world.regiment_set_army_from_army_membership(t, new_u);
 		}
+		queue_for_gc(state, army);
+		queue_for_gc(state, new_u.id);
 		if constexpr(Actor == command::actor::player) {
 			if(source == state.local_player_nation) {
 				state.ui_state.invoke_on_ui_thread([](sys::state& state, ui::ui_function_argument arg) {
@@ -43,6 +43,22 @@ inline constexpr uint32_t po_unequal_treaty = 0x08000000;
 
 } // namespace cb_flag
 
+// the parts of the primary war score of a war which are cached on the war, see update_war_scores
+// the attacker and defender parts are about the territory of the primary attacker and of the primary defender
+namespace war_score_part {
+
+inline constexpr uint8_t attacker_occupation = 0x01;
+inline constexpr uint8_t defender_occupation = 0x02;
+inline constexpr uint8_t attacker_blockades = 0x04;
+inline constexpr uint8_t defender_blockades = 0x08;
+inline constexpr uint8_t war_goals = 0x10;
+
+inline constexpr uint8_t occupation = attacker_occupation | defender_occupation;
+inline constexpr uint8_t blockades = attacker_blockades | defender_blockades;
+inline constexpr uint8_t all = occupation | blockades | war_goals;
+
+} // namespace war_score_part
+
 // The distance from one side of of the naval battle to the middle. Unit speed is cast to this distance with define:NAVAL_COMBAT_SPEED_TO_DISTANCE_FACTOR and naval_battle_speed_mult.
 // The "total" distance for both sides is double this number, as each ship will start at 100 distance from the middle (which equals to 200 distance between them)
 // the actual integer is 1000 units, which here means 100.0 with one fixed-point decimal.
@@ -193,6 +209,9 @@ dcon::unit_type_id get_best_big_ship(sys::state& state, dcon::nation_id n, bool
 bool are_enemies(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
 bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
 bool are_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
+// rebuilds the tables behind are_at_war and are_allied_in_war if war participation changed since the last call; serial code only
+void update_war_relations(sys::state& state);
+void mark_war_relations_out_of_date(sys::state& state);
 bool are_in_common_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
 void remove_from_common_allied_wars(sys::state& state, dcon::nation_id a, dcon::nation_id b);
 dcon::war_id find_war_between(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
@@ -229,6 +248,15 @@ float primary_warscore_from_occupation(sys::state& state, dcon::war_id w);
 float primary_warscore_from_battles(sys::state& state, dcon::war_id w);
 float primary_warscore_from_war_goals(sys::state& state, dcon::war_id w);
 float primary_warscore_from_blockades(sys::state& state, dcon::war_id w);
+// the cached parts of the primary war score are recounted by update_war_scores once an event marks them stale; until then the functions
+// above count a stale part directly. Serial code only
+void update_war_scores(sys::state& state);
+void mark_war_score_stale(sys::state& state, dcon::war_id w, uint8_t parts);
+// marks the given parts of the territory of n in every war where n is a primary belligerent
+void mark_war_scores_stale(sys::state& state, dcon::nation_id n, uint8_t parts);
+void mark_all_war_scores_stale(sys::state& state, uint8_t parts);
+// a navy arrived at, left, or started or stopped blockading from the sea province
+void mark_port_war_scores_stale(sys::state& state, dcon::province_id sea);
 
 // war score from the perspective of the primary nation offering peace to the secondary nation; 0 to 100
 // DO NOT use this when calculating the overall score of the war or when looking at a peace deal between primary attacker and
@@ -254,6 +282,15 @@ bool state_has_naval_base(sys::state const& state, dcon::state_instance_id si);
 uint32_t state_naval_base_level(sys::state const& state, dcon::state_instance_id si);
 uint32_t state_railroad_level(sys::state const& state, dcon::state_instance_id si);
 
+// how the supply limit of a province is scaled for a nation, by its relationship to the controller of the province
+enum class supply_class : uint8_t {
+	foreign, // none of the below
+	friendly, // controlled by the nation, its allies, rebels or a nation granting it access; one of its cores; or under siege
+	owned // owned and controlled by the nation
+};
+constexpr inline uint32_t supply_class_count = 3;
+constexpr inline float supply_class_multiplier[supply_class_count] = { 1.0f, 2.0f, 2.5f };
+supply_class supply_class_in_province(sys::state& state, dcon::nation_id n, dcon::province_id p);
 int32_t supply_limit_in_province(sys::state& state, dcon::nation_id n, dcon::province_id p);
 int32_t regiments_possible_from_pop(sys::state& state, dcon::pop_id p);
 int32_t regiments_created_from_province(sys::state& state, dcon::province_id p); // does not include mobilized regiments
@@ -401,6 +438,11 @@ float local_enemy_army_weight_max(sys::state& state, dcon::province_id prov, dco
 float attrition_amount(sys::state& state, dcon::navy_id a);
 float attrition_amount(sys::state& state, dcon::army_id a);
 float peacetime_attrition_limit(sys::state& state, dcon::nation_id n, dcon::province_id prov);
+// recounts the per province terms of army attrition, which relative_attrition_amount and local_army_weight read
+// called after loading, at the start of the daily military phases which read them and at the end of each tick
+void update_supply_fields(sys::state& state);
+// moves the weight counted for the army to the province it stands in now, as it is now; call it after the army moves or takes losses
+void update_army_supply_weight(sys::state& state, dcon::army_id a);
 
 enum class reinforcement_estimation_type {
 	today, monthly, full_supplies
@@ -419,6 +461,9 @@ float regiment_take_str_damage(sys::state& state, dcon::regiment_id reg, float v
 
 float movement_time_from_to(sys::state& state, dcon::army_id a, dcon::province_id from, dcon::province_id to);
 float movement_time_from_to(sys::state& state, dcon::navy_id n, dcon::province_id from, dcon::province_id to);
+// movement_time_from_to, with the effective_military_distance of the step already known
+float movement_time_for_distance(sys::state& state, dcon::army_id a, float effective_distance);
+float movement_time_for_distance(sys::state& state, dcon::navy_id n, float effective_distance);
 // Computes the effective military distance between two provinces by taking movement cost modifiers into account
 float effective_military_distance(sys::state& state, dcon::nation_id as_nation, dcon::province_id from, dcon::province_id to);
 // Calculates the avg movement cost modifier between two provinces as a specific nation
@@ -427,6 +472,7 @@ float get_avg_movement_cost_modifier(sys::state& state, dcon::nation_id as_natio
 float get_avg_movement_cost_modifier_unowned(sys::state& state, dcon::province_id prov_a, dcon::province_id prov_b);
 arrival_time_info arrival_time_to(sys::state& state, dcon::army_id a, dcon::province_id p);
 arrival_time_info arrival_time_to(sys::state& state, dcon::navy_id n, dcon::province_id p);
+arrival_time_info_raw arrival_time_in_days(float float_days);
 arrival_time_info_raw arrival_time_to_in_days(sys::state& state, dcon::army_id a, dcon::province_id to, dcon::province_id from);
 arrival_time_info_raw arrival_time_to_in_days(sys::state& state, dcon::navy_id n, dcon::province_id to, dcon::province_id from);
 float fractional_distance_covered(sys::state& state, dcon::army_id a);
@@ -437,6 +483,8 @@ void update_movement_arrival_days(sys::state& state, dcon::province_id to, dcon:
 
 template<typename T>
 void update_movement_arrival_days_on_unit(sys::state& state, dcon::province_id to, dcon::province_id from, T army);
+template<typename T>
+void set_movement_arrival_days_on_unit(sys::state& state, arrival_time_info_raw arrival_data, T army);
 
 
 struct naval_battle_last_retreat {
@@ -496,6 +544,7 @@ void delete_ship_safe_w_army_transport_loss(sys::state& state, dcon::ship_id shi
 battle_regiment get_regiment_at_offset_in_combat_slots(int32_t position, uint32_t max_offset, const std::array<battle_regiment, max_combat_width>& combat_slots);
 battle_regiment get_land_combat_target(const sys::state& state, dcon::regiment_id damage_dealer, int32_t position, const std::array<battle_regiment, max_combat_width>& opposing_line);
 void apply_attrition_to_army(sys::state& state, dcon::army_id army);
+void apply_monthly_attrition_to_navy(sys::state& state, dcon::navy_id navy);
 void apply_attrition(sys::state& state);
 void increase_dig_in(sys::state& state);
 economy::commodity_set get_required_supply(sys::state& state, dcon::nation_id owner, dcon::army_id army);
@@ -525,6 +574,15 @@ float unit_calculate_reinforcement(sys::state& state, dcon::ship_id reg);
 void reinforce_regiments(sys::state& state);
 void repair_ships(sys::state& state);
 void run_gc(sys::state& state);
+// queue entities which may have become stale for the next run_gc; serial code only
+void queue_for_gc(sys::state& state, dcon::army_id a);
+void queue_for_gc(sys::state& state, dcon::navy_id n);
+void queue_for_gc(sys::state& state, dcon::peace_offer_id p);
+void queue_for_gc(sys::state& state, dcon::wargoal_id w);
+void queue_units_for_gc(sys::state& state, dcon::nation_id n); // the units under its control
+void queue_units_for_gc(sys::state& state, dcon::rebel_faction_id r);
+// deletes the offer and queues its war goals, which are left without a war or an offer
+void delete_peace_offer(sys::state& state, dcon::peace_offer_id p);
 void update_blackflag_status(sys::state& state);
 void send_rebel_hunter_to_next_province(sys::state& state, dcon::army_id ar, dcon::province_id prov);
 
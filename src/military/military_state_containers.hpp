@@ -85,6 +85,41 @@ struct global_military_state {
 	dcon::unit_type_id artillery;
 
 	bool pending_blackflag_update = false;
+
+	// the answers of are_at_war and are_allied_in_war for every ordered pair of nations, rebuilt by update_war_relations
+	// row a holds one bit per nation b; both functions still check the is_at_war flags themselves
+	// any change to war participation marks the tables stale, and until the next rebuild the queries walk the wars instead
+	std::vector<uint64_t> enemies_in_war;
+	std::vector<uint64_t> allies_in_war;
+	uint32_t war_relation_nations = 0;
+	uint32_t war_relation_row_words = 0;
+	bool war_relations_out_of_date = true;
+
+	// entities which may have become stale since the last run_gc, queued by the operations that empty, orphan or end them
+	// run_gc only examines these; a full sweep is made after loading and when a crisis ends
+	std::vector<dcon::army_id> gc_armies;
+	std::vector<dcon::navy_id> gc_navies;
+	std::vector<dcon::peace_offer_id> gc_peace_offers;
+	std::vector<dcon::wargoal_id> gc_wargoals;
+	bool gc_full_sweep = true;
+	bool gc_crisis_was_active = false;
+
+	// the terms of relative_attrition_amount which depend only on the province, by province index, refilled by update_supply_fields
+	// supply_army_weight is the only count of local_army_weight: in between refills it follows the armies which arrive in a province or take
+	// attrition losses, so the weight each army adds and the province it adds it to are kept as well, by army index
+	std::vector<float> supply_army_weight;
+	std::vector<float> supply_limit_base; // province-supply-limit-modifier + 1, before the multiplier of the supply class
+	std::vector<float> supply_max_attrition;
+	std::vector<float> supply_siege_attrition;
+	std::vector<float> supply_weight_of_army;
+	std::vector<dcon::province_id> supply_weight_location;
+
+	// what the cached war scores last saw of each land province whose owner is at war, by province index
+	// the point value and the overseas status of a province change in too many places to mark them there, so update_war_scores compares
+	// them against the province and marks the owner's war scores stale when they differ; the blockade flag is compared the same way
+	// because update_blockade_status runs in parallel with other daily work
+	std::vector<int32_t> war_score_province_points;
+	std::vector<uint8_t> war_score_province_flags;
 };
 
 }
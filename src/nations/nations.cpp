@@ -114,22 +114,18 @@ void restore_state_instances(sys::state& state) {
 	});
 }
 
+// each nation counts its own relations, so the nations can be counted in parallel with the same result as a serial pass
 void restore_cached_values(sys::state& state) {
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
 
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_allies_count(ids, ve::int_vector()); });
-	state.world.for_each_diplomatic_relation([&](dcon::diplomatic_relation_id id) {
-		if(state.world.diplomatic_relation_get_are_allied(id)) {
-			auto related_nation_0 = state.world.diplomatic_relation_get_related_nations(id, 0);
-			auto& allies_count_0 = state.world.nation_get_allies_count(related_nation_0);
-			state.world.nation_set_allies_count(related_nation_0, uint16_t(allies_count_0 + uint16_t(1)));
-
-			auto related_nation_1 = state.world.diplomatic_relation_get_related_nations(id, 1);
-			auto& allies_count_1 = state.world.nation_get_allies_count(related_nation_1);
-			state.world.nation_set_allies_count(related_nation_1, uint16_t(allies_count_1 + uint16_t(1)));
+		int32_t allies = 0;
+		for(auto dr : state.world.nation_get_diplomatic_relation(n)) {
+			if(dr.get_are_allied())
+				++allies;
 		}
-	});
+		state.world.nation_set_allies_count(n, uint16_t(allies));
 
-	state.world.for_each_nation([&](dcon::nation_id n) {
 		int32_t total = 0;
 		int32_t substates_total = 0;
 		for(auto v : state.world.nation_get_overlord_as_ruler(n)) {
@@ -163,6 +159,7 @@ void restore_unsaved_values(sys::state& state) {
 			auto gp = state.world.gp_relationship_get_great_power(rel);
 			state.world.nation_set_in_sphere_of(t, gp);
 			state.trade_route_cached_values_out_of_date = true;
+			state.path_cache.invalidate();
 		}
 	});
 
@@ -174,6 +171,22 @@ void restore_unsaved_values(sys::state& state) {
 	restore_cached_values(state);
 }
 
+// the distance covered along a sea trade route path leaving from start, weighted by the movement cost of the provinces on the way
+float sea_trade_route_effective_distance(sys::state& state, dcon::province_id start, std::vector<dcon::province_id> const& path) {
+	dcon::province_id p_prev = start;
+	auto effective_distance = 0.f;
+	for(auto p_current : path) {
+		auto adj = state.world.get_province_adjacency_by_province_pair(p_prev, p_current);
+		float distance = province::distance(state, adj);
+		float sum_mods =
+			state.world.province_get_modifier_values(p_current, sys::provincial_mod_offsets::movement_cost)
+			+ state.world.province_get_modifier_values(p_prev, sys::provincial_mod_offsets::movement_cost);
+		effective_distance += std::max(0.01f, distance * std::max(0.01f, (sum_mods * 2.f + 1.0f)));
+		p_prev = p_current;
+	}
+	return effective_distance;
+}
+
 void recalculate_markets_distance(sys::state& state) {
 	state.world.execute_parallel_over_market([&](auto markets) {
 		auto sids = state.world.market_get_zone_from_local_market(markets);
@@ -210,9 +223,6 @@ void recalculate_markets_distance(sys::state& state) {
 
 		ve::apply([&](auto sid_0, auto sid_1, auto route) {
 			if (state.world.trade_route_get_is_sea_route(route)) {
-				std::vector<dcon::province_id> path{ };
-				dcon::province_id p_prev{ };
-
 				auto coast_0 = province::state_get_coastal_capital(state, sid_0);
 				auto coast_1 = province::state_get_coastal_capital(state, sid_1);
 				// if no coastal caapital on either one of them, then delete the sea trade route as it dosent make sense to keep
@@ -229,26 +239,9 @@ void recalculate_markets_distance(sys::state& state) {
 
 				auto speed = std::max(1.f, std::max(stats_0.maximum_speed, stats_1.maximum_speed));
 
-				path = province::make_sea_trade_route_path(state, coast_0, coast_1);
-				p_prev = coast_0;
-
-				auto ps = path.size();
-				auto effective_distance = 0.f;
-				auto worst_movement_cost = 0.f;
-
-				for(size_t i = 0; i < ps; i++) {
-					auto p_current = path[i];
-					auto adj = state.world.get_province_adjacency_by_province_pair(p_prev, p_current);
-					float distance = province::distance(state, adj);
-					float sum_mods =
-						state.world.province_get_modifier_values(p_current, sys::provincial_mod_offsets::movement_cost)
-						+ state.world.province_get_modifier_values(p_prev, sys::provincial_mod_offsets::movement_cost);
-					effective_distance += std::max(0.01f, distance * std::max(0.01f, (sum_mods * 2.f + 1.0f)));
-					if(sum_mods > worst_movement_cost)
-						worst_movement_cost = std::max(0.01f, sum_mods);
-
-					p_prev = p_current;
-				}
+				static thread_local std::vector<dcon::province_id> path;
+				province::cached::make_sea_trade_route_path(state, coast_0, coast_1, path);
+				auto effective_distance = sea_trade_route_effective_distance(state, coast_0, path);
 
 				if(effective_distance == 0.f) {
 					// no path, remove sea connection
@@ -268,7 +261,7 @@ void recalculate_markets_distance(sys::state& state) {
 
 				auto market_0_center = state.world.state_instance_get_capital(sid_0);
 				auto market_1_center = state.world.state_instance_get_capital(sid_1);
-				path = province::make_land_trade_path(state, market_0_center, market_1_center);
+				path = province::cached::make_land_trade_path(state, market_0_center, market_1_center);
 
 				auto owner_0 = state.world.province_get_nation_from_province_ownership(market_0_center);
 				auto owner_1 = state.world.province_get_nation_from_province_ownership(market_1_center);
@@ -357,10 +350,11 @@ void generate_sea_trade_routes(sys::state& state) {
 	auto base_speed = total_transport_speed / total_amount_of_transports;
 
 	// buffer for "capitals" of connected regions:
-	std::array<dcon::state_instance_id, 4000> capital_of_region = {};
-	std::array<float, 10000> population_of_region = { };
-	std::vector<float> nation_to_max_population = { };
-	nation_to_max_population.resize(state.world.nation_size());
+	// connected coast ids are assigned by a flood fill and never exceed the number of provinces
+	auto region_count = state.world.province_size() + 1;
+	std::pmr::vector<dcon::state_instance_id> capital_of_region(region_count, &state.tick_arena);
+	std::pmr::vector<float> population_of_region(region_count, 0.f, &state.tick_arena);
+	std::pmr::vector<float> nation_to_max_population(state.world.nation_size(), 0.f, &state.tick_arena);
 
 	state.world.for_each_state_instance([&](auto candidate) {
 		// auto capital = state.world.state_instance_get_capital(candidate);
@@ -405,132 +399,108 @@ void generate_sea_trade_routes(sys::state& state) {
 		world_population += state.world.nation_get_demographics(nation, demographics::total);
 	});
 
-	state.world.for_each_state_instance([&](auto origin) {
-		if(!province::state_is_coastal(state, origin))
+	struct coastal_state {
+		dcon::state_instance_id sid;
+		dcon::market_id market;
+		dcon::nation_id owner;
+		dcon::state_instance_id owner_capital_state;
+		dcon::province_id coast;
+		uint16_t connected_region = 0;
+		uint32_t naval_base = 0;
+		float population = 0.f;
+	};
+	std::vector<coastal_state> coastal_states;
+	state.world.for_each_state_instance([&](auto sid) {
+		if(!province::state_is_coastal(state, sid))
 			return;
+		auto owner = state.world.state_instance_get_nation_from_state_ownership(sid);
+		auto coast = province::state_get_coastal_capital(state, sid);
+		coastal_states.push_back(coastal_state{
+			sid,
+			state.world.state_instance_get_market_from_local_market(sid),
+			owner,
+			state.world.province_get_state_membership(state.world.nation_get_capital(owner)),
+			coast,
+			state.world.province_get_connected_coast_id(coast),
+			military::state_naval_base_level(state, sid),
+			state.world.state_instance_get_demographics(sid, demographics::total)
+		});
+	});
+	auto coastal_count = uint32_t(coastal_states.size());
+
+	// whether origin would open a route to target if there was none yet
+	auto wants_route = [&](coastal_state const& origin, coastal_state const& target, std::vector<dcon::province_id>& path) {
+		bool same_owner = target.owner == origin.owner;
+		bool different_region = origin.connected_region != target.connected_region;
+		bool capital_and_connected_region =
+			(capital_of_region[target.connected_region] == target.sid && origin.owner_capital_state == origin.sid)
+			|| (origin.owner_capital_state == target.sid && capital_of_region[origin.connected_region] == origin.sid);
+
+		float mult = 1.f;
+		mult += std::min(origin.naval_base, target.naval_base) * naval_base_level_to_market_attractiveness;
+		bool must_connect = same_owner && different_region && capital_and_connected_region;
+
+		auto distance_approximation = province::direct_distance(state, origin.coast, target.coast) / base_speed;
+
+		float score_origin = origin.population;
+		float score_target = target.population;
+		if(capital_of_region[target.connected_region] == target.sid && capital_of_region[origin.connected_region] == origin.sid) {
+			score_origin = population_of_region[origin.connected_region];
+			score_target = population_of_region[target.connected_region];
+			mult *= 20.f;
+		}
 
-		auto market = state.world.state_instance_get_market_from_local_market(origin);
-
-		auto capital = state.world.state_instance_get_capital(origin);
-		auto owner = state.world.state_instance_get_nation_from_state_ownership(origin);
-		auto state_owner_capital = state.world.nation_get_capital(owner);
-		auto state_owner_capital_state = state.world.province_get_state_membership(state_owner_capital);
-
-		auto naval_base_origin = military::state_naval_base_level(state, origin);
-		auto population_origin = state.world.state_instance_get_demographics(origin, demographics::total);
-		auto coast_0 = province::state_get_coastal_capital(state, origin);
-		auto connected_region = state.world.province_get_connected_coast_id(coast_0);
-		auto connected_region_size = 0.f;
+		float score_approximation = mult * M * score_origin * score_target / distance_approximation / distance_approximation / distance_approximation;
 
-		state.world.for_each_state_instance([&](auto sid) {
-			if(sid == origin)
-				return;
-			if(!province::state_is_coastal(state, sid))
-				return;
+		if(!(score_approximation >= 1.f || must_connect)) {
+			return false;
+		}
 
-			auto coast_1 = province::state_get_coastal_capital(state, sid);
+		province::cached::make_sea_trade_route_path(state, origin.coast, target.coast, path);
+		auto distance = sea_trade_route_effective_distance(state, origin.coast, path) / base_speed;
+
+		float score = mult * M * score_origin * score_target / distance / distance / distance;
+
+		return score >= 1.f || must_connect;
+	};
+
+	// every pair is scored again, as the scores depend on the populations of the states and of their coastal regions, which change for every state between the yearly passes;
+	// only the paths, which depend on the map alone, are reused from state.sea_trade_paths
+	// the candidates are scored in parallel and the routes are then created in the order of a serial pass over every origin and target,
+	// so that the result does not depend on scheduling
+	// a pair is scored from its earlier state first; the later state scores it again only when the earlier one opened no route
+	std::vector<uint8_t> opens_route(size_t(coastal_count) * coastal_count, 0);
+	auto route_exists = [&](uint32_t i, uint32_t j) {
+		return bool(state.world.get_trade_route_by_province_pair(coastal_states[i].market, coastal_states[j].market));
+	};
+	concurrency::parallel_for(uint32_t(0), coastal_count, [&](uint32_t i) {
+		static thread_local std::vector<dcon::province_id> path;
+		for(uint32_t j = i + 1; j < coastal_count; ++j) {
+			if(!route_exists(i, j))
+				opens_route[size_t(i) * coastal_count + j] = wants_route(coastal_states[i], coastal_states[j], path);
+		}
+	});
+	concurrency::parallel_for(uint32_t(0), coastal_count, [&](uint32_t i) {
+		static thread_local std::vector<dcon::province_id> path;
+		for(uint32_t j = 0; j < i; ++j) {
+			if(!route_exists(i, j) && !opens_route[size_t(j) * coastal_count + i])
+				opens_route[size_t(i) * coastal_count + j] = wants_route(coastal_states[i], coastal_states[j], path);
+		}
+	});
 
-			auto target_market = state.world.state_instance_get_market_from_local_market(sid);
-			auto route = state.world.get_trade_route_by_province_pair(market, target_market);
+	for(uint32_t i = 0; i < coastal_count; ++i) {
+		for(uint32_t j = 0; j < coastal_count; ++j) {
+			if(i == j)
+				continue;
+			auto route = state.world.get_trade_route_by_province_pair(coastal_states[i].market, coastal_states[j].market);
 			if(route) {
 				state.world.trade_route_set_is_sea_route(route, true);
-				return;
-			}
-
-			bool same_owner = false;
-			bool different_region = false;
-			bool capital_and_connected_region = false;
-
-			auto target_owner = state.world.state_instance_get_nation_from_state_ownership(sid);
-			if(target_owner == owner) {
-				same_owner = true;
-			}
-
-			auto capital_target = state.world.state_instance_get_capital(sid);
-			auto connected_region_target = state.world.province_get_connected_coast_id(coast_1);
-			if(connected_region != connected_region_target) {
-				different_region = true;
-			}
-
-			if(
-				(
-					capital_of_region[connected_region_target] == sid
-					&&
-					state_owner_capital_state == origin
-				)
-				||
-				(
-					state_owner_capital_state == sid
-					&&
-					capital_of_region[connected_region] == origin
-				)
-			) {
-				capital_and_connected_region = true;
-			}
-
-			auto naval_base_target = military::state_naval_base_level(state, sid);
-			auto state_target_owner_capital = state.world.nation_get_capital(target_owner);
-			auto state_target_owner_capital_state = state.world.province_get_state_membership(state_target_owner_capital);
-			auto continent_target = state.world.province_get_continent(coast_1);
-			auto continent_origin = state.world.province_get_continent(state_owner_capital);
-
-			float mult = 1.f;
-			mult += std::min(naval_base_origin, naval_base_target) * naval_base_level_to_market_attractiveness;
-			bool must_connect = same_owner && different_region && capital_and_connected_region;
-
-			auto distance_approximation = province::direct_distance(state, coast_0, coast_1) / base_speed;
-
-
-			float score_origin = population_origin;
-			float score_target = state.world.state_instance_get_demographics(sid, demographics::total);
-			if(capital_of_region[connected_region_target] == sid && capital_of_region[connected_region] == origin) {
-				score_origin = population_of_region[connected_region];
-				score_target = population_of_region[connected_region_target];
-				mult *= 20.f;
-			}
-
-			float score_approximation = mult * M * score_origin * score_target / distance_approximation / distance_approximation / distance_approximation;
-
-			if(!(score_approximation >= 1.f || must_connect)) {
-				return;
-			}
-
-			auto distance = 9999.f;
-			{
-				std::vector<dcon::province_id> path{ };
-				auto speed = base_speed;
-				dcon::province_id p_prev{ };
-				path = province::make_sea_trade_route_path(state, coast_0, coast_1);
-				p_prev = coast_0;
-
-				auto ps = path.size();
-				auto effective_distance = 0.f;
-				auto worst_movement_cost = 0.f;
-
-				for(size_t i = 0; i < ps; i++) {
-					auto p_current = path[i];
-					auto adj = state.world.get_province_adjacency_by_province_pair(p_prev, p_current);
-					float local_distance = province::distance(state, adj);
-					float sum_mods =
-						state.world.province_get_modifier_values(p_current, sys::provincial_mod_offsets::movement_cost)
-						+ state.world.province_get_modifier_values(p_prev, sys::provincial_mod_offsets::movement_cost);
-					effective_distance += std::max(0.01f, local_distance * std::max(0.01f, (sum_mods * 2.f + 1.0f)));
-					if(sum_mods > worst_movement_cost)
-						worst_movement_cost = std::max(0.01f, sum_mods);
-
-					p_prev = p_current;
-				}
-				distance = effective_distance / speed;
-			}
-
-			float score = mult * M * score_origin * score_target / distance / distance / distance;
-
-			if(score >= 1.f || must_connect) {
-				auto new_route = state.world.force_create_trade_route(market, target_market);
+			} else if(opens_route[size_t(i) * coastal_count + j]) {
+				auto new_route = state.world.force_create_trade_route(coastal_states[i].market, coastal_states[j].market);
 				state.world.trade_route_set_is_sea_route(new_route, true);
 			}
-		});
-	});
+		}
+	}
 
 	// connect to each other coastal connectivity components:
 	std::vector<parent_link> best_parent;
@@ -1470,8 +1440,10 @@ void update_great_powers(sys::state& state) {
 			auto rels = state.world.nation_get_gp_relationship_as_great_power(n);
 			while(rels.begin() != rels.end()) {
 				auto rel = *(rels.begin());
-				if(rel.get_influence_target().get_in_sphere_of() == n)
+				if(rel.get_influence_target().get_in_sphere_of() == n) {
 					rel.get_influence_target().set_in_sphere_of(dcon::nation_id{});
+					state.path_cache.relations_changed(rel.get_influence_target(), n);
+				}
 				state.world.delete_gp_relationship(rel);
 			}
 
@@ -1495,6 +1467,9 @@ void update_great_powers(sys::state& state) {
 			state.great_nations.push_back(sys::great_nation(state.current_date, n));
 			state.world.nation_set_state_from_flashpoint_focus(n, dcon::state_instance_id{});
 
+			if(auto old_leader = state.world.nation_get_in_sphere_of(n); old_leader) {
+				state.path_cache.relations_changed(n, old_leader);
+			}
 			state.world.nation_set_in_sphere_of(n, dcon::nation_id{});
 			state.trade_route_cached_values_out_of_date = true;
 			auto rng = state.world.nation_get_gp_relationship_as_influence_target(n);
@@ -2242,9 +2217,23 @@ ve::mask_vector exists_or_is_utility_tag(sys::state& state, ve::contiguous_tags<
 
 void run_gc(sys::state& state) {
 	//cleanup (will set gc pending)
-	for(const auto n : state.world.in_nation) {
-		if(n.get_marked_for_gc()) {
-			n.set_marked_for_gc(false);
+	// only the nations which lost a province can have been marked; they are visited in increasing id order, as a full sweep would
+	static std::vector<dcon::nation_id> candidates;
+	candidates.clear();
+	if(state.national_definitions.gc_full_sweep) {
+		for(const auto n : state.world.in_nation)
+			candidates.push_back(n);
+	} else {
+		candidates.swap(state.national_definitions.gc_nations);
+		std::sort(candidates.begin(), candidates.end(), [](dcon::nation_id a, dcon::nation_id b) { return a.index() < b.index(); });
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+	}
+	state.national_definitions.gc_nations.clear();
+	state.national_definitions.gc_full_sweep = false;
+
+	for(const auto n : candidates) {
+		if(state.world.nation_is_valid(n) && state.world.nation_get_marked_for_gc(n)) {
+			state.world.nation_set_marked_for_gc(n, false);
 			if(!nations::exists_or_is_utility_tag(state, n)) {
 				nations::cleanup_nation(state, n);
 			}
@@ -2255,8 +2244,12 @@ void run_gc(sys::state& state) {
 		for(uint32_t i = state.world.rebel_faction_size(); i-- > 0; ) {
 			dcon::rebel_faction_id rf{dcon::rebel_faction_id::value_base_t(i) };
 			auto within = state.world.rebel_faction_get_ruler_from_rebellion_within(rf);
-			if(!within)
+			if(!within) {
+				military::queue_units_for_gc(state, rf);
+				if(state.world.rebel_faction_get_province_rebel_control(rf).begin() != state.world.rebel_faction_get_province_rebel_control(rf).end())
+					state.path_cache.territory_changed(dcon::nation_id{ }); // the provinces it held stop being rebel controlled
 				state.world.delete_rebel_faction(rf);
+			}
 		}
 	}
 }
@@ -2321,12 +2314,19 @@ void cleanup_nation(sys::state& state, dcon::nation_id n) {
 		state.world.delete_movement((*movements.begin()).get_movement());
 	}
 
+	// its units and pending peace offer are left without a controller or a sender
+	military::queue_units_for_gc(state, n);
+	if(auto offer = state.world.nation_get_peace_offer_from_pending_peace_offer(n); offer)
+		military::queue_for_gc(state, offer);
+
 	// transfer flags and variables to new holder
 	state.world.delete_nation(n);
+	military::mark_war_relations_out_of_date(state);
 	auto new_ident_holder = state.world.create_nation();
 	state.world.try_create_identity_holder(new_ident_holder, old_ident);
 
 	state.trade_route_cached_values_out_of_date = true;
+	state.path_cache.invalidate();
 
 	for(auto o : state.world.in_nation) {
 		if(o.get_in_sphere_of() == n) {
@@ -2561,6 +2561,7 @@ void clear_trade_agreements(sys::state& state, dcon::nation_id nation) {
 
 void destroy_diplomatic_relationships(sys::state& state, dcon::nation_id n) {
 	state.trade_route_cached_values_out_of_date = true;
+	state.path_cache.invalidate();
 	{
 		auto gp_relationships = state.world.nation_get_gp_relationship_as_great_power(n);
 		while(gp_relationships.begin() != gp_relationships.end()) {
@@ -2606,6 +2607,7 @@ void release_vassal(sys::state& state, dcon::overlord_id rel) {
 		state.world.nation_get_vassals_count(ol)--;
 		military::give_back_units(state, vas);
 		state.world.delete_overlord(rel);
+		state.path_cache.relations_changed(vas, ol);
 		politics::update_displayed_identity(state, vas);
 		// TODO: notify player
 	}
@@ -2632,6 +2634,7 @@ void make_vassal(sys::state& state, dcon::nation_id subject, dcon::nation_id ove
 	} else {
 		state.world.force_create_overlord(subject, overlord);
 		state.trade_route_cached_values_out_of_date = true;
+		state.path_cache.relations_changed(subject, overlord);
 		state.world.nation_get_vassals_count(overlord)++;
 		// clear alliances of subject to prevent potential tomfoolery by the subject
 		clear_alliances(state, subject);
@@ -2660,6 +2663,7 @@ void make_substate(sys::state& state, dcon::nation_id subject, dcon::nation_id o
 	} else {
 		state.world.force_create_overlord(subject, overlord);
 		state.trade_route_cached_values_out_of_date = true;
+		state.path_cache.relations_changed(subject, overlord);
 		state.world.nation_set_is_substate(subject, true);
 		state.world.nation_get_vassals_count(overlord)++;
 		state.world.nation_get_substates_count(current_ruler)++;
@@ -3976,6 +3980,7 @@ void remove_from_sphere(sys::state& state, dcon::nation_id target, uint8_t new_i
 	auto existing_sphere_leader = state.world.nation_get_in_sphere_of(target);
 	if(existing_sphere_leader) {
 		state.trade_route_cached_values_out_of_date = true;
+		state.path_cache.relations_changed(target, existing_sphere_leader);
 		auto rel = state.world.get_gp_relationship_by_gp_influence_pair(target, existing_sphere_leader);
 		assert(rel);
 		state.world.gp_relationship_set_status(rel, uint8_t(state.world.gp_relationship_get_status(rel) & ~nations::influence::level_mask));
@@ -3992,6 +3997,7 @@ void sphere_nation(sys::state& state, dcon::nation_id target, dcon::nation_id so
 	}
 	if(state.world.nation_get_is_great_power(source)) {
 		state.trade_route_cached_values_out_of_date = true;
+		state.path_cache.relations_changed(target, source);
 		auto gp_rel = state.world.get_gp_relationship_by_gp_influence_pair(target, source);
 		if(!gp_rel) {
 			gp_rel = state.world.force_create_gp_relationship(target, source);
@@ -120,6 +120,9 @@ struct global_national_state {
 	std::vector<fixed_event> on_election_finished;
 
 	bool gc_pending = false;
+	// nations which lost a province since the last run_gc and may no longer exist; all nations are checked after loading
+	std::vector<dcon::nation_id> gc_nations;
+	bool gc_full_sweep = true;
 
 	bool is_global_flag_variable_set(dcon::global_flag_id id) const;
 	void set_global_flag_variable(dcon::global_flag_id id, bool state);
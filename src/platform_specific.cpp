@@ -28,6 +28,14 @@
 #include "sound_nix.cpp"
 #include "opengl_wrapper_nix.cpp"
 
+#ifdef ALICE_PATHFINDING_BENCH_ENTRY_POINT
+#include "entry_point_bench_pathfinding.cpp"
+#endif
+
+#ifdef ALICE_BATTLE_BENCH_ENTRY_POINT
+#include "entry_point_bench_battles.cpp"
+#endif
+
 #ifndef ALICE_NO_ENTRY_POINT
 #include "entry_point_nix.cpp"
 #endif
@@ -66,111 +66,374 @@ bool sea_province_is_adjacent_to_accessible_coast(sys::state& state, dcon::provi
 }
 
 
-void update_connected_regions(sys::state& state) {
-	if(!state.adjacency_data_out_of_date)
-		return;
+void rebuild_adjacency_graph(sys::state& state) {
+	auto& graph = state.adjacency_graph;
+	graph.offsets.clear();
+	graph.edges.clear();
+	graph.offsets.reserve(state.world.province_size() + 1);
+	graph.edges.reserve(state.world.province_adjacency_size() * 2);
 
-	state.adjacency_data_out_of_date = false;
-	state.world.nation_adjacency_resize(0);
+	for(auto p : state.world.in_province) {
+		graph.offsets.push_back(uint32_t(graph.edges.size()));
+		// same order as iterating the relationship, so searches break ties the same way
+		for(auto adj : p.get_province_adjacency()) {
+			auto other = adj.get_connected_provinces(0) == p ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			graph.edges.push_back(adjacency_graph::edge{ adj.get_distance(), adj.id, other.id, adj.get_type() });
+		}
+	}
+	graph.offsets.push_back(uint32_t(graph.edges.size()));
+}
+
+void refresh_adjacency_graph_type(sys::state& state, dcon::province_adjacency_id adj) {
+	auto& graph = state.adjacency_graph;
+	if(graph.offsets.empty())
+		return; // not built yet
+	for(int32_t i = 0; i < 2; ++i) {
+		auto p = state.world.province_adjacency_get_connected_provinces(adj, i);
+		for(uint32_t j = graph.offsets[p.index()]; j < graph.offsets[p.index() + 1]; ++j) {
+			if(graph.edges[j].adjacency == adj)
+				graph.edges[j].type = state.world.province_adjacency_get_type(adj);
+		}
+	}
+}
+
+void rebuild_distance_oracle(sys::state& state) {
+	auto& oracle = state.distance_oracle;
+
+	// landmarks are picked one after the other as the province farthest from the ones picked so far, which spreads them along the edges of the map
+	auto province_count = state.world.province_size();
+	auto always = [](auto&&...) { return true; };
+	auto edge_distance = [](dcon::province_id, dcon::province_id, dcon::province_adjacency_id, float distance) { return distance; };
+	static distance_field field;
+	static std::vector<float> nearest_landmark;
+	nearest_landmark.assign(province_count, std::numeric_limits<float>::infinity());
 
+	oracle.landmarks.clear();
+	oracle.landmark_distances.assign(size_t(province_count) * distance_oracle::landmark_count, std::numeric_limits<float>::infinity());
+
+	dcon::province_id next = province_count > 0 ? dcon::province_id{ dcon::province_id::value_base_t(0) } : dcon::province_id{ };
 	{
+		// start from the province farthest from the first one rather than from the first one itself
+		dcon::province_id first[] = { next };
+		if(next)
+			fill_distance_field<search_direction::from_sources>(state, first, always, always, edge_distance, field);
+		float farthest = -1.0f;
+		for(uint32_t i = 0; next && i < province_count; ++i) {
+			dcon::province_id p{ dcon::province_id::value_base_t(i) };
+			if(field.reached(p) && field.distance(p) > farthest) {
+				farthest = field.distance(p);
+				next = p;
+			}
+		}
+	}
+
+	while(next && oracle.landmarks.size() < distance_oracle::landmark_count) {
+		auto l = uint32_t(oracle.landmarks.size());
+		oracle.landmarks.push_back(next);
+		dcon::province_id sources[] = { next };
+		fill_distance_field<search_direction::from_sources>(state, sources, always, always, edge_distance, field);
+
+		next = dcon::province_id{ };
+		float farthest = 0.0f;
+		for(uint32_t i = 0; i < province_count; ++i) {
+			dcon::province_id p{ dcon::province_id::value_base_t(i) };
+			if(!field.reached(p))
+				continue;
+			auto d = field.distance(p);
+			oracle.landmark_distances[size_t(i) * distance_oracle::landmark_count + l] = d;
+			nearest_landmark[i] = std::min(nearest_landmark[i], d);
+			if(nearest_landmark[i] > farthest) {
+				farthest = nearest_landmark[i];
+				next = p;
+			}
+		}
+	}
+}
+
+float landmark_lower_bound(sys::state& state, dcon::province_id a, dcon::province_id b) {
+	auto& oracle = state.distance_oracle;
+	auto const* da = oracle.landmark_distances.data() + size_t(a.index()) * distance_oracle::landmark_count;
+	auto const* db = oracle.landmark_distances.data() + size_t(b.index()) * distance_oracle::landmark_count;
+	float result = 0.0f;
+	for(uint32_t l = 0; l < distance_oracle::landmark_count; ++l) {
+		// a landmark which cannot reach both of them says nothing
+		if(da[l] != std::numeric_limits<float>::infinity() && db[l] != std::numeric_limits<float>::infinity())
+			result = std::max(result, std::abs(da[l] - db[l]));
+	}
+	return result;
+}
+
+namespace {
+
+constexpr uint8_t land_border_mask = province::border::coastal_bit | province::border::impassible_bit; // not entering sea, not impassible
+
+// the regions are numbered in the order a complete fill reaches them, scanning land provinces from the highest index down,
+// so that ids do not depend on which provinces were refilled; connected_region_is_coastal is rebuilt on the way
+void renumber_connected_regions(sys::state& state, uint16_t max_id) {
+	static std::vector<uint16_t> new_ids;
+	new_ids.assign(size_t(max_id) + 1, 0);
+	uint16_t current_fill_id = 0;
+	state.province_definitions.connected_region_is_coastal.clear();
+
+	for(int32_t i = state.province_definitions.first_sea_province.index(); i-- > 0;) {
+		dcon::province_id id{ dcon::province_id::value_base_t(i) };
+		auto old_id = state.world.province_get_connected_region_id(id);
+		if(new_ids[old_id] == 0) {
+			new_ids[old_id] = ++current_fill_id;
+			state.province_definitions.connected_region_is_coastal.push_back(false);
+		}
+		state.world.province_set_connected_region_id(id, new_ids[old_id]);
+		if(state.world.province_get_is_coast(id))
+			state.province_definitions.connected_region_is_coastal[new_ids[old_id] - 1] = true;
+	}
+}
+
+void renumber_connected_coasts(sys::state& state, uint16_t max_id) {
+	static std::vector<uint16_t> new_ids;
+	new_ids.assign(size_t(max_id) + 1, 0);
+	uint16_t current_fill_id = 0;
+
+	for(int32_t i = state.province_definitions.first_sea_province.index(); i-- > 0;) {
+		dcon::province_id id{ dcon::province_id::value_base_t(i) };
+		auto old_id = state.world.province_get_connected_coast_id(id);
+		if(old_id == 0)
+			continue;
+		if(new_ids[old_id] == 0)
+			new_ids[old_id] = ++current_fill_id;
+		state.world.province_set_connected_coast_id(id, new_ids[old_id]);
+	}
+}
+
+// land provinces connected through provinces with the same owner
+// when only a few provinces changed hands, just the regions containing or bordering them are cleared and filled again:
+// any other region keeps all of its members and cannot merge with a cleared one
+void fill_connected_regions(sys::state& state, bool complete) {
+	static std::vector<dcon::province_id> to_fill_list;
+	static std::vector<uint8_t> region_is_cleared;
+	auto land_count = state.province_definitions.first_sea_province.index();
+	uint16_t current_fill_id = 0;
+
+	if(complete) {
 		state.world.for_each_province([&](dcon::province_id id) { state.world.province_set_connected_region_id(id, 0); });
-		// TODO get a better allocator
-		static std::vector<dcon::province_id> to_fill_list;
-		uint16_t current_fill_id = 0;
-		state.province_definitions.connected_region_is_coastal.clear();
-
-		to_fill_list.reserve(state.world.province_size());
-
-		for(int32_t i = state.province_definitions.first_sea_province.index(); i-- > 0;) {
-			dcon::province_id id{dcon::province_id::value_base_t(i)};
-			if(state.world.province_get_connected_region_id(id) == 0) {
-				++current_fill_id;
-
-				bool found_coast = false;
-
-				to_fill_list.push_back(id);
-
-				while(!to_fill_list.empty()) {
-					auto current_id = to_fill_list.back();
-					to_fill_list.pop_back();
-
-					found_coast = found_coast || state.world.province_get_is_coast(current_id);
-
-					state.world.province_set_connected_region_id(current_id, current_fill_id);
-					for(auto rel : state.world.province_get_province_adjacency(current_id)) {
-						if((rel.get_type() & (province::border::coastal_bit | province::border::impassible_bit)) ==
-								0) { // not entering sea, not impassible
-							auto owner_a = rel.get_connected_provinces(0).get_nation_from_province_ownership();
-							auto owner_b = rel.get_connected_provinces(1).get_nation_from_province_ownership();
-							if(owner_a == owner_b) { // both have the same owner
-								if(rel.get_connected_provinces(0).get_connected_region_id() == 0)
-									to_fill_list.push_back(rel.get_connected_provinces(0));
-								if(rel.get_connected_provinces(1).get_connected_region_id() == 0)
-									to_fill_list.push_back(rel.get_connected_provinces(1));
-							} else {
-								state.world.try_create_nation_adjacency(owner_a, owner_b);
-							}
+	} else {
+		region_is_cleared.assign(state.province_definitions.connected_region_is_coastal.size() + 1, 0);
+		for(auto& [index, old_owner] : state.province_definitions.owner_before_change) {
+			dcon::province_id changed{ dcon::province_id::value_base_t(index) };
+			region_is_cleared[state.world.province_get_connected_region_id(changed)] = 1;
+			for(auto& e : state.adjacency_graph.neighbors(changed)) {
+				if((e.type & land_border_mask) == 0)
+					region_is_cleared[state.world.province_get_connected_region_id(e.neighbor)] = 1;
+			}
+		}
+		region_is_cleared[0] = 0;
+		for(int32_t i = land_count; i-- > 0;) {
+			dcon::province_id id{ dcon::province_id::value_base_t(i) };
+			auto region = state.world.province_get_connected_region_id(id);
+			if(region_is_cleared[region])
+				state.world.province_set_connected_region_id(id, 0);
+			else
+				current_fill_id = std::max(current_fill_id, region);
+		}
+	}
+
+	to_fill_list.reserve(state.world.province_size());
+
+	for(int32_t i = land_count; i-- > 0;) {
+		dcon::province_id id{ dcon::province_id::value_base_t(i) };
+		if(state.world.province_get_connected_region_id(id) == 0) {
+			++current_fill_id;
+
+			to_fill_list.push_back(id);
+
+			while(!to_fill_list.empty()) {
+				auto current_id = to_fill_list.back();
+				to_fill_list.pop_back();
+
+				state.world.province_set_connected_region_id(current_id, current_fill_id);
+				auto owner_here = state.world.province_get_nation_from_province_ownership(current_id);
+				for(auto& e : state.adjacency_graph.neighbors(current_id)) {
+					if((e.type & land_border_mask) == 0) {
+						auto owner_there = state.world.province_get_nation_from_province_ownership(e.neighbor);
+						if(owner_here == owner_there) { // both have the same owner
+							if(state.world.province_get_connected_region_id(e.neighbor) == 0)
+								to_fill_list.push_back(e.neighbor);
 						}
 					}
 				}
-
-				state.province_definitions.connected_region_is_coastal.push_back(found_coast);
-				to_fill_list.clear();
 			}
-		}
 
-		// we also invalidate wargoals here that are now unowned
-		military::invalidate_unowned_wargoals(state);
+			to_fill_list.clear();
+		}
 	}
 
-	{
-		state.world.for_each_province([&](dcon::province_id id) { state.world.province_set_connected_coast_id(id, 0); });
+	renumber_connected_regions(state, current_fill_id);
+}
 
-		static std::vector<dcon::province_id> to_fill_list;
-		uint16_t current_fill_id = 0;
-		to_fill_list.reserve(state.world.province_size());
+// coastal land provinces connected through coastal provinces with the same owner, cleared and filled again like the regions above
+void fill_connected_coasts(sys::state& state, bool complete) {
+	static std::vector<dcon::province_id> to_fill_list;
+	static std::vector<uint8_t> coast_is_cleared;
+	auto land_count = state.province_definitions.first_sea_province.index();
+	uint16_t current_fill_id = 0;
 
-		for(int32_t i = state.province_definitions.first_sea_province.index(); i-- > 0;) {
+	if(complete) {
+		state.world.for_each_province([&](dcon::province_id id) { state.world.province_set_connected_coast_id(id, 0); });
+	} else {
+		coast_is_cleared.assign(size_t(land_count) + 1, 0);
+		for(auto& [index, old_owner] : state.province_definitions.owner_before_change) {
+			dcon::province_id changed{ dcon::province_id::value_base_t(index) };
+			coast_is_cleared[state.world.province_get_connected_coast_id(changed)] = 1;
+			for(auto& e : state.adjacency_graph.neighbors(changed)) {
+				if((e.type & land_border_mask) == 0)
+					coast_is_cleared[state.world.province_get_connected_coast_id(e.neighbor)] = 1;
+			}
+		}
+		coast_is_cleared[0] = 0;
+		for(int32_t i = land_count; i-- > 0;) {
 			dcon::province_id id{ dcon::province_id::value_base_t(i) };
-			if(state.world.province_get_connected_coast_id(id) == 0 && state.world.province_get_is_coast(id)) {
-				++current_fill_id;
-
-				to_fill_list.push_back(id);
-				while(!to_fill_list.empty()) {
-					auto current_id = to_fill_list.back();
-					to_fill_list.pop_back();
-
-					state.world.province_set_connected_coast_id(current_id, current_fill_id);
-					for(auto rel : state.world.province_get_province_adjacency(current_id)) {
-						if(
-							(
-								rel.get_type()
-								&
-								(province::border::coastal_bit | province::border::impassible_bit)
-							) == 0
-						) { // not entering sea, not impassible
-							auto owner_a = rel.get_connected_provinces(0).get_nation_from_province_ownership();
-							auto owner_b = rel.get_connected_provinces(1).get_nation_from_province_ownership();
-
-							auto coast_a = rel.get_connected_provinces(0).get_is_coast();
-							auto coast_b = rel.get_connected_provinces(1).get_is_coast();
-
-							if(owner_a == owner_b && coast_a == coast_b) { // both have the same owner and are coastal
-								if(rel.get_connected_provinces(0).get_connected_coast_id() == 0)
-									to_fill_list.push_back(rel.get_connected_provinces(0));
-								if(rel.get_connected_provinces(1).get_connected_coast_id() == 0)
-									to_fill_list.push_back(rel.get_connected_provinces(1));
-							}
+			auto coast = state.world.province_get_connected_coast_id(id);
+			if(coast_is_cleared[coast])
+				state.world.province_set_connected_coast_id(id, 0);
+			else
+				current_fill_id = std::max(current_fill_id, coast);
+		}
+	}
+
+	to_fill_list.reserve(state.world.province_size());
+
+	for(int32_t i = land_count; i-- > 0;) {
+		dcon::province_id id{ dcon::province_id::value_base_t(i) };
+		if(state.world.province_get_connected_coast_id(id) == 0 && state.world.province_get_is_coast(id)) {
+			++current_fill_id;
+
+			to_fill_list.push_back(id);
+			while(!to_fill_list.empty()) {
+				auto current_id = to_fill_list.back();
+				to_fill_list.pop_back();
+
+				state.world.province_set_connected_coast_id(current_id, current_fill_id);
+				auto owner_here = state.world.province_get_nation_from_province_ownership(current_id);
+				auto coast_here = state.world.province_get_is_coast(current_id);
+				for(auto& e : state.adjacency_graph.neighbors(current_id)) {
+					if((e.type & land_border_mask) == 0) {
+						auto owner_there = state.world.province_get_nation_from_province_ownership(e.neighbor);
+						auto coast_there = state.world.province_get_is_coast(e.neighbor);
+
+						if(owner_here == owner_there && coast_here == coast_there) { // both have the same owner and are coastal
+							if(state.world.province_get_connected_coast_id(e.neighbor) == 0)
+								to_fill_list.push_back(e.neighbor);
 						}
 					}
 				}
+			}
 
-				to_fill_list.clear();
+			to_fill_list.clear();
+		}
+	}
+
+	renumber_connected_coasts(state, current_fill_id);
+}
+
+bool add_nation_border(sys::state& state, dcon::nation_id a, dcon::nation_id b, int32_t count) {
+	if(a == b)
+		return false;
+	if(b.value < a.value)
+		std::swap(a, b);
+	auto key = (uint64_t(a.value) << 32) | uint64_t(b.value);
+	auto& borders = state.province_definitions.nation_borders;
+	auto it = borders.find(key);
+	if(it == borders.end()) {
+		assert(count > 0);
+		borders.insert_or_assign(key, province::global_provincial_state::nation_border{ a, b, count });
+		return true;
+	}
+	it->second.count += count;
+	assert(it->second.count >= 0);
+	if(it->second.count == 0) {
+		borders.erase(it);
+		return true;
+	}
+	return false;
+}
+
+// nation_adjacency holds a pair for every two owners sharing a passable land border
+// the borders are counted per pair so that a transfer only has to look at the edges of the provinces involved
+// when the set of pairs changes it is recreated in key order, independently of the order the changes were made in
+void update_nation_adjacency(sys::state& state, bool complete) {
+	auto& borders = state.province_definitions.nation_borders;
+	auto land_count = state.province_definitions.first_sea_province.index();
+	bool pairs_changed = complete;
+
+	if(complete) {
+		borders.clear();
+		for(int32_t i = land_count; i-- > 0;) {
+			dcon::province_id id{ dcon::province_id::value_base_t(i) };
+			auto owner_here = state.world.province_get_nation_from_province_ownership(id);
+			for(auto& e : state.adjacency_graph.neighbors(id)) {
+				// each land border is counted from its lower index end
+				if((e.type & land_border_mask) == 0 && (e.neighbor.index() >= land_count || e.neighbor.index() > i))
+					add_nation_border(state, owner_here, state.world.province_get_nation_from_province_ownership(e.neighbor), 1);
+			}
+		}
+	} else {
+		auto& changes = state.province_definitions.owner_before_change;
+		auto owner_before = [&](dcon::province_id p) {
+			auto it = changes.find(p.index());
+			return it != changes.end() ? it->second : state.world.province_get_nation_from_province_ownership(p);
+		};
+		for(auto& [index, old_owner] : changes) {
+			dcon::province_id changed{ dcon::province_id::value_base_t(index) };
+			auto owner_here = state.world.province_get_nation_from_province_ownership(changed);
+			for(auto& e : state.adjacency_graph.neighbors(changed)) {
+				if((e.type & land_border_mask) != 0)
+					continue;
+				// a border between two changed provinces is handled from its lower index end
+				if(e.neighbor.index() < index && changes.contains(e.neighbor.index()))
+					continue;
+				pairs_changed = add_nation_border(state, old_owner, owner_before(e.neighbor), -1) || pairs_changed;
+				pairs_changed = add_nation_border(state, owner_here, state.world.province_get_nation_from_province_ownership(e.neighbor), 1) || pairs_changed;
 			}
 		}
 	}
 
+	if(!pairs_changed)
+		return;
+
+	static std::vector<uint64_t> keys;
+	keys.clear();
+	for(auto& [key, border] : borders)
+		keys.push_back(key);
+	std::sort(keys.begin(), keys.end());
+
+	state.world.nation_adjacency_resize(0);
+	for(auto key : keys) {
+		auto& border = borders.find(key)->second;
+		state.world.try_create_nation_adjacency(border.a, border.b);
+	}
+}
+
+}
+
+void update_connected_regions(sys::state& state) {
+	if(!state.adjacency_data_out_of_date)
+		return;
+
+	state.adjacency_data_out_of_date = false;
+
+	auto& definitions = state.province_definitions;
+	bool complete = definitions.connected_regions_need_rebuild || definitions.nation_borders.empty();
+
+	fill_connected_regions(state, complete);
+	update_nation_adjacency(state, complete);
+
+	// we also invalidate wargoals here that are now unowned
+	military::invalidate_unowned_wargoals(state);
+
+	fill_connected_coasts(state, complete);
+
+	definitions.owner_before_change.clear();
+	definitions.connected_regions_need_rebuild = false;
+
 
 	auto& province_to_borders = state.map_state.map_data.province_to_borders;
 	if(province_to_borders.empty()) {
@@ -512,16 +775,17 @@ dcon::province_id pick_capital(sys::state& state, dcon::nation_id n) {
 	return best_choice;
 }
 
-void set_province_controller(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+// the control change itself: the province and the counts of its owner; the follow-ups are left to finish_controller_changes
+// returns whether the controller changed
+bool apply_controller_change(sys::state& state, dcon::province_id p, dcon::nation_id n) {
 	auto old_con = state.world.province_get_nation_from_province_control(p);
 	auto curr_owner = state.world.province_get_nation_from_province_ownership(p);
 	// don't switch controllership on an uncolonized province
 	if(!curr_owner) {
-		return;
+		return false;
 	}
 	if(old_con != n) {
 		state.world.province_set_last_control_change(p, state.current_date);
-		state.trade_route_cached_values_out_of_date = true;
 		auto rc = state.world.province_get_rebel_faction_from_province_rebel_control(p);
 		auto owner = state.world.province_get_nation_from_province_ownership(p);
 		if(rc && owner) {
@@ -543,20 +807,22 @@ void set_province_controller(sys::state& state, dcon::province_id p, dcon::natio
 		}
 		state.world.province_set_rebel_faction_from_province_rebel_control(p, dcon::rebel_faction_id{});
 		state.world.province_set_nation_from_province_control(p, n);
-		state.military_definitions.pending_blackflag_update = true;
+		state.path_cache.territory_changed(old_con);
+		state.path_cache.territory_changed(n);
+		return true;
 	}
+	return false;
 }
 
-void set_province_controller(sys::state& state, dcon::province_id p, dcon::rebel_faction_id rf) {
+bool apply_controller_change(sys::state& state, dcon::province_id p, dcon::rebel_faction_id rf) {
 	auto old_con = state.world.province_get_rebel_faction_from_province_rebel_control(p);
 	auto curr_owner = state.world.province_get_nation_from_province_ownership(p);
 	// don't switch controllership on an uncolonized province
 	if(!curr_owner) {
-		return;
+		return false;
 	}
 	if(old_con != rf) {
 		state.world.province_set_last_control_change(p, state.current_date);
-		state.trade_route_cached_values_out_of_date = true;
 		auto owner = state.world.province_get_nation_from_province_ownership(p);
 		if(!old_con && owner) {
 			state.world.nation_set_rebel_controlled_count(owner, uint16_t(state.world.nation_get_rebel_controlled_count(owner) + uint16_t(1)));
@@ -571,141 +837,257 @@ void set_province_controller(sys::state& state, dcon::province_id p, dcon::rebel
 				assert(state.world.nation_get_central_blockaded(owner) >= 0);
 			}
 		}
+		state.path_cache.territory_changed(state.world.province_get_nation_from_province_control(p));
+		state.path_cache.territory_changed(dcon::nation_id{ });
 		state.world.province_set_rebel_faction_from_province_rebel_control(p, rf);
 		state.world.province_set_nation_from_province_control(p, dcon::nation_id{});
-		state.military_definitions.pending_blackflag_update = true;
+		return true;
 	}
+	return false;
 }
 
-void restore_cached_values(sys::state& state) {
-
+// the follow-ups of the control changes of the given provinces which are shared by all of them
+void finish_controller_changes(sys::state& state, std::span<const dcon::province_id> changed) {
+	if(changed.empty())
+		return;
 	state.trade_route_cached_values_out_of_date = true;
-	
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_central_province_count(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_central_blockaded(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation(
-			[&](auto ids) { state.world.nation_set_central_rebel_controlled(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_rebel_controlled_count(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_central_ports(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_central_crime_count(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_total_ports(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_occupied_count(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_owned_state_count(ids, ve::int_vector()); });
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_is_colonial_nation(ids, ve::mask_vector()); });
+	state.region_hierarchy.mark_changed(changed);
+	// every owner is queued once for update_cached_values, not once per province
+	auto& definitions = state.province_definitions;
+	if(definitions.cached_values_dirty.size() < size_t(state.world.province_size()))
+		definitions.cached_values_dirty.resize(state.world.province_size(), uint8_t(0));
+	auto first_owner = definitions.cached_values_dirty_nations.size();
+	for(auto p : changed) {
+		if(definitions.cached_values_dirty[p.index()] == 0) {
+			definitions.cached_values_dirty[p.index()] = 1;
+			definitions.cached_values_dirty_provinces.push_back(p);
+		}
+		if(auto owner = state.world.province_get_nation_from_province_ownership(p); owner) {
+			definitions.cached_values_dirty_nations.push_back(owner);
+			military::mark_war_scores_stale(state, owner, military::war_score_part::occupation);
+		}
+	}
+	std::sort(definitions.cached_values_dirty_nations.begin() + first_owner, definitions.cached_values_dirty_nations.end(), [](dcon::nation_id a, dcon::nation_id b) { return a.index() < b.index(); });
+	definitions.cached_values_dirty_nations.erase(std::unique(definitions.cached_values_dirty_nations.begin() + first_owner, definitions.cached_values_dirty_nations.end()), definitions.cached_values_dirty_nations.end());
+	state.national_cached_values_out_of_date = true;
+	state.military_definitions.pending_blackflag_update = true;
+}
 
-	// need to set owner cores first because capital selection depends on them
+void set_province_controller(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+	if(apply_controller_change(state, p, n))
+		finish_controller_changes(state, std::span<const dcon::province_id>(&p, 1));
+}
 
-	for(auto n : state.world.in_nation) {
-		auto orange = n.get_province_ownership();
-		n.set_owned_province_count(uint16_t(orange.end() - orange.begin()));
+void set_province_controller(sys::state& state, dcon::province_id p, dcon::rebel_faction_id rf) {
+	if(apply_controller_change(state, p, rf))
+		finish_controller_changes(state, std::span<const dcon::province_id>(&p, 1));
+}
+
+void set_province_controllers(sys::state& state, std::span<const controller_change> changes) {
+	static std::vector<dcon::province_id> changed;
+	changed.clear();
+	for(auto& c : changes) {
+		if(c.rebels ? apply_controller_change(state, c.province, c.rebels) : apply_controller_change(state, c.province, c.nation))
+			changed.push_back(c.province);
 	}
+	finish_controller_changes(state, changed);
+}
 
-	for(int32_t i = 0; i < state.province_definitions.first_sea_province.index(); ++i) {
-		dcon::province_id pid{dcon::province_id::value_base_t(i)};
+void mark_cached_values_dirty(sys::state& state, dcon::province_id p) {
+	auto& definitions = state.province_definitions;
+	if(definitions.cached_values_dirty.size() <= size_t(p.index()))
+		definitions.cached_values_dirty.resize(state.world.province_size(), uint8_t(0));
+	if(definitions.cached_values_dirty[p.index()] == 0) {
+		definitions.cached_values_dirty[p.index()] = 1;
+		definitions.cached_values_dirty_provinces.push_back(p);
+	}
+	if(auto owner = state.world.province_get_nation_from_province_ownership(p); owner)
+		definitions.cached_values_dirty_nations.push_back(owner);
+	state.national_cached_values_out_of_date = true;
+}
 
-		auto owner = state.world.province_get_nation_from_province_ownership(pid);
-		if(owner) {
-			bool owner_core = false;
-			for(auto c : state.world.province_get_core(pid)) {
-				if(c.get_identity().get_nation_from_identity_holder() == owner) {
-					owner_core = true;
-					break;
-				}
+void mark_cached_values_dirty(sys::state& state, dcon::nation_id n) {
+	if(n)
+		state.province_definitions.cached_values_dirty_nations.push_back(n);
+	state.national_cached_values_out_of_date = true;
+}
+
+void refresh_is_owner_core(sys::state& state, dcon::province_id pid) {
+	auto owner = state.world.province_get_nation_from_province_ownership(pid);
+	bool owner_core = false;
+	if(owner) {
+		for(auto c : state.world.province_get_core(pid)) {
+			if(c.get_identity().get_nation_from_identity_holder() == owner) {
+				owner_core = true;
+				break;
 			}
-			state.world.province_set_is_owner_core(pid, owner_core);
-		} else {
-			state.world.province_set_is_owner_core(pid, false);
 		}
 	}
+	state.world.province_set_is_owner_core(pid, owner_core);
+}
 
-	for(auto n : state.world.in_nation) {
-		if(n.get_capital().get_nation_from_province_ownership() != n) {
-			n.set_capital(pick_capital(state, n));
-		}
+// recounts everything cached on the nation from the provinces and states it owns
+// touches only the nation, its states and nothing shared, so different nations may be refreshed in parallel
+// needs is_owner_core to be up to date for the provinces of the nation, because capital selection depends on it
+void refresh_nation_cached_values(sys::state& state, dcon::nation_id n) {
+	auto owned = state.world.nation_get_province_ownership(n);
+	state.world.nation_set_owned_province_count(n, uint16_t(owned.end() - owned.begin()));
+
+	if(state.world.province_get_nation_from_province_ownership(state.world.nation_get_capital(n)) != n) {
+		state.world.nation_set_capital(n, pick_capital(state, n));
 	}
 
-	for(int32_t i = 0; i < state.province_definitions.first_sea_province.index(); ++i) {
-		dcon::province_id pid{dcon::province_id::value_base_t(i)};
+	uint16_t central_province_count = 0;
+	uint16_t central_blockaded = 0;
+	uint16_t central_rebel_controlled = 0;
+	uint16_t rebel_controlled_count = 0;
+	uint16_t central_ports = 0;
+	uint16_t central_crime_count = 0;
+	uint16_t total_ports = 0;
+	uint16_t occupied_count = 0;
+	bool is_colonial_nation = false;
 
-		auto owner = state.world.province_get_nation_from_province_ownership(pid);
-		if(owner) {
+	for(auto o : owned) {
+		auto pid = o.get_province().id;
 
-			bool reb_controlled = bool(state.world.province_get_rebel_faction_from_province_rebel_control(pid));
+		bool reb_controlled = bool(state.world.province_get_rebel_faction_from_province_rebel_control(pid));
+		if(reb_controlled) {
+			++rebel_controlled_count;
+		}
+		if(state.world.province_get_is_coast(pid)) {
+			++total_ports;
+		}
+		if(auto c = state.world.province_get_nation_from_province_control(pid); bool(c) && c != n) {
+			++occupied_count;
+		}
+		if(state.world.province_get_is_colonial(pid)) {
+			is_colonial_nation = true;
+		}
+		if(!is_overseas(state, pid)) {
+			++central_province_count;
 
-			if(reb_controlled) {
-				state.world.nation_set_rebel_controlled_count(owner, uint16_t(state.world.nation_get_rebel_controlled_count(owner) + uint16_t(1)));
+			if(military::province_is_blockaded(state, pid) && n == state.world.province_get_nation_from_province_control(pid)) {
+				++central_blockaded;
 			}
 			if(state.world.province_get_is_coast(pid)) {
-				state.world.nation_set_total_ports(owner, uint16_t(state.world.nation_get_total_ports(owner) + uint16_t(1)));
-			}
-			if(auto c = state.world.province_get_nation_from_province_control(pid); bool(c) && c != owner) {
-				state.world.nation_set_occupied_count(owner, uint16_t(state.world.nation_get_occupied_count(owner) + uint16_t(1)));
+				++central_ports;
 			}
-			if(state.world.province_get_is_colonial(pid)) {
-				state.world.nation_set_is_colonial_nation(owner, true);
+			if(reb_controlled) {
+				++central_rebel_controlled;
 			}
-			if(!is_overseas(state, pid)) {
-				state.world.nation_set_central_province_count(owner, uint16_t(state.world.nation_get_central_province_count(owner) + uint16_t(1)));
-
-				if(military::province_is_blockaded(state, pid) && owner == state.world.province_get_nation_from_province_control(pid)) {
-					state.world.nation_set_central_blockaded(owner, uint16_t(state.world.nation_get_central_blockaded(owner) + uint16_t(1)));
-				}
-				if(state.world.province_get_is_coast(pid)) {
-					state.world.nation_set_central_ports(owner, uint16_t(state.world.nation_get_central_ports(owner) + uint16_t(1)));
-				}
-				assert(state.world.nation_get_central_blockaded(owner) <= state.world.nation_get_central_ports(owner));
-				if(reb_controlled) {
-					state.world.nation_set_central_rebel_controlled(owner, uint16_t(state.world.nation_get_central_rebel_controlled(owner) + uint16_t(1)));
-				}
-				if(state.world.province_get_crime(pid)) {
-					state.world.nation_set_central_crime_count(owner, uint16_t(state.world.nation_get_central_crime_count(owner) + uint16_t(1)));
-				}
+			if(state.world.province_get_crime(pid)) {
+				++central_crime_count;
 			}
 		}
 	}
-	state.world.for_each_state_instance([&](dcon::state_instance_id s) {
-		auto owner = state.world.state_instance_get_nation_from_state_ownership(s);
-		state.world.nation_set_owned_state_count(owner, uint16_t(state.world.nation_get_owned_state_count(owner) + uint16_t(1)));
+	assert(central_blockaded <= central_ports);
+
+	state.world.nation_set_central_province_count(n, central_province_count);
+	state.world.nation_set_central_blockaded(n, central_blockaded);
+	state.world.nation_set_central_rebel_controlled(n, central_rebel_controlled);
+	state.world.nation_set_rebel_controlled_count(n, rebel_controlled_count);
+	state.world.nation_set_central_ports(n, central_ports);
+	state.world.nation_set_central_crime_count(n, central_crime_count);
+	state.world.nation_set_total_ports(n, total_ports);
+	state.world.nation_set_occupied_count(n, occupied_count);
+	state.world.nation_set_is_colonial_nation(n, is_colonial_nation);
+
+	uint16_t owned_state_count = 0;
+	for(auto so : state.world.nation_get_state_ownership(n)) {
+		++owned_state_count;
+		auto s = so.get_state();
 		dcon::province_id p;
 
 		int16_t min_priority = (int16_t)state.world.abstract_state_membership_size();
 
-		for(auto prv : state.world.state_definition_get_abstract_state_membership(state.world.state_instance_get_definition(s))) {
+		for(auto prv : state.world.state_definition_get_abstract_state_membership(s.get_definition())) {
 			auto priority = state.world.abstract_state_membership_get_priority(prv);
-			if (priority < min_priority && state.world.province_get_nation_from_province_ownership(prv.get_province()) == owner) {
+			if (priority < min_priority && state.world.province_get_nation_from_province_ownership(prv.get_province()) == n) {
 				p = prv.get_province().id;
 				min_priority = priority;
 			}
 		}
 
-		state.world.state_instance_set_capital(s, p);
+		s.set_capital(p);
+	}
+	state.world.nation_set_owned_state_count(n, owned_state_count);
+}
+
+void clear_cached_values_dirty(sys::state& state) {
+	auto& definitions = state.province_definitions;
+	for(auto p : definitions.cached_values_dirty_provinces)
+		definitions.cached_values_dirty[p.index()] = 0;
+	definitions.cached_values_dirty_provinces.clear();
+	definitions.cached_values_dirty_nations.clear();
+	definitions.cached_values_need_rebuild = false;
+}
+
+void restore_cached_values(sys::state& state) {
+
+	state.trade_route_cached_values_out_of_date = true;
+
+	// need to set owner cores first because capital selection depends on them
+	concurrency::parallel_for(0, state.province_definitions.first_sea_province.index(), [&](int32_t i) {
+		refresh_is_owner_core(state, dcon::province_id{ dcon::province_id::value_base_t(i) });
+	});
+
+	// every nation only writes to itself and to the states it owns, so the counts are the same as a serial pass
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		if(state.world.nation_is_valid(n))
+			refresh_nation_cached_values(state, n);
 	});
+
+	clear_cached_values_dirty(state);
 }
 
+// only the owners, past and present, of the provinces marked by mark_cached_values_dirty are recounted
 void update_cached_values(sys::state& state) {
 	if(!state.national_cached_values_out_of_date)
 		return;
 
 	state.national_cached_values_out_of_date = false;
 
-	restore_cached_values(state);
+	auto& definitions = state.province_definitions;
+	if(definitions.cached_values_need_rebuild) {
+		restore_cached_values(state);
+		return;
+	}
+	if(definitions.cached_values_dirty_nations.empty() && definitions.cached_values_dirty_provinces.empty())
+		return;
+
+	state.trade_route_cached_values_out_of_date = true;
+
+	for(auto p : definitions.cached_values_dirty_provinces) {
+		refresh_is_owner_core(state, p);
+		if(auto owner = state.world.province_get_nation_from_province_ownership(p); owner)
+			definitions.cached_values_dirty_nations.push_back(owner);
+	}
+
+	auto& nations = definitions.cached_values_dirty_nations;
+	std::sort(nations.begin(), nations.end(), [](dcon::nation_id a, dcon::nation_id b) { return a.index() < b.index(); });
+	nations.erase(std::unique(nations.begin(), nations.end()), nations.end());
+
+	concurrency::parallel_for(uint32_t(0), uint32_t(nations.size()), [&](uint32_t i) {
+		if(state.world.nation_is_valid(nations[i]))
+			refresh_nation_cached_values(state, nations[i]);
+	});
+
+	clear_cached_values_dirty(state);
 }
 
 void update_blockaded_cache(sys::state& state) {
-	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_central_blockaded(ids, ve::int_vector()); });
-	for(int32_t i = 0; i < state.province_definitions.first_sea_province.index(); ++i) {
-		dcon::province_id pid{ dcon::province_id::value_base_t(i) };
-
-		auto owner = state.world.province_get_nation_from_province_ownership(pid);
-		auto controller = state.world.province_get_nation_from_province_control(pid);
-		if(owner && owner == controller) {
-			if(!is_overseas(state, pid)) {
-				if(military::province_is_blockaded(state, pid)) {
-					state.world.nation_set_central_blockaded(owner, uint16_t(state.world.nation_get_central_blockaded(owner) + uint16_t(1)));
-				}
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		uint16_t central_blockaded = 0;
+		for(auto o : state.world.nation_get_province_ownership(n)) {
+			auto pid = o.get_province().id;
+			if(n == state.world.province_get_nation_from_province_control(pid) && !is_overseas(state, pid) && military::province_is_blockaded(state, pid)) {
+				++central_blockaded;
 			}
 		}
-	}
+		state.world.nation_set_central_blockaded(n, central_blockaded);
+	});
 }
 
 void restore_unsaved_values(sys::state& state) {
@@ -1041,6 +1423,7 @@ void upgrade_colonial_state(sys::state& state, dcon::nation_id source, dcon::sta
 	province::for_each_province_in_state_instance(state, si, [&](dcon::province_id p) {
 		// Provinces in the state stop being colonial.
 		state.world.province_set_is_colonial(p, false);
+		mark_cached_values_dirty(state, p);
 
 		// All timed modifiers active for provinces in the state expire
 		auto timed_modifiers = state.world.province_get_current_modifiers(p);
@@ -1076,6 +1459,8 @@ void upgrade_colonial_state(sys::state& state, dcon::nation_id source, dcon::sta
 
 void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation_id new_owner) {
 	assert(id);
+	state.path_cache.invalidate();
+	state.region_hierarchy.mark_changed(id);
 	auto state_def = state.world.province_get_state_from_abstract_state_membership(id);
 	auto old_si = state.world.province_get_state_membership(id);
 	auto old_market = state.world.state_instance_get_market_from_local_market(old_si);
@@ -1085,7 +1470,12 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 		return;
 
 	state.adjacency_data_out_of_date = true;
-	state.national_cached_values_out_of_date = true;
+	state.province_definitions.owner_before_change.try_emplace(id.index(), old_owner);
+	mark_cached_values_dirty(state, id); // the old owner; the new one is picked up from the province by the update
+	if(old_owner)
+		military::mark_war_scores_stale(state, old_owner, military::war_score_part::occupation | military::war_score_part::blockades);
+	if(new_owner)
+		military::mark_war_scores_stale(state, new_owner, military::war_score_part::occupation | military::war_score_part::blockades);
 
 	bool state_is_new = false;
 	dcon::state_instance_id new_si;
@@ -1355,6 +1745,7 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 		auto lprovs = state.world.nation_get_province_ownership(old_owner);
 		if(!nations::exists_or_is_utility_tag(state, old_owner) ) {
 			state.world.nation_set_marked_for_gc(old_owner, true);
+			state.national_definitions.gc_nations.push_back(old_owner);
 		}
 	}
 
@@ -1409,6 +1800,7 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 		} else {
 			adj.set_type(adj.get_type() | province::border::national_bit);
 		}
+		refresh_adjacency_graph_type(state, adj);
 	}
 
 	/* Properly cleanup rebels when the province ownership changes */
@@ -1418,6 +1810,7 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 			state.world.army_set_controller_from_army_control(ar.get_army(), dcon::nation_id{});
 			state.world.army_set_controller_from_army_rebel_control(ar.get_army(), dcon::rebel_faction_id{});
 			state.world.army_set_is_retreating(ar.get_army(), true);
+			military::queue_for_gc(state, ar.get_army().id);
 		}
 	}
 
@@ -2207,6 +2600,11 @@ void enable_canal(sys::state& state, int32_t id) {
 	if(auto can_id = state.province_definitions.canals[id]; can_id) {
 		auto current = state.world.province_adjacency_get_type(can_id);
 		state.world.province_adjacency_set_type(can_id, uint8_t(current & ~province::border::impassible_bit));
+		refresh_adjacency_graph_type(state, can_id);
+		state.path_cache.invalidate();
+		state.region_hierarchy.mark_changed(state.world.province_adjacency_get_connected_provinces(can_id, 0));
+		state.region_hierarchy.mark_changed(state.world.province_adjacency_get_connected_provinces(can_id, 1));
+		state.sea_trade_paths.reset();
 	}
 }
 
@@ -2418,7 +2816,8 @@ std::vector<dcon::province_id> make_land_unit_path(sys::state& state, dcon::prov
 
 }
 
-std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+template<bool Hierarchical>
+std::vector<dcon::province_id> make_safe_land_path_impl(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
 
 	auto adjacency_func = [&](dcon::province_id to, dcon::province_id from, dcon::province_adjacency_id adj) {
 		return !is_adjacency_impassable(state, nation_as, adj);
@@ -2437,8 +2836,17 @@ std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::prov
 
 	};
 
-	return make_path_to_prov<1.0f>(state, start, end, adjacency_func, province_func, modifier_func); // multiply heuristic by 1 for faster path (mainly used by ai)
+	if constexpr(Hierarchical)
+		return make_hierarchical_path_to_prov<1.0f>(state, start, end, adjacency_func, province_func, modifier_func); // long paths are only refined around the shortest route between states
+	else
+		return make_path_to_prov<1.0f>(state, start, end, adjacency_func, province_func, modifier_func); // multiply heuristic by 1 for faster path (mainly used by ai)
+}
 
+std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	return make_safe_land_path_impl<false>(state, start, end, nation_as);
+}
+std::vector<dcon::province_id> make_safe_land_path_estimate(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	return make_safe_land_path_impl<true>(state, start, end, nation_as);
 }
 
 // used for land trade (is allowed to path though sea provinces though)
@@ -2537,12 +2945,338 @@ std::vector<dcon::province_id> make_naval_unit_path(sys::state& state, dcon::pro
 		return distance * military::get_avg_movement_cost_modifier(state, nation_as, from, to);
 	};
 
-	return make_path_to_prov<1.0f>(state, start, end, adjacency_func, province_func, modifier_func); // use default heuristic mod 1.0f as the heuristic is permissble due to no movement_cost modifiers in sea provs
+	return make_path_to_prov<landmark_heuristic>(state, start, end, adjacency_func, province_func, modifier_func); // the landmark bound is permissible due to no movement_cost modifiers in sea provs, and is much closer than the direct distance around continents
+
+}
+
+void fill_safe_land_distance_field(sys::state& state, dcon::nation_id nation_as, search_direction direction, std::span<dcon::province_id const> sources, distance_field& field, std::span<dcon::province_id const> wanted) {
+
+	auto adjacency_func = [&](dcon::province_id to, dcon::province_id from, dcon::province_adjacency_id adj) {
+		return !is_adjacency_impassable(state, nation_as, adj);
+	};
+	auto province_func = [&](dcon::province_id to) {
+		if(to.index() < state.province_definitions.first_sea_province.index()) { // is land
+			return state.world.province_get_siege_progress(to) == 0 && has_safe_access_to_province(state, nation_as, to);
+		} else {
+			return false; // cannot embark on ships as we cannot know the exact army size
+		}
+	};
+	auto modifier_func = [&](dcon::province_id to, dcon::province_id from, dcon::province_adjacency_id adj, float distance) {
+		return distance * military::get_avg_movement_cost_modifier(state, nation_as, from, to);
+	};
+
+	if(direction == search_direction::from_sources)
+		fill_distance_field<search_direction::from_sources>(state, sources, adjacency_func, province_func, modifier_func, field, wanted);
+	else
+		fill_distance_field<search_direction::to_sources>(state, sources, adjacency_func, province_func, modifier_func, field, wanted);
+}
+
+uint64_t region_cluster_key(sys::state& state, dcon::province_id p) {
+	auto def = state.world.province_get_state_from_abstract_state_membership(p);
+	if(p.index() >= state.province_definitions.first_sea_province.index() || !def)
+		return (uint64_t(1) << 63) | uint64_t(p.index()); // a cluster of its own
+	auto controller = state.world.province_get_nation_from_province_control(p);
+	return (uint64_t(def.index()) << 32) | uint64_t(uint32_t(controller.index() + 1));
+}
+
+void refresh_region_cluster(sys::state& state, region_hierarchy& hierarchy, uint32_t c) {
+	auto& cluster = hierarchy.clusters[c];
+	cluster.portals.clear();
+	cluster.center = dcon::province_id{ };
+
+	float best_spread = std::numeric_limits<float>::max();
+	for(auto p : cluster.provinces) {
+		for(auto& e : state.adjacency_graph.neighbors(p)) {
+			if((e.type & province::border::impassible_bit) != 0)
+				continue;
+			auto other_cluster = hierarchy.province_cluster[e.neighbor.index()];
+			if(other_cluster != c)
+				cluster.portals.push_back(region_hierarchy::portal{ e.adjacency, p, e.neighbor, other_cluster });
+		}
+
+		float spread = 0.0f;
+		for(auto q : cluster.provinces)
+			spread = std::max(spread, direct_distance(state, p, q));
+		if(spread < best_spread) {
+			best_spread = spread;
+			cluster.center = p;
+		}
+	}
+}
+
+void rebuild_region_hierarchy(sys::state& state, region_hierarchy& result) {
+	result.clusters.clear();
+	result.free_clusters.clear();
+	result.cluster_by_key.clear();
+	result.province_cluster.assign(state.world.province_size(), 0);
+
+	for(auto p : state.world.in_province) {
+		auto key = region_cluster_key(state, p.id);
+		uint32_t c = 0;
+		if(auto it = result.cluster_by_key.find(key); it != result.cluster_by_key.end()) {
+			c = it->second;
+		} else {
+			c = uint32_t(result.clusters.size());
+			result.clusters.emplace_back();
+			result.clusters.back().key = key;
+			result.cluster_by_key.insert_or_assign(key, c);
+		}
+		result.clusters[c].provinces.push_back(p.id); // provinces are visited in order, so this stays sorted
+		result.province_cluster[p.id.index()] = c;
+	}
+	for(uint32_t c = 0; c < result.clusters.size(); ++c)
+		refresh_region_cluster(state, result, c);
+}
+
+void update_region_hierarchy(sys::state& state) {
+	auto& hierarchy = state.region_hierarchy;
+	if(!hierarchy.has_pending.load(std::memory_order_acquire))
+		return;
+
+	std::unique_lock write_guard{ hierarchy.lock };
+	std::vector<dcon::province_id> changed;
+	bool full_rebuild = false;
+	{
+		std::lock_guard guard{ hierarchy.pending_lock };
+		changed.swap(hierarchy.pending);
+		full_rebuild = hierarchy.pending_full_rebuild || hierarchy.province_cluster.size() != state.world.province_size();
+		hierarchy.pending_full_rebuild = false;
+		hierarchy.has_pending.store(false, std::memory_order_release);
+	}
+	state.path_cache.hierarchy_changed();
+
+	if(full_rebuild) {
+		rebuild_region_hierarchy(state, hierarchy);
+		return;
+	}
+
+	auto by_index = [](dcon::province_id a, dcon::province_id b) { return a.index() < b.index(); };
+	std::vector<uint32_t> touched;
+	for(auto p : changed) {
+		auto old_cluster = hierarchy.province_cluster[p.index()];
+		auto key = region_cluster_key(state, p);
+		touched.push_back(old_cluster);
+		if(hierarchy.clusters[old_cluster].key == key)
+			continue;
+
+		auto& old_members = hierarchy.clusters[old_cluster].provinces;
+		old_members.erase(std::lower_bound(old_members.begin(), old_members.end(), p, by_index));
+		if(old_members.empty()) {
+			hierarchy.cluster_by_key.erase(hierarchy.clusters[old_cluster].key);
+			hierarchy.free_clusters.push_back(old_cluster);
+		}
+
+		uint32_t new_cluster = 0;
+		if(auto it = hierarchy.cluster_by_key.find(key); it != hierarchy.cluster_by_key.end()) {
+			new_cluster = it->second;
+		} else if(!hierarchy.free_clusters.empty()) {
+			new_cluster = hierarchy.free_clusters.back();
+			hierarchy.free_clusters.pop_back();
+			hierarchy.clusters[new_cluster].key = key;
+			hierarchy.cluster_by_key.insert_or_assign(key, new_cluster);
+		} else {
+			new_cluster = uint32_t(hierarchy.clusters.size());
+			hierarchy.clusters.emplace_back();
+			hierarchy.clusters.back().key = key;
+			hierarchy.cluster_by_key.insert_or_assign(key, new_cluster);
+		}
+		auto& new_members = hierarchy.clusters[new_cluster].provinces;
+		new_members.insert(std::lower_bound(new_members.begin(), new_members.end(), p, by_index), p);
+		hierarchy.province_cluster[p.index()] = new_cluster;
+		touched.push_back(new_cluster);
+	}
+	// portals of the neighbors may now lead into a different cluster
+	for(auto p : changed) {
+		for(auto& e : state.adjacency_graph.neighbors(p)) {
+			touched.push_back(hierarchy.province_cluster[e.neighbor.index()]);
+		}
+	}
+
+	std::sort(touched.begin(), touched.end());
+	touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+	for(auto c : touched)
+		refresh_region_cluster(state, hierarchy, c);
+}
+
+namespace cached {
+
+uint64_t path_key(path_kind kind, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	return (uint64_t(kind) << 48)
+		| (uint64_t(uint16_t(nation_as.index())) << 32)
+		| (uint64_t(uint16_t(start.index())) << 16)
+		| uint64_t(uint16_t(end.index()));
+}
+
+// one bit per sea strait which an enemy fleet of nation_as currently blockades
+void find_blocked_straits(sys::state& state, dcon::nation_id nation_as, std::vector<uint64_t>& result) {
+	auto& cache = state.path_cache;
+	if(!cache.straits_ready.load(std::memory_order_acquire)) {
+		std::lock_guard lock{ cache.straits_lock };
+		if(!cache.straits_ready.load(std::memory_order_relaxed)) {
+			cache.straits.clear();
+			for(auto adj : state.world.in_province_adjacency) {
+				auto strait_prov = adj.get_canal_or_blockade_province();
+				if(strait_prov && strait_prov.id.index() >= state.province_definitions.first_sea_province.index())
+					cache.straits.push_back(strait_prov.id);
+			}
+			std::sort(cache.straits.begin(), cache.straits.end(), [](auto a, auto b) { return a.index() < b.index(); });
+			cache.straits.erase(std::unique(cache.straits.begin(), cache.straits.end()), cache.straits.end());
+			cache.straits_ready.store(true, std::memory_order_release);
+		}
+	}
+
+	auto epoch = cache.epoch.load(std::memory_order_acquire);
+	auto fleet_epoch = cache.fleet_epoch.load(std::memory_order_acquire);
+	{
+		std::shared_lock lock{ cache.blocked_straits_lock };
+		if(uint32_t(nation_as.index()) < cache.blocked_straits.size()) {
+			auto& entry = cache.blocked_straits[nation_as.index()];
+			if(entry.epoch == epoch && entry.fleet_epoch == fleet_epoch) {
+				result = entry.bits;
+				return;
+			}
+		}
+	}
+
+	result.assign((cache.straits.size() + 63) / 64, uint64_t(0));
+	for(uint32_t i = 0; i < cache.straits.size(); ++i) {
+		if(military::province_has_enemy_fleet(state, cache.straits[i], nation_as))
+			result[i / 64] |= uint64_t(1) << (i % 64);
+	}
+
+	std::unique_lock lock{ cache.blocked_straits_lock };
+	if(cache.epoch.load(std::memory_order_acquire) != epoch || cache.fleet_epoch.load(std::memory_order_acquire) != fleet_epoch)
+		return; // a fleet moved or the situation changed during the scan
+	if(cache.blocked_straits.size() < state.world.nation_size())
+		cache.blocked_straits.resize(state.world.nation_size());
+	auto& entry = cache.blocked_straits[nation_as.index()];
+	entry.epoch = epoch;
+	entry.fleet_epoch = fleet_epoch;
+	entry.bits = result;
+}
+
+// the dependency epochs of a search which just ran on this thread
+// a province search reads the controller of every province it gives a node to, which is the start, the end and every neighbor of a
+// province it expanded; if it stopped before its first step, the nodes left from an earlier search only add dependencies
+void find_path_dependencies(sys::state& state, path_kind kind, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, std::vector<path_cache::dependency>& result) {
+	auto& cache = state.path_cache;
+	result.clear();
+	auto add = [&](uint32_t slot) {
+		result.push_back(path_cache::dependency{ slot, cache.dependency_epochs[slot].load(std::memory_order_acquire) });
+	};
+
+	if(kind == path_kind::land_trade) // only the map and the buildings along the way matter
+		return;
+	add(path_cache::relations_slot(nation_as));
+	if(kind == path_kind::safe_land_estimate) { // several searches share the workspace, so the provinces looked at are not known
+		add(path_cache::any_territory_slot);
+		add(path_cache::hierarchy_slot);
+		return;
+	}
+
+	static thread_local std::vector<uint8_t> slot_added;
+	slot_added.assign(path_cache::nation_slots, uint8_t(0));
+	auto add_controller = [&](dcon::province_id p) {
+		auto slot = path_cache::territory_slot(state.world.province_get_nation_from_province_control(p));
+		if(!slot_added[slot]) {
+			slot_added[slot] = 1;
+			add(slot);
+		}
+	};
+	add_controller(start);
+	add_controller(end);
+	auto& workspace = path_workspace::for_this_thread();
+	auto province_count = std::min(uint32_t(workspace.nodes.size()), state.world.province_size());
+	for(uint32_t i = 0; i < province_count; ++i) {
+		if(workspace.nodes[i].generation == workspace.generation)
+			add_controller(dcon::province_id{ dcon::province_id::value_base_t(i) });
+	}
+}
+
+template<typename F>
+std::vector<dcon::province_id> find_cached_path(sys::state& state, path_kind kind, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, F&& find_path) {
+	auto& cache = state.path_cache;
+	auto key = path_key(kind, start, end, nation_as);
+	auto& shard = cache.shards[(key * 0x9E3779B97F4A7C15ull) >> 60];
+	static_assert(path_cache::shard_count == 16);
+
+	static thread_local std::vector<uint64_t> blocked_straits;
+	blocked_straits.clear();
+	if(kind != path_kind::land_trade) // trade paths do not check for blocked crossings
+		find_blocked_straits(state, nation_as, blocked_straits);
+
+	auto epoch = cache.epoch.load(std::memory_order_acquire);
+	auto dependency_changes = cache.dependency_changes.load(std::memory_order_acquire);
+	{
+		std::shared_lock lock{ shard.lock };
+		if(shard.epoch == epoch) {
+			if(auto it = shard.entries.find(key); it != shard.entries.end() && it->second.blocked_straits == blocked_straits && cache.is_current(it->second.dependencies))
+				return it->second.path;
+		}
+	}
+
+	auto result = find_path();
+	static thread_local std::vector<path_cache::dependency> dependencies;
+	find_path_dependencies(state, kind, start, end, nation_as, dependencies);
+	if(cache.dependency_changes.load(std::memory_order_acquire) != dependency_changes)
+		return result; // the epochs read afterwards may be newer than the situation the search saw
+
+	{
+		std::unique_lock lock{ shard.lock };
+		if(shard.epoch != epoch) {
+			if(cache.epoch.load(std::memory_order_acquire) != epoch)
+				return result; // invalidated during the search
+			shard.entries.clear();
+			shard.epoch = epoch;
+		}
+		if(shard.entries.size() >= path_cache::max_shard_entries)
+			shard.entries.clear();
+		shard.entries.insert_or_assign(key, path_cache::entry{ result, blocked_straits, dependencies });
+	}
+	return result;
+}
+
+std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	return find_cached_path(state, path_kind::safe_land, start, end, nation_as, [&]() {
+		return province::make_safe_land_path(state, start, end, nation_as);
+	});
+}
+std::vector<dcon::province_id> make_safe_land_path_estimate(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	return find_cached_path(state, path_kind::safe_land_estimate, start, end, nation_as, [&]() {
+		return province::make_safe_land_path_estimate(state, start, end, nation_as);
+	});
+}
+std::vector<dcon::province_id> make_naval_unit_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	return find_cached_path(state, path_kind::naval_unit, start, end, nation_as, [&]() {
+		return province::make_naval_unit_path(state, start, end, nation_as);
+	});
+}
+std::vector<dcon::province_id> make_land_trade_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
+	return find_cached_path(state, path_kind::land_trade, start, end, dcon::nation_id{}, [&]() {
+		return province::make_land_trade_path(state, start, end);
+	});
+}
+void make_sea_trade_route_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result) {
+	auto& cache = state.sea_trade_paths;
+	auto key = (uint64_t(start.value) << 32) | uint64_t(end.value);
+	{
+		std::shared_lock lock{ cache.lock };
+		if(auto it = cache.paths.find(key); it != cache.paths.end()) {
+			path_result = it->second;
+			return;
+		}
+	}
+
+	province::make_sea_trade_route_path(state, start, end, path_result);
+
+	std::unique_lock lock{ cache.lock };
+	cache.paths.try_emplace(key, path_result);
+}
 
 }
 
 // for sea trade routes
-std::vector<dcon::province_id> make_sea_trade_route_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
+void make_sea_trade_route_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result) {
 
 	auto adjacency_func = [&](dcon::province_id to, dcon::province_id from, dcon::province_adjacency_id adj) {
 		auto bits = state.world.province_adjacency_get_type(adj);
@@ -2580,9 +3314,14 @@ std::vector<dcon::province_id> make_sea_trade_route_path(sys::state& state, dcon
 		return distance;
 	};
 
-	return make_path_to_prov<1.0f>(state, start, end, adjacency_func, province_func, modifier_func); // use default heuristic mod 1.0f to prio faster paths over accurate ones
+	make_path_to_prov<1.0f>(state, start, end, adjacency_func, province_func, modifier_func, path_result); // use default heuristic mod 1.0f to prio faster paths over accurate ones
 
 }
+std::vector<dcon::province_id> make_sea_trade_route_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
+	std::vector<dcon::province_id> path_result;
+	make_sea_trade_route_path(state, start, end, path_result);
+	return path_result;
+}
 
 
 std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
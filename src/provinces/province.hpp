@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include "dcon_generated_ids.hpp"
 #include "constants_dcon.hpp"
 #include "unordered_dense.h"
@@ -31,8 +32,19 @@ bool sea_province_is_adjacent_to_accessible_coast(sys::state& state, dcon::provi
 
 bool nations_are_adjacent(sys::state& state, dcon::nation_id a, dcon::nation_id b);
 bool provinces_are_adjacent(sys::state& state, dcon::province_id a, dcon::province_id b);
+// state.adjacency_graph; the second one copies a changed adjacency type into it
+void rebuild_adjacency_graph(sys::state& state);
+void refresh_adjacency_graph_type(sys::state& state, dcon::province_adjacency_id adj);
+// state.distance_oracle; needs the adjacency graph
+void rebuild_distance_oracle(sys::state& state);
+// lower bound of the length of any path between a and b whose steps cost at least the distance of their adjacency
+float landmark_lower_bound(sys::state& state, dcon::province_id a, dcon::province_id b);
 void update_connected_regions(sys::state& state);
 void update_cached_values(sys::state& state);
+// queue a province whose owner, controller or colonial status changed, or a nation whose capital moved, for update_cached_values
+// the province is marked with its current owner, so call it before an ownership change as well as after; serial parts of the update only
+void mark_cached_values_dirty(sys::state& state, dcon::province_id p);
+void mark_cached_values_dirty(sys::state& state, dcon::nation_id n);
 void update_blockaded_cache(sys::state& state);
 void restore_unsaved_values(sys::state& state);
 void restore_distances(sys::state& state);
@@ -139,6 +151,9 @@ bool make_land_unit_path_province_valid(sys::state& state, dcon::nation_id natio
 std::vector<dcon::province_id> make_land_unit_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a);
 // pathfind through non-enemy controlled, not under siege provinces
 std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
+// the same rules through make_hierarchical_path_to_prov: long routes are found faster but can be somewhat longer, so use it only to
+// check whether a route exists or to estimate its length, never to move units
+std::vector<dcon::province_id> make_safe_land_path_estimate(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
 std::vector<dcon::province_id> make_land_trade_path(sys::state& state, dcon::province_id start, dcon::province_id end);
 // creates a path in which only impassable provinces and sea provinces obstructs pathing
 std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end);
@@ -153,6 +168,7 @@ bool make_naval_unit_path_province_valid(sys::state& state, dcon::nation_id nati
 std::vector<dcon::province_id> make_naval_unit_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
 //for sea trade routes
 std::vector<dcon::province_id> make_sea_trade_route_path(sys::state& state, dcon::province_id start, dcon::province_id end);
+void make_sea_trade_route_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result);
 //naval retreats
 std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start);
 // For clicking on the retreat button, or forced retreats
@@ -170,5 +186,37 @@ std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& st
 
 void set_province_controller(sys::state& state, dcon::province_id p, dcon::nation_id n);
 void set_province_controller(sys::state& state, dcon::province_id p, dcon::rebel_faction_id rf);
+struct controller_change {
+	dcon::province_id province;
+	dcon::nation_id nation;
+	dcon::rebel_faction_id rebels; // when set, the rebels take control instead of the nation
+};
+// applies the changes in order, as the calls above would, but marks the follow-ups they share (paths, region hierarchy, cached
+// values of each owner, black flags) once for the whole batch
+void set_province_controllers(sys::state& state, std::span<const controller_change> changes);
+
+enum class search_direction : uint8_t {
+	from_sources, to_sources
+};
+struct distance_field;
+// fill a distance field under the rules of make_safe_land_path, see fill_distance_field; the ai gathers its attackers along it
+// the routes of a field are the shortest ones, so they can differ from what make_safe_land_path returns for the same pair
+void fill_safe_land_distance_field(sys::state& state, dcon::nation_id nation_as, search_direction direction, std::span<dcon::province_id const> sources, distance_field& field, std::span<dcon::province_id const> wanted = { });
+
+struct region_hierarchy;
+// applies the control and adjacency changes queued in state.region_hierarchy; game thread only, next to update_connected_regions, so that searches never wait for it
+void update_region_hierarchy(sys::state& state);
+// builds a hierarchy from scratch, ignoring anything queued
+void rebuild_region_hierarchy(sys::state& state, region_hierarchy& result);
+
+// the same searches served from state.path_cache; for game logic only, as results are kept between ticks
+// make_land_unit_path is not cached: it depends on the positions of enemy armies and on friendly transports
+namespace cached {
+std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
+std::vector<dcon::province_id> make_safe_land_path_estimate(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
+std::vector<dcon::province_id> make_naval_unit_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
+std::vector<dcon::province_id> make_land_trade_path(sys::state& state, dcon::province_id start, dcon::province_id end);
+void make_sea_trade_route_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result);
+}
 
 } // namespace province
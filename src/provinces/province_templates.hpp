@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include "system_state.hpp"
 #include "province.hpp"
 
@@ -118,95 +119,176 @@ struct province_and_distance {
 
 
 
-struct path_node_heuristic {
+struct region_path_node {
 	float distance_covered = 0.0f;
 	float distance_to_target = 0.0f;
-	dcon::province_id province = dcon::province_id{ };
-	dcon::province_id parent = dcon::province_id{ };
+	uint32_t parent = 0;
+	uint32_t generation = 0;
 	bool is_in_closed_list = false;
 	bool is_in_open_list = false;
+};
 
-	bool operator<(path_node_heuristic const& other) const noexcept {
-		if(other.distance_covered != distance_covered)
-			return distance_covered + distance_to_target < other.distance_covered + other.distance_to_target;
-		return province.index() < other.province.index();
+// scratch memory for the province searches, one per thread as both the ui and the update thread calculate paths
+// a node belongs to the current search only if its generation matches, so starting a search does not have to clear every province
+// the open queue is kept with std::push_heap and std::pop_heap like the original per search buffers, and a shorter route to a queued province only updates its node, so the searches visit provinces in the same order as before
+// searches must not be nested, as they would share the same workspace
+struct path_workspace {
+	struct node {
+		float distance_covered = 0.0f;
+		float distance_to_target = 0.0f;
+		dcon::province_id parent = dcon::province_id{ };
+		uint32_t generation = 0;
+		bool is_in_closed_list = false;
+		bool is_in_open_list = false;
+	};
+
+	std::vector<node> nodes;
+	std::vector<dcon::province_id> open_queue;
+	std::vector<region_path_node> cluster_nodes; // the cluster search of make_hierarchical_path_to_prov, which is done before it refines the route with a province search
+	std::vector<uint32_t> cluster_queue;
+	uint32_t generation = 0;
+	uint32_t cluster_generation = 0;
+	uint64_t provinces_expanded = 0; // provinces taken from the open queue over the life of the thread, read by the pathfinding benchmark
+
+	static path_workspace& for_this_thread() {
+		static thread_local path_workspace workspace;
+		return workspace;
 	}
-	bool operator>(path_node_heuristic const& other) const noexcept {
-		if(other.distance_covered != distance_covered)
-			return distance_covered + distance_to_target > other.distance_covered + other.distance_to_target;
-		return province.index() > other.province.index();
+
+	void begin_search(uint32_t province_count) {
+		if(nodes.size() < province_count)
+			nodes.resize(province_count);
+		open_queue.clear();
+		++generation;
+		if(generation == 0) { // wrapped around; stale stamps could look current again
+			for(auto& n : nodes)
+				n.generation = 0;
+			generation = 1;
+		}
+	}
+	// the node of the province, reset first if it was last touched by an earlier search
+	node& get(dcon::province_id p) {
+		auto& n = nodes[p.index()];
+		if(n.generation != generation) {
+			n = node{ };
+			n.generation = generation;
+		}
+		return n;
+	}
+	void begin_cluster_search(uint32_t cluster_count) {
+		if(cluster_nodes.size() < cluster_count)
+			cluster_nodes.resize(cluster_count);
+		cluster_queue.clear();
+		++cluster_generation;
+		if(cluster_generation == 0) {
+			for(auto& n : cluster_nodes)
+				n.generation = 0;
+			cluster_generation = 1;
+		}
+	}
+	region_path_node& get_cluster(uint32_t c) {
+		auto& n = cluster_nodes[c];
+		if(n.generation != cluster_generation) {
+			n = region_path_node{ };
+			n.generation = cluster_generation;
+		}
+		return n;
+	}
+	dcon::province_id parent_of(dcon::province_id p) const {
+		auto& n = nodes[p.index()];
+		return n.generation == generation ? n.parent : dcon::province_id{ };
+	}
+
+	// ComesAfter is the heap comparison: it takes two queued provinces and returns true if the first one should be processed after the second
+	template<typename ComesAfter>
+	void push(dcon::province_id p, ComesAfter const& comes_after) {
+		nodes[p.index()].is_in_open_list = true;
+		open_queue.push_back(p);
+		std::push_heap(open_queue.begin(), open_queue.end(), comes_after);
+	}
+	template<typename ComesAfter>
+	dcon::province_id pop(ComesAfter const& comes_after) {
+		++provinces_expanded;
+		std::pop_heap(open_queue.begin(), open_queue.end(), comes_after);
+		auto top = open_queue.back();
+		open_queue.pop_back();
+		nodes[top.index()].is_in_open_list = false;
+		return top;
 	}
 };
 
-// Creates a path from start province to end province,with given template functions to decide various factors
-// HeuristicModifier: Modifier to the heuristic used (direct distance). The higher this value is, the less accurate but more performant the pathfinding will be. If 0.0f, it will always find the optimal path
+// pass as the HeuristicModifier of the searches below to estimate the remaining distance with the larger of landmark_lower_bound and the direct distance
+// the estimate never exceeds the real remaining cost when every step costs at least the distance of its adjacency, so the shortest path is found while expanding fewer provinces
+inline constexpr float landmark_heuristic = -1.0f;
+
+template<float HeuristicModifier>
+float remaining_distance_estimate(sys::state& state, dcon::province_id from, dcon::province_id end) {
+	if constexpr(HeuristicModifier == landmark_heuristic) {
+		return std::max(landmark_lower_bound(state, from, end), direct_distance(state, from, end));
+	} else {
+		return direct_distance(state, from, end) * HeuristicModifier;
+	}
+}
+
+// Creates a path from start province to end province,with given template functions to decide various factors. The path is written into path_result, which is cleared first, so callers can reuse its memory
+// HeuristicModifier: Modifier to the heuristic used (direct distance). The higher this value is, the less accurate but more performant the pathfinding will be. If 0.0f, it will always find the optimal path. landmark_heuristic uses the landmark table instead
 // AdjFunc: Lambda which takes the following as parameters (to_prov, from_prov, adjacency)  and returns a bool. Decides if the passage between the two provinces is possible.
 // ProvFunc: Lambda which takes a province_id as parameter and returns a bool. Decides if the given province is passable from any direction
 // MovementCostFunc: Lambda which takes the following as parameters (to_prov, from_prov, adjacency, distance) and returns a float. The returned value is used as movement cost in pathfinding
 template<float HeuristicModifier, typename AdjFunc, typename ProvFunc, typename MovementCostFunc>
-std::vector<dcon::province_id> make_path_to_prov(sys::state& state, dcon::province_id start, dcon::province_id end, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func) {
+void make_path_to_prov(sys::state& state, dcon::province_id start, dcon::province_id end, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, std::vector<dcon::province_id>& path_result) {
 
 	// uses an A* implementation with direct distance as heuristic
 
-	std::vector<dcon::province_id> path_result;
+	path_result.clear();
 
 	if(start == end || !prov_func(end)) // early exit if start is already at destination, or if the end province would fail the province check
-		return path_result;
-
-
-	std::vector<dcon::province_id> open_queue; // prioity queue of nodes to be processed, ordered by computed distance. Smallest distance goes first
-	// contains nodes for all provinces, including if they are in the open queue, are closed and its parent for constructing path later. It is allocated as a static thread local buffer, as it is possible both the UI and update thread will calculate paths
-	static thread_local tagged_vector<path_node_heuristic, dcon::province_id> path_node_container;
-
-	path_node_container.resize(state.world.province_size());
-	std::memset(path_node_container.data(), 0, sizeof(path_node_heuristic) * path_node_container.size()); // memset incase it was used earlier
-
-
-	auto province_comparer = [&](dcon::province_id a, dcon::province_id b) {
-		return path_node_container[a] > path_node_container[b];
-		};
+		return;
+
+	// contains nodes for the provinces touched by this search, including if they are in the open queue, are closed and its parent for constructing path later
+	auto& workspace = path_workspace::for_this_thread();
+	workspace.begin_search(state.world.province_size());
+
+	// smallest estimated total distance goes first; provinces with the same distance covered are ordered by index
+	auto comes_after = [&](dcon::province_id a, dcon::province_id b) {
+		auto& node_a = workspace.nodes[a.index()];
+		auto& node_b = workspace.nodes[b.index()];
+		if(node_a.distance_covered != node_b.distance_covered)
+			return node_a.distance_covered + node_a.distance_to_target > node_b.distance_covered + node_b.distance_to_target;
+		return a.index() > b.index();
+	};
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = path_node_container[i].parent;
+			i = workspace.nodes[i.index()].parent;
 		}
-		};
+	};
 	auto assert_path_result = [](std::vector<dcon::province_id>& v) {
 		for(auto const e : v)
 			assert(bool(e));
-		};
-	auto& start_node = path_node_container[start];
-	start_node.distance_covered = 0.0f;
-	start_node.distance_to_target = 0.0f;
-	start_node.is_in_closed_list = false;
-	start_node.is_in_open_list = true;
-	start_node.parent = dcon::province_id{ };
-	start_node.province = start;
-
-	open_queue.push_back(start);
-	while(open_queue.size() > 0) {
-		std::pop_heap(open_queue.begin(), open_queue.end(), province_comparer);
-		auto current_prov = open_queue.back();
-		open_queue.pop_back();
-		auto& current_node = path_node_container[current_prov];
-		current_node.is_in_open_list = false;
+	};
+
+	workspace.get(start);
+	workspace.push(start, comes_after);
+	while(workspace.open_queue.size() > 0) {
+		auto current_prov = workspace.pop(comes_after);
+		auto& current_node = workspace.nodes[current_prov.index()];
 		// check if we have reached the end
 		if(current_prov == end) {
 			fill_path_result(current_prov);
 			assert_path_result(path_result);
-			return path_result;
+			return;
 		}
 		// add current to closed list immediately
 		current_node.is_in_closed_list = true;
 
-		for(auto adj : state.world.province_get_province_adjacency(current_prov)) {
-			auto other_prov =
-				adj.get_connected_provinces(0) == current_prov ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
-			auto bits = adj.get_type();
-			auto distance = adj.get_distance();
+		for(auto& edge : state.adjacency_graph.neighbors(current_prov)) {
+			auto other_prov = edge.neighbor;
+			auto adj = edge.adjacency;
+			auto distance = edge.distance;
 
-			auto& neighbor_node = path_node_container[other_prov];
+			auto& neighbor_node = workspace.get(other_prov);
 
 			// check if not present in the closed list, and passes the adjacency check (aka the specific adjacency is passable). It is not added to the closed list if the adj check fails as it may be passable from a diffrent adjacency
 			if(!neighbor_node.is_in_closed_list && adj_func(other_prov, current_prov, adj)) {
@@ -214,32 +296,21 @@ std::vector<dcon::province_id> make_path_to_prov(sys::state& state, dcon::provin
 				if(prov_func(other_prov)) {
 					float actual_dist = movementcost_func(other_prov, current_prov, adj, distance); // to and from province
 					float distance_to_neighbor = current_node.distance_covered + actual_dist; // computes net distance to neighbor from the start province
-					float approx_dist_to_end;
-					if constexpr(HeuristicModifier != 0.0f) {
-						approx_dist_to_end = direct_distance(state, other_prov, end) * HeuristicModifier;
-					}
-					else {
-						approx_dist_to_end = 0.0f;
-					}
-					
+
 					// if not present in the open queue add it to the open queue for processing later
 					if(!neighbor_node.is_in_open_list) {
 						// set distance and parent, then add it to the open queue
 						neighbor_node.distance_covered = distance_to_neighbor;
-						neighbor_node.distance_to_target = approx_dist_to_end;
+						if constexpr(HeuristicModifier != 0.0f) {
+							neighbor_node.distance_to_target = remaining_distance_estimate<HeuristicModifier>(state, other_prov, end);
+						}
 						neighbor_node.parent = current_prov;
-						neighbor_node.province = other_prov; // set province now, before it is added to the open queue
-						open_queue.push_back(other_prov);
-						std::push_heap(open_queue.begin(), open_queue.end(), province_comparer);
-						neighbor_node.is_in_open_list = true;
+						workspace.push(other_prov, comes_after);
 					} else if(distance_to_neighbor < neighbor_node.distance_covered) {
 						// this is a better path; update distance covered and parent
 						neighbor_node.distance_covered = distance_to_neighbor;
-						neighbor_node.distance_to_target = approx_dist_to_end;
 						neighbor_node.parent = current_prov;
 					}
-
-
 				} else {
 					neighbor_node.is_in_closed_list = true;// exclude it from being checked again
 				}
@@ -248,12 +319,132 @@ std::vector<dcon::province_id> make_path_to_prov(sys::state& state, dcon::provin
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+}
 
+template<float HeuristicModifier, typename AdjFunc, typename ProvFunc, typename MovementCostFunc>
+std::vector<dcon::province_id> make_path_to_prov(sys::state& state, dcon::province_id start, dcon::province_id end, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func) {
+	std::vector<dcon::province_id> path_result;
+	make_path_to_prov<HeuristicModifier>(state, start, end, adj_func, prov_func, movementcost_func, path_result);
+	return path_result;
 }
 
 
 
+// Creates a path like make_path_to_prov, but searches the clusters of state.region_hierarchy first and then refines the route only through the provinces of the clusters along it and of their neighbors
+// The path is not always the shortest one, but long searches expand far fewer provinces. Searches between neighboring clusters, and searches whose corridor turns out to be blocked, fall back to make_path_to_prov
+// The template parameters are the same as make_path_to_prov; AdjFunc must also reject impassable adjacencies, as those are never portals between clusters
+template<float HeuristicModifier, typename AdjFunc, typename ProvFunc, typename MovementCostFunc>
+std::vector<dcon::province_id> make_hierarchical_path_to_prov(sys::state& state, dcon::province_id start, dcon::province_id end, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func) {
+
+	if(start == end || !prov_func(end))
+		return std::vector<dcon::province_id>{ };
+
+	// the clusters are only brought up to date on the game thread, by update_region_hierarchy; until then they may still reflect an older controller of some provinces,
+	// which only makes the corridor a worse guess, as every province along the refined path is still checked
+	auto& hierarchy = state.region_hierarchy;
+	std::shared_lock read_guard{ hierarchy.lock };
+	if(hierarchy.province_cluster.size() != state.world.province_size()) // not built yet for this map
+		return make_path_to_prov<HeuristicModifier>(state, start, end, adj_func, prov_func, movementcost_func);
+
+	auto start_cluster = hierarchy.province_cluster[start.index()];
+	auto end_cluster = hierarchy.province_cluster[end.index()];
+	bool is_nearby = start_cluster == end_cluster;
+	for(auto& portal : hierarchy.clusters[start_cluster].portals)
+		is_nearby = is_nearby || portal.to_cluster == end_cluster;
+	if(is_nearby)
+		return make_path_to_prov<HeuristicModifier>(state, start, end, adj_func, prov_func, movementcost_func);
+
+	// A* over the clusters, with distances measured between their centers. A cluster is entered through any portal which passes the same checks as a single step of the province search,
+	// so if no route between the clusters exists, no path between the provinces exists either
+	auto& workspace = path_workspace::for_this_thread();
+	workspace.begin_cluster_search(uint32_t(hierarchy.clusters.size()));
+	auto& cluster_nodes = workspace.cluster_nodes;
+
+	auto position_of = [&](uint32_t c) {
+		return c == start_cluster ? start : hierarchy.clusters[c].center;
+	};
+	// ties are broken by the center province, so that the result does not depend on how the clusters happen to be numbered
+	auto cluster_comparer = [&](uint32_t a, uint32_t b) {
+		auto& na = cluster_nodes[a];
+		auto& nb = cluster_nodes[b];
+		if(na.distance_covered + na.distance_to_target != nb.distance_covered + nb.distance_to_target)
+			return na.distance_covered + na.distance_to_target > nb.distance_covered + nb.distance_to_target;
+		return position_of(a).index() > position_of(b).index();
+	};
+
+	auto& open_queue = workspace.cluster_queue;
+	workspace.get_cluster(start_cluster).is_in_open_list = true;
+	open_queue.push_back(start_cluster);
+	bool found = false;
+	while(open_queue.size() > 0) {
+		std::pop_heap(open_queue.begin(), open_queue.end(), cluster_comparer);
+		auto current = open_queue.back();
+		open_queue.pop_back();
+		auto& current_node = cluster_nodes[current];
+		current_node.is_in_open_list = false;
+		if(current == end_cluster) {
+			found = true;
+			break;
+		}
+		current_node.is_in_closed_list = true;
+
+		for(auto& portal : hierarchy.clusters[current].portals) {
+			auto& neighbor_node = workspace.get_cluster(portal.to_cluster);
+			if(neighbor_node.is_in_closed_list || !adj_func(portal.to, portal.from, portal.adjacency) || !prov_func(portal.to))
+				continue;
+
+			auto neighbor_position = portal.to_cluster == end_cluster ? end : hierarchy.clusters[portal.to_cluster].center;
+			float distance_to_neighbor = current_node.distance_covered + direct_distance(state, position_of(current), neighbor_position);
+			if(!neighbor_node.is_in_open_list) {
+				neighbor_node.distance_covered = distance_to_neighbor;
+				if constexpr(HeuristicModifier != 0.0f) {
+					neighbor_node.distance_to_target = remaining_distance_estimate<HeuristicModifier>(state, neighbor_position, end);
+				}
+				neighbor_node.parent = current;
+				neighbor_node.is_in_open_list = true;
+				open_queue.push_back(portal.to_cluster);
+				std::push_heap(open_queue.begin(), open_queue.end(), cluster_comparer);
+			} else if(distance_to_neighbor < neighbor_node.distance_covered) {
+				neighbor_node.distance_covered = distance_to_neighbor;
+				neighbor_node.parent = current;
+				std::make_heap(open_queue.begin(), open_queue.end(), cluster_comparer);
+			}
+		}
+	}
+	if(!found)
+		return std::vector<dcon::province_id>{ };
+
+	// the corridor: every cluster on the route, widened by its neighbors so that the refined path can cut corners
+	static thread_local std::vector<uint8_t> in_corridor;
+	static thread_local std::vector<uint32_t> corridor;
+	in_corridor.resize(hierarchy.clusters.size(), 0);
+	corridor.clear();
+	auto add_to_corridor = [&](uint32_t c) {
+		if(!in_corridor[c]) {
+			in_corridor[c] = 1;
+			corridor.push_back(c);
+		}
+	};
+	for(auto c = end_cluster; ; c = cluster_nodes[c].parent) {
+		add_to_corridor(c);
+		for(auto& portal : hierarchy.clusters[c].portals)
+			add_to_corridor(portal.to_cluster);
+		if(c == start_cluster)
+			break;
+	}
+
+	auto corridor_prov_func = [&](dcon::province_id to) {
+		return in_corridor[hierarchy.province_cluster[to.index()]] != 0 && prov_func(to);
+	};
+	auto path_result = make_path_to_prov<HeuristicModifier>(state, start, end, adj_func, corridor_prov_func, movementcost_func);
+
+	for(auto c : corridor)
+		in_corridor[c] = 0;
+
+	if(path_result.empty())
+		return make_path_to_prov<HeuristicModifier>(state, start, end, adj_func, prov_func, movementcost_func);
+	return path_result;
+}
 
 
 
@@ -262,21 +453,24 @@ std::vector<dcon::province_id> make_path_to_prov(sys::state& state, dcon::provin
 // ProvFunc: Lambda which takes a province_id as parameter and returns a bool. Decides if the given province is passable from any direction
 // MovementCostFunc: Lambda which takes the following as parameters (to_prov, from_prov, adjacency, distance) and returns a float. The returned value is used as movement cost in pathfinding
 template<typename AdjFunc, typename ProvFunc, typename MovementCostFunc>
-std::vector<dcon::province_id> make_path_to_prov_fast(sys::state& state, dcon::province_id start, dcon::province_id end, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func) {
+void make_path_to_prov_fast(sys::state& state, dcon::province_id start, dcon::province_id end, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, std::vector<dcon::province_id>& path_result) {
 
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	static thread_local std::vector<province_and_distance> path_heap;
+	path_heap.clear();
+	// only the parents are used, a province with a parent has been reached already
+	auto& workspace = path_workspace::for_this_thread();
+	workspace.begin_search(state.world.province_size());
 
-	std::vector<dcon::province_id> path_result;
+	path_result.clear();
 
 	if(start == end)
-		return path_result;
+		return;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		//path_result.push_back(end);
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = workspace.parent_of(i);
 		}
 	};
 	auto assert_path_result = [](std::vector<dcon::province_id>& v) {
@@ -293,38 +487,37 @@ std::vector<dcon::province_id> make_path_to_prov_fast(sys::state& state, dcon::p
 		if(nearest.province == end) {
 			fill_path_result(nearest.province);
 			assert_path_result(path_result);
-			return path_result;
+			return;
 		}
 
-		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
-			auto other_prov =
-				adj.get_connected_provinces(0) == nearest.province ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
-			auto bits = adj.get_type();
-			auto distance = adj.get_distance();
+		for(auto& edge : state.adjacency_graph.neighbors(nearest.province)) {
+			auto other_prov = edge.neighbor;
+			auto adj = edge.adjacency;
+			auto distance = edge.distance;
 
-			if(adj_func(other_prov, nearest.province, adj) && !origins_vector.get(other_prov)) {
+			if(adj_func(other_prov, nearest.province, adj) && !workspace.parent_of(other_prov)) {
 
 				if(prov_func(other_prov)) {
-					/*if(other_prov == end) {
-						fill_path_result(nearest.province);
-						assert_path_result(path_result);
-						return path_result;
-					}*/
 					float new_dist = movementcost_func(other_prov, nearest.province, adj, distance); // to and from province
 					path_heap.push_back(
 								province_and_distance{ nearest.distance_covered + new_dist, direct_distance(state, other_prov, end), other_prov });
 					std::push_heap(path_heap.begin(), path_heap.end());
-					origins_vector.set(other_prov, nearest.province);
+					workspace.get(other_prov).parent = nearest.province;
 				} else {
-					origins_vector.set(other_prov, dcon::province_id{ 0 }); // exclude it from being checked again
+					workspace.get(other_prov).parent = dcon::province_id{ 0 }; // exclude it from being checked again
 				}
 			}
 		}
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+}
 
+template<typename AdjFunc, typename ProvFunc, typename MovementCostFunc>
+std::vector<dcon::province_id> make_path_to_prov_fast(sys::state& state, dcon::province_id start, dcon::province_id end, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func) {
+	std::vector<dcon::province_id> path_result;
+	make_path_to_prov_fast(state, start, end, adj_func, prov_func, movementcost_func, path_result);
+	return path_result;
 }
 
 
@@ -350,73 +543,66 @@ struct path_node {
 };
 
 
-// Creates a path from start province to end province,with given template functions to decide various factors
+// Creates a path from start province to end province,with given template functions to decide various factors. The path is written into path_result, which is cleared first, so callers can reuse its memory
 // AdjFunc: Lambda which takes the following as parameters (to_prov, from_prov, adjacency)  and returns a bool. Decides if the passage between the two provinces is possible.
 // ProvFunc: Lambda which takes a province_id as parameter and returns a bool. Decides if the given province is passable from any direction
 // MovementCostFunc: Lambda which takes the following as parameters (to_prov, from_prov, adjacency, distance) and returns a float. The returned value is used as movement cost in pathfinding
 // EndFunc: Lambda which takes a province_id and returns a bool. Decides if the given province is the end goal
 template<typename AdjFunc, typename ProvFunc, typename MovementCostFunc, typename EndFunc>
-std::vector<dcon::province_id> make_path_to_expression(sys::state& state, dcon::province_id start, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, EndFunc&& end_expression) {
+void make_path_to_expression(sys::state& state, dcon::province_id start, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, EndFunc&& end_expression, std::vector<dcon::province_id>& path_result) {
 
 	// uses an Dijkstra's algorithm implementation to find the best possible path to the end expression
 
-	std::vector<dcon::province_id> open_queue; // prioity queue of nodes to be processed, ordered by computed distance. Smallest distance goes first
-	// contains nodes for all provinces, including if they are in the open queue, are closed and its parent for constructing path later. It is allocated as a static thread local buffer, as it is possible both the UI and update thread will calculate paths
-	static thread_local tagged_vector<path_node, dcon::province_id> path_node_container;
-
-	path_node_container.resize(state.world.province_size());
-	std::memset(path_node_container.data(), 0, sizeof(path_node) * path_node_container.size()); // memset incase it was used earlier
-
-	std::vector<dcon::province_id> path_result;
+	path_result.clear();
 
 	if(end_expression(start)) {
-		return path_result;
+		return;
 	}
 
-	auto province_comparer = [&](dcon::province_id a, dcon::province_id b) {
-		return path_node_container[a] > path_node_container[b];
+	// contains nodes for the provinces touched by this search, including if they are in the open queue, are closed and its parent for constructing path later
+	auto& workspace = path_workspace::for_this_thread();
+	workspace.begin_search(state.world.province_size());
+
+	// smallest distance goes first
+	auto comes_after = [&](dcon::province_id a, dcon::province_id b) {
+		auto& node_a = workspace.nodes[a.index()];
+		auto& node_b = workspace.nodes[b.index()];
+		if(node_a.distance_covered != node_b.distance_covered)
+			return node_a.distance_covered > node_b.distance_covered;
+		return a.index() > b.index();
 	};
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = path_node_container[i].parent;
+			i = workspace.nodes[i.index()].parent;
 		}
 	};
 	auto assert_path_result = [](std::vector<dcon::province_id>& v) {
 		for(auto const e : v)
 			assert(bool(e));
 	};
-	auto& start_node = path_node_container[start];
-	start_node.distance_covered = 0.0f;
-	start_node.is_in_closed_list = false;
-	start_node.is_in_open_list = true;
-	start_node.parent = dcon::province_id{ };
-	start_node.province = start;
-
-	open_queue.push_back(start);
-	while(open_queue.size() > 0) {
-		std::pop_heap(open_queue.begin(), open_queue.end(), province_comparer);
-		auto current_prov = open_queue.back();
-		open_queue.pop_back();
-		auto& current_node = path_node_container[current_prov];
-		current_node.is_in_open_list = false;
+
+	workspace.get(start);
+	workspace.push(start, comes_after);
+	while(workspace.open_queue.size() > 0) {
+		auto current_prov = workspace.pop(comes_after);
+		auto& current_node = workspace.nodes[current_prov.index()];
 		// check if we have reached the end
 		if(end_expression(current_prov)) {
 			fill_path_result(current_prov);
 			assert_path_result(path_result);
-			return path_result;
+			return;
 		}
 		// add current to closed list immediately
 		current_node.is_in_closed_list = true;
 
-		for(auto adj : state.world.province_get_province_adjacency(current_prov)) {
-			auto other_prov =
-				adj.get_connected_provinces(0) == current_prov ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
-			auto bits = adj.get_type();
-			auto distance = adj.get_distance();
+		for(auto& edge : state.adjacency_graph.neighbors(current_prov)) {
+			auto other_prov = edge.neighbor;
+			auto adj = edge.adjacency;
+			auto distance = edge.distance;
 
-			auto& neighbor_node = path_node_container[other_prov];
+			auto& neighbor_node = workspace.get(other_prov);
 
 			// check if not present in the closed list, and passes the adjacency check (aka the specific adjacency is passable). It is not added to the closed list if the adj check fails as it may be passable from a diffrent adjacency
 			if(!neighbor_node.is_in_closed_list && adj_func(other_prov, current_prov, adj)) {
@@ -424,24 +610,19 @@ std::vector<dcon::province_id> make_path_to_expression(sys::state& state, dcon::
 				if(prov_func(other_prov)) {
 					float new_dist = movementcost_func(other_prov, current_prov, adj, distance); // to and from province
 					float distance_to_neighbor = current_node.distance_covered + new_dist; // computes net distance to neighbor from the start province
-					// if not present in the open queue add it to the open queue for processing later
 
+					// if not present in the open queue add it to the open queue for processing later
 					if(!neighbor_node.is_in_open_list) {
 						// set distance and parent, then add it to the open queue
 						neighbor_node.distance_covered = distance_to_neighbor;
 						neighbor_node.parent = current_prov;
-						neighbor_node.province = other_prov; // set province now, before it is added to the open queue
-						open_queue.push_back(other_prov);
-						std::push_heap(open_queue.begin(), open_queue.end(), province_comparer);
-						neighbor_node.is_in_open_list = true;
+						workspace.push(other_prov, comes_after);
 					}
 					else if(distance_to_neighbor < neighbor_node.distance_covered) {
 						// this is a better path; update distance covered and parent
 						neighbor_node.distance_covered = distance_to_neighbor;
 						neighbor_node.parent = current_prov;
 					}
-					
-
 				} else {
 					neighbor_node.is_in_closed_list = true;// exclude it from being checked again
 				}
@@ -450,8 +631,13 @@ std::vector<dcon::province_id> make_path_to_expression(sys::state& state, dcon::
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+}
 
+template<typename AdjFunc, typename ProvFunc, typename MovementCostFunc, typename EndFunc>
+std::vector<dcon::province_id> make_path_to_expression(sys::state& state, dcon::province_id start, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, EndFunc&& end_expression) {
+	std::vector<dcon::province_id> path_result;
+	make_path_to_expression(state, start, adj_func, prov_func, movementcost_func, end_expression, path_result);
+	return path_result;
 }
 
 
@@ -462,22 +648,25 @@ std::vector<dcon::province_id> make_path_to_expression(sys::state& state, dcon::
 // MovementCostFunc: Lambda which takes the following as parameters (to_prov, from_prov, adjacency, distance) and returns a float. The returned value is used as movement cost in pathfinding
 // EndFunc: Lambda which takes a province_id and returns a bool. Decides if the given province is the end goal
 template<typename AdjFunc, typename ProvFunc, typename MovementCostFunc, typename EndFunc>
-std::vector<dcon::province_id> make_path_to_expression_fast(sys::state& state, dcon::province_id start, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, EndFunc&& end_expression) {
+void make_path_to_expression_fast(sys::state& state, dcon::province_id start, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, EndFunc&& end_expression, std::vector<dcon::province_id>& path_result) {
 
-	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
-	origins_vector.set(start, dcon::province_id{ 0 });
+	static thread_local std::vector<retreat_province_and_distance> path_heap;
+	path_heap.clear();
+	// only the parents are used, a province with a parent has been reached already
+	auto& workspace = path_workspace::for_this_thread();
+	workspace.begin_search(state.world.province_size());
+	workspace.get(start).parent = dcon::province_id{ 0 };
 
-	std::vector<dcon::province_id> path_result;
+	path_result.clear();
 
 	if(end_expression(start)) {
-		return path_result;
+		return;
 	}
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = workspace.parent_of(i);
 		}
 		};
 	auto assert_path_result = [](std::vector<dcon::province_id>& v) {
@@ -494,39 +683,163 @@ std::vector<dcon::province_id> make_path_to_expression_fast(sys::state& state, d
 		if(end_expression(nearest.province)) {
 			fill_path_result(nearest.province);
 			assert_path_result(path_result);
-			return path_result;
+			return;
 		}
 
-		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
-			auto other_prov =
-				adj.get_connected_provinces(0) == nearest.province ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
-			auto bits = adj.get_type();
-			auto distance = adj.get_distance();
+		for(auto& edge : state.adjacency_graph.neighbors(nearest.province)) {
+			auto other_prov = edge.neighbor;
+			auto adj = edge.adjacency;
+			auto distance = edge.distance;
 
-			if(adj_func(other_prov, nearest.province, adj) && !origins_vector.get(other_prov)) {
+			if(adj_func(other_prov, nearest.province, adj) && !workspace.parent_of(other_prov)) {
 
 				if(prov_func(other_prov)) {
 					float new_dist = movementcost_func(other_prov, nearest.province, adj, distance); // to and from province
 					path_heap.push_back(
 								retreat_province_and_distance{ nearest.distance_covered + new_dist, other_prov });
 					std::push_heap(path_heap.begin(), path_heap.end());
-					origins_vector.set(other_prov, nearest.province);
+					workspace.get(other_prov).parent = nearest.province;
 				} else {
-					origins_vector.set(other_prov, dcon::province_id{ 0 }); // exclude it from being checked again
+					workspace.get(other_prov).parent = dcon::province_id{ 0 }; // exclude it from being checked again
 				}
 			}
 		}
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+}
 
+template<typename AdjFunc, typename ProvFunc, typename MovementCostFunc, typename EndFunc>
+std::vector<dcon::province_id> make_path_to_expression_fast(sys::state& state, dcon::province_id start, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, EndFunc&& end_expression) {
+	std::vector<dcon::province_id> path_result;
+	make_path_to_expression_fast(state, start, adj_func, prov_func, movementcost_func, end_expression, path_result);
+	return path_result;
 }
 
 
 
+// result of one search from many provinces at once: for every settled province, the cost of the cheapest route between it and the nearest source, and the next province on that route towards the source
+struct distance_field {
+	path_workspace workspace;
+	search_direction direction = search_direction::from_sources;
 
+	bool reached(dcon::province_id p) const {
+		auto& n = workspace.nodes[p.index()];
+		return n.generation == workspace.generation && n.is_in_closed_list;
+	}
+	float distance(dcon::province_id p) const {
+		assert(reached(p));
+		return workspace.nodes[p.index()].distance_covered;
+	}
+	// the route between p and its source, in the same format as make_path_to_prov: it ends at p when searching from the sources, and starts at p when searching to them
+	void path(dcon::province_id p, std::vector<dcon::province_id>& path_result) const {
+		path_result.clear();
+		if(!reached(p))
+			return;
+		if(direction == search_direction::from_sources) {
+			for(auto i = p; workspace.nodes[i.index()].parent; i = workspace.nodes[i.index()].parent)
+				path_result.push_back(i);
+		} else {
+			for(auto i = workspace.nodes[p.index()].parent; i; i = workspace.nodes[i.index()].parent)
+				path_result.push_back(i);
+			std::reverse(path_result.begin(), path_result.end());
+		}
+	}
+};
 
+// Fills field with a Dijkstra search started from all the sources at once, with the same template functions as make_path_to_prov
+// Direction: from_sources measures routes leaving the sources, to_sources routes arriving at them. In the latter case a source is only used if it passes the province check, like the end province of make_path_to_prov, and the province a route starts from does not need to pass it
+// wanted: if not empty, the search stops once all of these provinces are settled instead of covering everything reachable
+template<search_direction Direction, typename AdjFunc, typename ProvFunc, typename MovementCostFunc>
+void fill_distance_field(sys::state& state, std::span<dcon::province_id const> sources, AdjFunc&& adj_func, ProvFunc&& prov_func, MovementCostFunc&& movementcost_func, distance_field& field, std::span<dcon::province_id const> wanted = { }) {
+	auto& workspace = field.workspace;
+	field.direction = Direction;
+	workspace.begin_search(state.world.province_size());
+
+	static thread_local std::vector<dcon::province_id> sorted_wanted;
+	sorted_wanted.assign(wanted.begin(), wanted.end());
+	std::sort(sorted_wanted.begin(), sorted_wanted.end(), [](auto a, auto b) { return a.index() < b.index(); });
+	sorted_wanted.erase(std::unique(sorted_wanted.begin(), sorted_wanted.end()), sorted_wanted.end());
+	auto remaining_wanted = sorted_wanted.size();
+
+	// the field has to be exact, so a province is queued again whenever a shorter route to it is found, and the stale entries are skipped when they come up
+	struct queued_province {
+		float distance = 0.0f;
+		dcon::province_id province;
+	};
+	static thread_local std::vector<queued_province> queue;
+	queue.clear();
+	auto comes_after = [](queued_province const& a, queued_province const& b) {
+		if(a.distance != b.distance)
+			return a.distance > b.distance;
+		return a.province.index() > b.province.index();
+	};
+	auto push = [&](dcon::province_id p, float distance) {
+		queue.push_back(queued_province{ distance, p });
+		std::push_heap(queue.begin(), queue.end(), comes_after);
+	};
+
+	for(auto s : sources) {
+		if constexpr(Direction == search_direction::to_sources) {
+			if(!prov_func(s))
+				continue;
+		}
+		auto& source_node = workspace.get(s);
+		if(!source_node.is_in_open_list) {
+			source_node.is_in_open_list = true;
+			push(s, 0.0f);
+		}
+	}
+
+	while(queue.size() > 0) {
+		std::pop_heap(queue.begin(), queue.end(), comes_after);
+		auto current_prov = queue.back().province;
+		queue.pop_back();
+		auto& current_node = workspace.nodes[current_prov.index()];
+		if(current_node.is_in_closed_list)
+			continue;
+		current_node.is_in_closed_list = true;
+		++workspace.provinces_expanded;
+
+		if(remaining_wanted > 0 && std::binary_search(sorted_wanted.begin(), sorted_wanted.end(), current_prov, [](auto a, auto b) { return a.index() < b.index(); })) {
+			if(--remaining_wanted == 0)
+				return;
+		}
+		if constexpr(Direction == search_direction::to_sources) {
+			// routes from further away have to pass through this province
+			if(current_node.parent && !prov_func(current_prov))
+				continue;
+		}
+
+		for(auto& edge : state.adjacency_graph.neighbors(current_prov)) {
+			auto other_prov = edge.neighbor;
+			auto adj = edge.adjacency;
+			auto& neighbor_node = workspace.get(other_prov);
+			if(neighbor_node.is_in_closed_list)
+				continue;
+
+			float step_cost = 0.0f;
+			if constexpr(Direction == search_direction::from_sources) {
+				if(!adj_func(other_prov, current_prov, adj) || !prov_func(other_prov))
+					continue;
+				step_cost = movementcost_func(other_prov, current_prov, adj, edge.distance);
+			} else {
+				if(!adj_func(current_prov, other_prov, adj))
+					continue;
+				step_cost = movementcost_func(current_prov, other_prov, adj, edge.distance);
+			}
+
+			float distance_to_neighbor = current_node.distance_covered + step_cost;
+			if(!neighbor_node.is_in_open_list || distance_to_neighbor < neighbor_node.distance_covered) {
+				// is_in_open_list stays set once the province has a route, as the field keeps no open queue of its own
+				neighbor_node.is_in_open_list = true;
+				neighbor_node.distance_covered = distance_to_neighbor;
+				neighbor_node.parent = current_prov;
+				push(other_prov, distance_to_neighbor);
+			}
+		}
+	}
+}
 
 
 
@@ -1466,8 +1466,10 @@ uint32_t ef_none(EFFECT_PARAMTERS) {
 }
 uint32_t ef_capital(EFFECT_PARAMTERS) {
 	auto new_capital = trigger::payload(tval[1]).prov_id;
-	if(ws.world.province_get_nation_from_province_ownership(new_capital) == trigger::to_nation(primary_slot))
+	if(ws.world.province_get_nation_from_province_ownership(new_capital) == trigger::to_nation(primary_slot)) {
 		ws.world.nation_set_capital(trigger::to_nation(primary_slot), new_capital);
+		province::mark_cached_values_dirty(ws, trigger::to_nation(primary_slot));
+	}
 	return 0;
 }
 uint32_t ef_add_core_tag(EFFECT_PARAMTERS) {
@@ -2574,6 +2576,7 @@ uint32_t ef_change_controller_state_from_province(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_infrastructure(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto& building_level = ws.world.province_get_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::railroad));
 	ws.world.province_set_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::railroad), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value),
 			0,
@@ -2582,6 +2585,7 @@ uint32_t ef_infrastructure(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_infrastructure_state(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	province::for_each_province_in_state_instance(ws, trigger::to_state(primary_slot), [&](dcon::province_id p) {
 		auto& building_level = ws.world.province_get_building_level(p, uint8_t(economy::province_building_type::railroad));
 		ws.world.province_set_building_level(p, uint8_t(economy::province_building_type::railroad), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value),
@@ -2792,6 +2796,7 @@ uint32_t ef_release_vassal(EFFECT_PARAMTERS) {
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
 		ws.trade_route_cached_values_out_of_date = true;
+		ws.path_cache.invalidate();
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			nations::sphere_nation(ws, holder, trigger::to_nation(primary_slot));
 		}
@@ -2812,6 +2817,7 @@ uint32_t ef_release_vassal_this_nation(EFFECT_PARAMTERS) {
 			return 0;
 		ws.world.force_create_overlord(trigger::to_nation(this_slot), trigger::to_nation(primary_slot));
 		ws.trade_route_cached_values_out_of_date = true;
+		ws.path_cache.invalidate();
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			nations::sphere_nation(ws, trigger::to_nation(this_slot), trigger::to_nation(primary_slot));
 		}
@@ -2835,6 +2841,7 @@ uint32_t ef_release_vassal_this_province(EFFECT_PARAMTERS) {
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
 		ws.trade_route_cached_values_out_of_date = true;
+		ws.path_cache.invalidate();
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			nations::sphere_nation(ws, holder, trigger::to_nation(primary_slot));
 		}
@@ -2855,6 +2862,7 @@ uint32_t ef_release_vassal_from_nation(EFFECT_PARAMTERS) {
 			return 0;
 		ws.world.force_create_overlord(trigger::to_nation(from_slot), trigger::to_nation(primary_slot));
 		ws.trade_route_cached_values_out_of_date = true;
+		ws.path_cache.invalidate();
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			nations::sphere_nation(ws, trigger::to_nation(from_slot), trigger::to_nation(primary_slot));
 		}
@@ -2878,6 +2886,7 @@ uint32_t ef_release_vassal_from_province(EFFECT_PARAMTERS) {
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
 		ws.trade_route_cached_values_out_of_date = true;
+		ws.path_cache.invalidate();
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			nations::sphere_nation(ws, holder, trigger::to_nation(primary_slot));
 		}
@@ -2901,6 +2910,7 @@ uint32_t ef_release_vassal_reb(EFFECT_PARAMTERS) {
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
 		ws.trade_route_cached_values_out_of_date = true;
+		ws.path_cache.invalidate();
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			nations::sphere_nation(ws, holder, trigger::to_nation(primary_slot));
 		}
@@ -3437,6 +3447,7 @@ uint32_t ef_rgo_size(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_fort(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto& building_level = ws.world.province_get_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::fort));
 	ws.world.province_set_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::fort), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value),
 		0,
@@ -3444,6 +3455,7 @@ uint32_t ef_fort(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_naval_base(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto& building_level = ws.world.province_get_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::naval_base));
 	ws.world.province_set_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::naval_base), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value), 0, int32_t(ws.world.nation_get_max_building_level(ws.world.province_get_nation_from_province_ownership(trigger::to_prov(primary_slot)), uint8_t(economy::province_building_type::naval_base))))));
 	if(building_level > 0) {
@@ -3453,16 +3465,19 @@ uint32_t ef_naval_base(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_bank(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto& building_level = ws.world.province_get_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::bank));
 	ws.world.province_set_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::bank), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value), 0, int32_t(ws.world.nation_get_max_building_level(ws.world.province_get_nation_from_province_ownership(trigger::to_prov(primary_slot)), uint8_t(economy::province_building_type::bank))))));
 	return 0;
 }
 uint32_t ef_university(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto& building_level = ws.world.province_get_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::university));
 	ws.world.province_set_building_level(trigger::to_prov(primary_slot), uint8_t(economy::province_building_type::university), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value), 0, int32_t(ws.world.nation_get_max_building_level(ws.world.province_get_nation_from_province_ownership(trigger::to_prov(primary_slot)), uint8_t(economy::province_building_type::university))))));
 	return 0;
 }
 uint32_t ef_fort_state(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	province::for_each_province_in_state_instance(ws, trigger::to_state(primary_slot), [&](dcon::province_id p) {
 		auto& building_level = ws.world.province_get_building_level(p, uint8_t(economy::province_building_type::fort));
 		ws.world.province_set_building_level(p, uint8_t(economy::province_building_type::fort), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value), 0, int32_t(ws.world.nation_get_max_building_level(ws.world.province_get_nation_from_province_ownership(p), uint8_t(economy::province_building_type::fort))))));
@@ -3470,6 +3485,7 @@ uint32_t ef_fort_state(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_naval_base_state(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	uint32_t lvl = 0;
 	province::for_each_province_in_state_instance(ws, trigger::to_state(primary_slot), [&](dcon::province_id p) {
 		auto& building_level = ws.world.province_get_building_level(p, uint8_t(economy::province_building_type::naval_base));
@@ -3483,6 +3499,7 @@ uint32_t ef_naval_base_state(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_bank_state(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	province::for_each_province_in_state_instance(ws, trigger::to_state(primary_slot), [&](dcon::province_id p) {
 		auto& building_level = ws.world.province_get_building_level(p, uint8_t(economy::province_building_type::bank));
 		ws.world.province_set_building_level(p, uint8_t(economy::province_building_type::bank), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value), 0, int32_t(ws.world.nation_get_max_building_level(ws.world.province_get_nation_from_province_ownership(p), uint8_t(economy::province_building_type::bank))))));
@@ -3490,6 +3507,7 @@ uint32_t ef_bank_state(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_university_state(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	province::for_each_province_in_state_instance(ws, trigger::to_state(primary_slot), [&](dcon::province_id p) {
 		auto& building_level = ws.world.province_get_building_level(p, uint8_t(economy::province_building_type::university));
 		ws.world.province_set_building_level(p, uint8_t(economy::province_building_type::university), uint8_t(std::clamp(int32_t(building_level) + int32_t(trigger::payload(tval[1]).signed_value), 0, int32_t(ws.world.nation_get_max_building_level(ws.world.province_get_nation_from_province_ownership(p), uint8_t(economy::province_building_type::university))))));
@@ -4929,6 +4947,7 @@ uint32_t ef_party_loyalty_province(EFFECT_PARAMTERS) {
 }
 
 uint32_t ef_build_railway_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs, [&](dcon::province_id p) {
@@ -4942,6 +4961,7 @@ uint32_t ef_build_railway_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTERS)
 	return 0;
 }
 uint32_t ef_build_railway_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs, [&](dcon::province_id p) {
@@ -4955,6 +4975,7 @@ uint32_t ef_build_railway_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTERS)
 	return 0;
 }
 uint32_t ef_build_railway_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		if(ws.world.province_get_modifier_values(c, sys::provincial_mod_offsets::min_build_railroad) <= 1.0f) {
@@ -4966,6 +4987,7 @@ uint32_t ef_build_railway_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTERS)
 	return 0;
 }
 uint32_t ef_build_railway_in_capital_no_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		if(ws.world.province_get_modifier_values(c, sys::provincial_mod_offsets::min_build_railroad) <= 1.0f) {
@@ -4977,6 +4999,7 @@ uint32_t ef_build_railway_in_capital_no_whole_state_no_limit(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_build_fort_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs,
@@ -4987,6 +5010,7 @@ uint32_t ef_build_fort_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_build_fort_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs,
@@ -4997,6 +5021,7 @@ uint32_t ef_build_fort_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_build_fort_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		auto& current = ws.world.province_get_building_level(c, uint8_t(economy::province_building_type::fort));
@@ -5005,6 +5030,7 @@ uint32_t ef_build_fort_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_build_fort_in_capital_no_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		auto& current = ws.world.province_get_building_level(c, uint8_t(economy::province_building_type::fort));
@@ -5098,6 +5124,7 @@ uint32_t ef_treasury_province(EFFECT_PARAMTERS) {
 // Banks
 //
 uint32_t ef_build_bank_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs, [&](dcon::province_id p) {
@@ -5110,6 +5137,7 @@ uint32_t ef_build_bank_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_build_bank_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs, [&](dcon::province_id p) {
@@ -5121,6 +5149,7 @@ uint32_t ef_build_bank_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_build_bank_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		if(ws.world.province_get_modifier_values(c, sys::provincial_mod_offsets::min_build_bank) <= 1.0f) {
@@ -5131,6 +5160,7 @@ uint32_t ef_build_bank_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTERS) {
 	return 0;
 }
 uint32_t ef_build_bank_in_capital_no_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		if(ws.world.province_get_modifier_values(c, sys::provincial_mod_offsets::min_build_bank) <= 1.0f) {
@@ -5144,6 +5174,7 @@ uint32_t ef_build_bank_in_capital_no_whole_state_no_limit(EFFECT_PARAMTERS) {
 // universities
 //
 uint32_t ef_build_university_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs, [&](dcon::province_id p) {
@@ -5155,6 +5186,7 @@ uint32_t ef_build_university_in_capital_yes_whole_state_yes_limit(EFFECT_PARAMTE
 	return 0;
 }
 uint32_t ef_build_university_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	auto cs = ws.world.province_get_state_membership(c);
 	province::for_each_province_in_state_instance(ws, cs, [&](dcon::province_id p) {
@@ -5166,6 +5198,7 @@ uint32_t ef_build_university_in_capital_yes_whole_state_no_limit(EFFECT_PARAMTER
 	return 0;
 }
 uint32_t ef_build_university_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		if(ws.world.province_get_modifier_values(c, sys::provincial_mod_offsets::min_build_university) <= 1.0f) {
@@ -5176,6 +5209,7 @@ uint32_t ef_build_university_in_capital_no_whole_state_yes_limit(EFFECT_PARAMTER
 	return 0;
 }
 uint32_t ef_build_university_in_capital_no_whole_state_no_limit(EFFECT_PARAMTERS) {
+	ws.path_cache.invalidate();
 	auto c = ws.world.nation_get_capital(trigger::to_nation(primary_slot));
 	if(c) {
 		if(ws.world.province_get_modifier_values(c, sys::provincial_mod_offsets::min_build_university) <= 1.0f) {
@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "catch.hpp"
+#include "system_state.hpp"
+#include "simple_fs.hpp"
+
+// shared by the hidden benchmark test cases: timing, allocation counts and the results recorded in tests/bench_golden.txt
+
+#ifdef ALICE_BENCH_COUNT_ALLOCATIONS
+// only in test builds configured with -DBENCH_ALLOCATION_COUNTING=On, as it replaces the global operator new of the whole test binary
+// counts every allocation made through the global operator new, from any thread
+// array new and the nothrow versions forward here by default
+
+static std::atomic<uint64_t> bench_allocations{ 0 };
+
+void* operator new(std::size_t size) {
+	bench_allocations.fetch_add(1, std::memory_order_relaxed);
+	if(auto ptr = std::malloc(size == 0 ? 1 : size); ptr)
+		return ptr;
+	std::abort();
+}
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+#endif
+
+namespace bench {
+
+#ifdef ALICE_BENCH_COUNT_ALLOCATIONS
+inline constexpr bool counts_allocations = true;
+inline uint64_t allocation_count() {
+	return bench_allocations.load(std::memory_order_relaxed);
+}
+#else
+inline constexpr bool counts_allocations = false;
+inline uint64_t allocation_count() {
+	return 0;
+}
+#endif
+
+inline constexpr native_char const* golden_file_name = NATIVE("bench_golden.txt");
+
+struct function_result {
+	char const* name = nullptr;
+	uint64_t total_ns = 0;
+	uint64_t total_allocations = 0;
+	uint32_t runs = 0;
+	std::string checksum;
+};
+
+inline std::string checksum_to_hex(sys::checksum_key key) {
+	static char const digits[] = "0123456789abcdef";
+	std::string result;
+	result.reserve(sys::checksum_key::key_size * 2);
+	for(uint32_t i = 0; i < sys::checksum_key::key_size; ++i) {
+		result.push_back(digits[key.key[i] >> 4]);
+		result.push_back(digits[key.key[i] & 0x0F]);
+	}
+	return result;
+}
+
+// 64 bit FNV-1a over the values added to it, for results too large to record directly
+struct result_hash {
+	uint64_t value = 14695981039346656037ull;
+
+	void add_bytes(void const* data, size_t size) {
+		auto bytes = static_cast<uint8_t const*>(data);
+		for(size_t i = 0; i < size; ++i) {
+			value ^= bytes[i];
+			value *= 1099511628211ull;
+		}
+	}
+	template<typename T>
+	void add(T const& v) {
+		static_assert(std::is_arithmetic_v<T>);
+		add_bytes(&v, sizeof(T));
+	}
+	std::string to_hex() const {
+		char buffer[24];
+		std::snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)value);
+		return buffer;
+	}
+};
+
+template<typename F>
+void measure(sys::state& state, function_result& result, bool take_checksum, F&& f) {
+	auto allocations_before = allocation_count();
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	auto allocations_after = allocation_count();
+
+	result.total_ns += uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	result.total_allocations += allocations_after - allocations_before;
+	result.runs += 1;
+	if(take_checksum)
+		result.checksum = checksum_to_hex(state.get_mp_state_checksum());
+}
+
+// one line per function, with the time and the allocations per run
+inline std::string report_line(function_result const& r) {
+	char line[256];
+	if constexpr(counts_allocations) {
+		std::snprintf(line, sizeof(line), "%-48s %12llu ns/op %10llu allocations/op\n", r.name,
+			(unsigned long long)(r.total_ns / r.runs), (unsigned long long)(r.total_allocations / r.runs));
+	} else {
+		std::snprintf(line, sizeof(line), "%-48s %12llu ns/op\n", r.name, (unsigned long long)(r.total_ns / r.runs));
+	}
+	return line;
+}
+
+// checks a result against the line "<scenario checksum> <name> <result>" of tests/bench_golden.txt
+// the testing scenario is built from the local game files, so each scenario has its own lines; a missing line only prints the line to add,
+// as the benchmarks also check their results against a reference computed in the same run
+inline void require_recorded_result(sys::state& state, std::string_view name, std::string const& result) {
+	std::string key = checksum_to_hex(state.scenario_checksum);
+	key += ' ';
+	key += name;
+	key += ' ';
+
+	simple_fs::file_system fs;
+	add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("tests"));
+	auto golden_file = simple_fs::open_file(simple_fs::get_root(fs), golden_file_name);
+	INFO("tests/bench_golden.txt must be checked in");
+	REQUIRE(bool(golden_file));
+
+	auto contents = simple_fs::view_contents(*golden_file);
+	std::string lines(contents.data, contents.file_size);
+	simple_fs::standardize_newlines(lines);
+
+	std::string recorded;
+	bool found = false;
+	for(size_t start = 0; start < lines.length() && !found;) {
+		auto end = lines.find('\n', start);
+		if(end == std::string::npos)
+			end = lines.length();
+		if(lines.compare(start, key.length(), key) == 0) {
+			recorded = lines.substr(start + key.length(), end - start - key.length());
+			found = true;
+		}
+		start = end + 1;
+	}
+	if(!found) {
+		WARN("no result recorded for this scenario; once the change is checked, add the line: " << key << result);
+		return;
+	}
+	INFO("results drifted from tests/bench_golden.txt for " << name);
+	REQUIRE(recorded == result);
+}
+
+}
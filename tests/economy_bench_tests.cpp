@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <string>
+#include "catch.hpp"
+#include "bench_common.hpp"
+#include "system_state.hpp"
+#include "economy.hpp"
+#include "economy_production.hpp"
+#include "economy_trade_routes.hpp"
+#include "nations.hpp"
+#include "province.hpp"
+
+// replays a few days of the economy on the testing scenario and times the heaviest parts of the daily update separately
+// the replay runs on two copies of the scenario, and the state checksum after each function on the last day must be the same for both;
+// it is also checked against the results recorded in bench_golden.txt
+
+namespace economy_bench {
+
+inline constexpr int32_t replay_days = 10;
+
+std::array<bench::function_result, 5> replay(sys::state& state) {
+	std::array<bench::function_result, 5> results{ };
+	results[0].name = "update_employment";
+	results[1].name = "update_trade_routes_consumption";
+	results[2].name = "run_private_investment";
+	results[3].name = "update_national_consumption";
+	results[4].name = "daily_update";
+
+	for(int32_t day = 0; day < replay_days; ++day) {
+		bool last_day = day + 1 == replay_days;
+		state.tick_arena.begin_tick();
+
+		bench::measure(state, results[0], last_day, [&]() {
+			economy::update_employment(state, false);
+		});
+		bench::measure(state, results[1], last_day, [&]() {
+			economy::update_trade_routes_consumption(state);
+		});
+		bench::measure(state, results[2], last_day, [&]() {
+			economy::run_private_investment(state);
+		});
+		bench::measure(state, results[3], last_day, [&]() {
+			for(auto n : state.world.in_nation) {
+				if(n.get_owned_province_count() == 0)
+					continue;
+				economy::update_national_consumption(state, n, n.get_spending_level(), n.get_last_base_budget());
+			}
+		});
+		bench::measure(state, results[4], last_day, [&]() {
+			economy::daily_update(state, false, 1.f);
+		});
+
+		state.current_date += 1;
+	}
+	return results;
+}
+
+}
+
+TEST_CASE("economy_replay_benchmark", "[.][economy_bench]") {
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *game_state;
+	auto results = economy_bench::replay(state);
+
+	std::string report;
+	for(auto& r : results)
+		report += bench::report_line(r);
+	{
+		char line[256];
+		std::snprintf(line, sizeof(line), "%-48s %12llu bytes on the last day\n", "tick arena",
+			(unsigned long long)(state.tick_arena.bytes_allocated_this_tick()));
+		report += line;
+	}
+	WARN(report);
+
+	// the parallel parts of the update must not make the results depend on scheduling
+	std::unique_ptr<sys::state> reference_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto reference = economy_bench::replay(*reference_state);
+	for(size_t i = 0; i < results.size(); ++i) {
+		INFO(results[i].name);
+		REQUIRE(results[i].checksum == reference[i].checksum);
+	}
+
+	for(auto& r : results)
+		bench::require_recorded_result(state, std::string("economy_replay/") + r.name, r.checksum);
+}
+
+// the sea trade routes of the testing scenario are found again from its land routes, and must match the routes stored in the scenario
+namespace sea_route_bench {
+
+struct route_record {
+	dcon::market_id a;
+	dcon::market_id b;
+	bool is_sea_route = false;
+	bool is_land_route = false;
+	float sea_distance = 0.f;
+	float land_distance = 0.f;
+
+	bool operator==(route_record const&) const = default;
+	bool connects_like(route_record const& o) const {
+		return a == o.a && b == o.b && is_sea_route == o.is_sea_route && is_land_route == o.is_land_route;
+	}
+};
+
+// sorted by market pair, as routes found again do not keep the ids they had in the scenario
+std::vector<route_record> record_routes(sys::state& state) {
+	std::vector<route_record> result;
+	for(auto r : state.world.in_trade_route) {
+		auto a = r.get_connected_markets(0).id;
+		auto b = r.get_connected_markets(1).id;
+		if(b.index() < a.index())
+			std::swap(a, b);
+		result.push_back(route_record{ a, b, r.get_is_sea_route(), r.get_is_land_route(), r.get_sea_distance(), r.get_land_distance() });
+	}
+	std::sort(result.begin(), result.end(), [](auto const& x, auto const& y) {
+		if(x.a != y.a)
+			return x.a.index() < y.a.index();
+		return x.b.index() < y.b.index();
+	});
+	return result;
+}
+
+std::string hash_routes(sys::state& state) {
+	bench::result_hash hash;
+	for(auto& r : record_routes(state)) {
+		hash.add(r.a.index());
+		hash.add(r.b.index());
+		hash.add(r.is_sea_route);
+		hash.add(r.is_land_route);
+		hash.add(r.sea_distance);
+		hash.add(r.land_distance);
+	}
+	return hash.to_hex();
+}
+
+// keeps only the land routes, so that the sea routes have to be found again
+void remove_sea_routes(sys::state& state) {
+	for(auto i = state.world.trade_route_size(); i-- > 0;) {
+		dcon::trade_route_id route{ dcon::trade_route_id::value_base_t(i) };
+		if(state.world.trade_route_get_is_land_route(route))
+			state.world.trade_route_set_is_sea_route(route, false);
+		else
+			state.world.delete_trade_route(route);
+	}
+}
+
+}
+
+TEST_CASE("sea_trade_routes_benchmark", "[.][economy_bench]") {
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *game_state;
+
+	auto scenario_routes = sea_route_bench::record_routes(state);
+	sea_route_bench::remove_sea_routes(state);
+
+	bench::function_result generate{ "generate_sea_trade_routes" };
+	bench::function_result warm{ "recalculate_markets_distance" };
+	bench::function_result cold{ "recalculate_markets_distance (no cached paths)" };
+
+	state.sea_trade_paths.reset();
+	bench::measure(state, generate, false, [&]() {
+		nations::generate_sea_trade_routes(state);
+	});
+	{
+		// distances are checked below, as they are set by recalculate_markets_distance
+		auto found_routes = sea_route_bench::record_routes(state);
+		REQUIRE(found_routes.size() == scenario_routes.size());
+		for(size_t i = 0; i < found_routes.size(); ++i) {
+			INFO("route between markets " << scenario_routes[i].a.index() << " and " << scenario_routes[i].b.index());
+			REQUIRE(found_routes[i].connects_like(scenario_routes[i]));
+		}
+	}
+	bench::require_recorded_result(state, "sea_trade_routes/generate_sea_trade_routes", sea_route_bench::hash_routes(state));
+
+	// the routes found while generating keep their paths for the distance update
+	bench::measure(state, warm, false, [&]() {
+		nations::recalculate_markets_distance(state);
+	});
+	auto with_cached_paths = sea_route_bench::record_routes(state);
+	state.sea_trade_paths.reset();
+	bench::measure(state, cold, false, [&]() {
+		nations::recalculate_markets_distance(state);
+	});
+	REQUIRE(with_cached_paths == sea_route_bench::record_routes(state));
+	bench::require_recorded_result(state, "sea_trade_routes/recalculate_markets_distance", sea_route_bench::hash_routes(state));
+
+	std::string report;
+	for(auto* r : { &generate, &warm, &cold })
+		report += bench::report_line(*r);
+	WARN(report);
+}
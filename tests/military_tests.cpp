@@ -0,0 +1,985 @@
+#include <cstdio>
+#include <string>
+#include "catch.hpp"
+#include "bench_common.hpp"
+#include "system_state.hpp"
+#include "military.hpp"
+#include "prng.hpp"
+
+namespace military_test {
+
+// the answers of the relation and presence queries as they were computed before update_war_relations existed
+bool brute_force_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	if(!state.world.nation_get_is_at_war(a) || !state.world.nation_get_is_at_war(b))
+		return false;
+	for(auto wa : state.world.nation_get_war_participant(a)) {
+		auto is_attacker = wa.get_is_attacker();
+		for(auto o : wa.get_war().get_war_participant()) {
+			if(o.get_nation() == b)
+				return o.get_is_attacker() != is_attacker;
+		}
+	}
+	return false;
+}
+bool brute_force_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	for(auto wa : state.world.nation_get_war_participant(a)) {
+		auto is_attacker = wa.get_is_attacker();
+		for(auto o : wa.get_war().get_war_participant()) {
+			if(o.get_nation() == b)
+				return o.get_is_attacker() == is_attacker;
+		}
+	}
+	return false;
+}
+bool brute_force_enemies(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	return (b && !a) || brute_force_at_war(state, a, b);
+}
+bool brute_force_has_enemy_army(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+	for(auto ar : state.world.province_get_army_location(p)) {
+		if(brute_force_enemies(state, n, ar.get_army().get_controller_from_army_control()))
+			return true;
+	}
+	return false;
+}
+bool brute_force_has_war_ally_army(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+	for(auto ar : state.world.province_get_army_location(p)) {
+		auto controller = ar.get_army().get_controller_from_army_control();
+		if(controller == n || brute_force_allied_in_war(state, n, controller))
+			return true;
+	}
+	return false;
+}
+bool brute_force_has_enemy_fleet(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+	for(auto nv : state.world.province_get_navy_location(p)) {
+		if(brute_force_at_war(state, n, nv.get_navy().get_controller_from_navy_control()))
+			return true;
+	}
+	return false;
+}
+float brute_force_enemy_army_weight(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+	float total = 0.0f;
+	for(auto ar : state.world.province_get_army_location(p)) {
+		if(!ar.get_army().get_black_flag() && !ar.get_army().get_is_retreating() && brute_force_at_war(state, n, ar.get_army().get_controller_from_army_control())) {
+			for(auto rg : ar.get_army().get_army_membership())
+				total += state.defines.pop_size_per_regiment / 1000.0f;
+		}
+	}
+	return total;
+}
+
+void start_wars(sys::state& state, uint32_t count) {
+	uint32_t started = 0;
+	for(auto adj : state.world.in_nation_adjacency) {
+		if(started >= count)
+			break;
+		auto a = adj.get_connected_nations(0);
+		auto b = adj.get_connected_nations(1);
+		if(a && b && a.get_owned_province_count() > 0 && b.get_owned_province_count() > 0 && !military::are_at_war(state, a, b)) {
+			military::create_war(state, a, b, dcon::cb_type_id{ }, dcon::state_definition_id{ }, dcon::national_identity_id{ }, dcon::nation_id{ });
+			++started;
+		}
+	}
+}
+
+void compare_with_brute_force(sys::state& state) {
+	military::update_war_relations(state);
+	REQUIRE(!state.military_definitions.war_relations_out_of_date);
+
+	std::vector<dcon::nation_id> at_war;
+	for(auto n : state.world.in_nation) {
+		if(n.get_war_participant().begin() != n.get_war_participant().end())
+			at_war.push_back(n);
+	}
+	REQUIRE(!at_war.empty());
+
+	for(auto a : at_war) {
+		for(auto b : state.world.in_nation) {
+			REQUIRE(military::are_at_war(state, a, b) == brute_force_at_war(state, a, b));
+			REQUIRE(military::are_at_war(state, b, a) == brute_force_at_war(state, b, a));
+			REQUIRE(military::are_allied_in_war(state, a, b) == brute_force_allied_in_war(state, a, b));
+			REQUIRE(military::are_allied_in_war(state, b, a) == brute_force_allied_in_war(state, b, a));
+		}
+	}
+
+	at_war.push_back(dcon::nation_id{ }); // rebels
+	at_war.push_back(*state.world.in_nation.begin()); // most likely at peace
+	for(auto p : state.world.in_province) {
+		for(auto n : at_war) {
+			REQUIRE(military::province_has_enemy_army(state, p, n) == brute_force_has_enemy_army(state, p, n));
+			REQUIRE(military::province_has_war_ally_army(state, p, n) == brute_force_has_war_ally_army(state, p, n));
+			if(n) {
+				REQUIRE(military::province_has_enemy_fleet(state, p, n) == brute_force_has_enemy_fleet(state, p, n));
+				REQUIRE(military::local_enemy_army_weight_max(state, p, n) == brute_force_enemy_army_weight(state, p, n));
+			}
+		}
+	}
+}
+
+// apply_regiment_damage as it was before the losses were computed over the regiment columns, kept to check that the results are unchanged
+void reference_apply_regiment_damage(sys::state& state) {
+	for(uint32_t i = state.world.regiment_size(); i-- > 0;) {
+		dcon::regiment_id s{ dcon::regiment_id::value_base_t(i) };
+		if(state.world.regiment_is_valid(s)) {
+			auto& pending_combat_damage = state.world.regiment_get_pending_combat_damage(s);
+			auto& pending_attrition_damage = state.world.regiment_get_pending_attrition_damage(s);
+			auto backing_pop = state.world.regiment_get_pop_from_regiment_source(s);
+			auto in_nation = state.world.army_get_controller_from_army_control(state.world.regiment_get_army_from_army_membership(s));
+
+			if(pending_combat_damage > 0) {
+				auto tech_nation = military::tech_nation_for_regiment(state, s);
+				if(bool(in_nation)) {
+					// give war exhaustion for the losses
+					auto& current_war_ex = state.world.nation_get_war_exhaustion(in_nation);
+					auto extra_war_ex = military::get_war_exhaustion_from_land_losses<military::regiment_dmg_source::combat>(state, pending_combat_damage, in_nation);
+					state.world.nation_set_war_exhaustion(in_nation, std::min(current_war_ex + extra_war_ex, state.world.nation_get_modifier_values(in_nation, sys::national_mod_offsets::max_war_exhaustion)));
+				}
+				if(backing_pop) {
+					auto& psize = state.world.pop_get_size(backing_pop);
+					float damage_modifier = std::max(state.defines.soldier_to_pop_damage - state.world.nation_get_modifier_values(tech_nation, sys::national_mod_offsets::soldier_to_pop_loss), 0.0f);
+					state.world.pop_set_size(backing_pop, psize - state.defines.pop_size_per_regiment * pending_combat_damage * damage_modifier);
+				}
+				state.world.regiment_set_pending_combat_damage(s, 0.0f);
+			}
+			if(pending_attrition_damage > 0) {
+				auto tech_nation = military::tech_nation_for_regiment(state, s);
+				if(bool(in_nation)) {
+					// give war exhaustion for the losses
+					auto& current_war_ex = state.world.nation_get_war_exhaustion(in_nation);
+					auto extra_war_ex = military::get_war_exhaustion_from_land_losses<military::regiment_dmg_source::attrition>(state, pending_attrition_damage, in_nation);
+					state.world.nation_set_war_exhaustion(in_nation, std::min(current_war_ex + extra_war_ex, state.world.nation_get_modifier_values(in_nation, sys::national_mod_offsets::max_war_exhaustion)));
+				}
+				if(backing_pop) {
+					auto& psize = state.world.pop_get_size(backing_pop);
+					float damage_modifier = std::max(state.defines.soldier_to_pop_damage - state.world.nation_get_modifier_values(tech_nation, sys::national_mod_offsets::soldier_to_pop_loss), 0.0f);
+					state.world.pop_set_size(backing_pop, psize - state.defines.pop_size_per_regiment * pending_attrition_damage * damage_modifier);
+				}
+				state.world.regiment_set_pending_attrition_damage(s, 0.0f);
+			}
+
+			auto psize = state.world.pop_get_size(backing_pop);
+			// Check if the regiment has no attached pop without having been deleted (from demotion, migration etc).
+			// The find soldier function cannot find a pop for an invalid nation id (rebel armies) so it will take care of that
+			if(!bool(backing_pop)) {
+				// try to find a new pop to replace the old. if not possible, then delete the regiment
+				auto new_pop = military::find_available_soldier_anywhere(state, in_nation, state.world.regiment_get_type(s));
+				if(bool(new_pop)) {
+					state.world.try_create_regiment_source(s, new_pop);
+				}
+				else {
+					military::delete_regiment_safe_wrapper(state, s);
+				}
+			}
+			else if(psize <= 1.0f) {
+				// try to find a new pop
+				auto new_pop = military::find_available_soldier_anywhere(state, in_nation, state.world.regiment_get_type(s));
+				if(bool(new_pop)) {
+					state.world.try_create_regiment_source(s, new_pop);
+				}
+				else {
+					military::delete_regiment_safe_wrapper(state, s);
+				}
+				state.world.delete_pop(backing_pop);
+			}
+		}
+	}
+}
+
+// losses drawn from the game seed, so that two states loaded from the same save get the same ones; some backing pops are nearly used up, so that regiments get replaced or deleted
+void inflict_damage(sys::state& state, uint32_t round) {
+	for(uint32_t i = 0; i < state.world.regiment_size(); ++i) {
+		dcon::regiment_id r{ dcon::regiment_id::value_base_t(i) };
+		if(!state.world.regiment_is_valid(r))
+			continue;
+		auto roll = rng::get_random(state, round, i);
+		if(rng::reduce(uint32_t(roll), 3) == 0)
+			state.world.regiment_set_pending_combat_damage(r, 0.01f * float(1 + rng::reduce(uint32_t(roll >> 8), 7)));
+		if(rng::reduce(uint32_t(roll >> 16), 5) == 0)
+			state.world.regiment_set_pending_attrition_damage(r, 0.02f);
+		if(rng::reduce(uint32_t(roll >> 32), 97) == 0) {
+			if(auto p = state.world.regiment_get_pop_from_regiment_source(r); p)
+				state.world.pop_set_size(p, 2.0f);
+		}
+	}
+}
+
+// regiment by regiment: the same regiments survive, with the same strength, organization, pending damage and backing pop, and the same men died
+void compare_damage_results(sys::state& reference, sys::state& state) {
+	REQUIRE(reference.world.regiment_size() == state.world.regiment_size());
+	for(uint32_t i = 0; i < state.world.regiment_size(); ++i) {
+		dcon::regiment_id r{ dcon::regiment_id::value_base_t(i) };
+		REQUIRE(reference.world.regiment_is_valid(r) == state.world.regiment_is_valid(r));
+		if(!state.world.regiment_is_valid(r))
+			continue;
+		REQUIRE(reference.world.regiment_get_strength(r) == state.world.regiment_get_strength(r));
+		REQUIRE(reference.world.regiment_get_org(r) == state.world.regiment_get_org(r));
+		REQUIRE(reference.world.regiment_get_pending_combat_damage(r) == state.world.regiment_get_pending_combat_damage(r));
+		REQUIRE(reference.world.regiment_get_pending_attrition_damage(r) == state.world.regiment_get_pending_attrition_damage(r));
+		auto reference_pop = reference.world.regiment_get_pop_from_regiment_source(r);
+		auto pop = state.world.regiment_get_pop_from_regiment_source(r);
+		REQUIRE(reference_pop == pop);
+		if(pop)
+			REQUIRE(reference.world.pop_get_size(reference_pop) == state.world.pop_get_size(pop));
+	}
+	REQUIRE(reference.world.pop_size() == state.world.pop_size());
+	for(auto p : state.world.in_pop)
+		REQUIRE(reference.world.pop_get_size(p) == p.get_size());
+	for(auto n : state.world.in_nation)
+		REQUIRE(reference.world.nation_get_war_exhaustion(n) == n.get_war_exhaustion());
+}
+
+// update_movement as it was before the arrival checks were gathered in parallel, kept to check that the results are unchanged
+void reference_update_movement(sys::state& state) {
+	using namespace military;
+	update_supply_fields(state);
+
+	// Army movement
+	for(auto a : state.world.in_army) {
+		if(!army_has_movement_work(state, a))
+			continue;
+		auto arrival = a.get_arrival_time();
+		auto path = a.get_path();
+		auto from = state.world.army_get_location_from_army_location(a);
+		auto army_owner = state.world.army_get_controller_from_army_control(a);
+		assert(!arrival || arrival >= state.current_date);
+
+		// If army is moving and in battle, we skip and increment the arrival date by one so they save their movement progress until the battle is over
+		if(arrival != sys::date{} && a.get_battle_from_army_battle_participation()) {
+			a.set_arrival_time(arrival + 1);
+			continue;
+		}
+
+		// US7AC1 Handle "move to siege" order
+		if (path.size() > 0 && army_owner && a.get_special_order() == military::special_army_order::move_to_siege) {
+			// Army was ordered to chain siege and it has not yet finished siege
+			auto province_controller = state.world.province_get_nation_from_province_control(from);
+
+			// Must be able to siege the province the army is in
+			if(siege_potential(state, army_owner, province_controller) && state.world.province_get_nation_from_province_control(from) != army_owner && command::can_stop_army_movement(state, army_owner, a)) {
+				// Delay the army until it finishes siege
+				state.world.army_set_arrival_time(a, sys::date{ });
+				state.world.army_set_unused_travel_days(a, 0.0f);
+				continue;
+			}
+			else if (arrival == sys::date{}) {
+				auto next_dest = path.at(path.size() - 1);
+				auto arrival_data = arrival_time_to(state, a, next_dest);
+				state.world.army_set_arrival_time(a, arrival_data.arrival_time);
+				state.world.army_set_unused_travel_days(a, arrival_data.unused_travel_days);
+			}
+		}
+		// US8AC1 Handle "strategic redeployment" order
+		else if(path.size() > 0 && army_owner && a.get_special_order() == military::special_army_order::strategic_redeployment) {
+			// While moving - limit the org
+			for(auto r : state.world.army_get_army_membership(a)) {
+				r.get_regiment().set_org(0.1f);
+			}
+		}
+		// US8AC1 Movement finished - reset the order to let army reorg
+		else if(path.size() == 0 && a.get_special_order() == military::special_army_order::strategic_redeployment) {
+			a.set_special_order(military::special_army_order::none);
+		}
+
+		// US5AC1 Army arrives to province
+		if(arrival == state.current_date) {
+			assert(path.size() > 0);
+			auto dest = path.at(path.size() - 1);
+			path.pop_back();
+
+			state.world.army_set_is_retreating(a, false); // can only be in the retreating state for max 1 province arrivial
+			auto adj = state.world.get_province_adjacency_by_province_pair(dest, from);
+			crossing_type crossing = get_crossing_type(state, adj);
+			// Can the army reach the target
+			if(dest.index() >= state.province_definitions.first_sea_province.index()) { // sea province
+				// check for embarkation possibility, then embark
+				auto to_navy = find_embark_target(state, a.get_controller_from_army_control(), dest, a);
+				if(to_navy) {
+					a.set_location_from_army_location(dest);
+					a.set_navy_from_army_transport(to_navy);
+					a.set_black_flag(false);
+				} else {
+					// if there are not enough transports by the time the movement happens, eject them back to land and check for enemy armies to collide with
+					stop_army_movement(state, a);
+					a.set_is_retreating(false);
+					army_arrives_in_province(state, a, from, crossing, dcon::land_battle_id{});
+				}
+			} else { // land province
+				if(a.get_black_flag()) {
+					auto n = state.world.province_get_nation_from_province_ownership(dest);
+					// Since AI and pathfinding can lead armies into unowned provinces that are completely locked by other nations,
+					// make armies go back to home territories for black flag removal
+					if(n == a.get_controller_from_army_control().id) {
+						a.set_black_flag(false);
+					}
+					army_arrives_in_province<apply_attrition_on_arrival::yes>(state, a, dest, crossing, dcon::land_battle_id{});
+					a.set_navy_from_army_transport(dcon::navy_id{});
+				} else if(province::has_access_to_province(state, a.get_controller_from_army_control(), dest)) {
+					if(auto n = a.get_navy_from_army_transport()) {
+						if(!n.get_battle_from_navy_battle_participation()) {
+							army_arrives_in_province<apply_attrition_on_arrival::yes>(state, a, dest, crossing, dcon::land_battle_id{});
+							a.set_navy_from_army_transport(dcon::navy_id{});
+						} else {
+							stop_army_movement(state, a);
+						}
+					} else {
+						auto path_bits = state.world.province_adjacency_get_type(adj);
+						if((path_bits & province::border::non_adjacent_bit) != 0 && province::is_crossing_blocked(state, a.get_controller_from_army_control(), from, dest)) { // strait crossing which is blocked
+							// if the strait is blocked by the time the movement happens, stop the unit and check for enemy armies to collide with
+							stop_army_movement(state, a);
+							a.set_is_retreating(false);
+							army_arrives_in_province<apply_attrition_on_arrival::no>(state, a, from, crossing, dcon::land_battle_id{});
+						} else {
+							army_arrives_in_province<apply_attrition_on_arrival::yes>(state, a, dest, crossing, dcon::land_battle_id{});
+						}
+					}
+				} else {
+					// if the dest prov is inaccesible when the movement happens, stop movement and check for collision with enemy armies
+					stop_army_movement(state, a);
+					a.set_is_retreating(false);
+					army_arrives_in_province(state, a, from, crossing, dcon::land_battle_id{});
+				}
+			}
+
+			// Handle pursue to engage special order
+			if(!a.get_battle_from_army_battle_participation() && a.get_special_order() == military::special_army_order::pursue_to_engage) {
+				auto target_army = a.get_army_pursuit_as_source().get_target();
+
+				if(!target_army) {
+					state.world.army_set_special_order(a, military::special_army_order::none);
+					continue;
+				}
+				
+				// Update the path
+				auto npath = command::can_move_army(state, army_owner, a, state.world.army_get_location_from_army_location(target_army), true);
+
+				// Has valid path and has to change direction
+				if(npath.size() > 0) {
+					auto new_next_dest = npath.at(npath.size() - 1);
+					auto cur_next_dest = path.at(path.size() - 1);
+					if(cur_next_dest != new_next_dest) {
+						command::execute_move_army(state, army_owner, a, state.world.army_get_location_from_army_location(target_army), true, military::special_army_order::pursue_to_engage);
+					}
+				}
+				else {
+					// Continue moving to the last known location
+					state.world.army_set_special_order(a, military::special_army_order::none);
+				}
+			}
+
+			if(path.size() > 0) {
+				// Army was ordered chain move
+				auto next_dest = path.at(path.size() - 1);
+				update_movement_arrival_days_on_unit(state, next_dest, a.get_location_from_army_location(), a.id);
+			} else {
+				a.set_arrival_time(sys::date{});
+				a.set_unused_travel_days(0.0f);
+				if(a.get_is_retreating()) {
+					a.set_is_retreating(false);
+				}
+				if(a.get_moving_to_merge()) {
+					a.set_moving_to_merge(false);
+					[&]() {
+						for(auto ar : state.world.province_get_army_location(dest)) {
+							if(ar.get_army().get_controller_from_army_control() == a.get_controller_from_army_control() && ar.get_army() != a && !ar.get_army().get_moving_to_merge()) {
+								auto regs = state.world.army_get_army_membership(a);
+								while(regs.begin() != regs.end()) {
+									(*regs.begin()).set_army(ar.get_army());
+								}
+								queue_for_gc(state, a.id);
+								return;
+							}
+						}
+						}();
+				}
+				if(state.world.army_get_is_rebel_hunter(a)
+					&& state.world.province_get_nation_from_province_control(dest)
+					&& state.world.nation_get_is_player_controlled(state.world.army_get_controller_from_army_control(a))
+					&& !state.world.army_get_battle_from_army_battle_participation(a)
+					&& !state.world.army_get_navy_from_army_transport(a)) {
+
+					military::send_rebel_hunter_to_next_province(state, a, state.world.army_get_location_from_army_location(a));
+				}
+			}
+		}
+		}
+
+	// Navy movement
+	for(auto n : state.world.in_navy) {
+		if(n.get_arrival_time() == sys::date{}) // only the navies that are moving do anything
+			continue;
+		auto arrival = n.get_arrival_time();
+		assert(!arrival || arrival >= state.current_date);
+		if(arrival != sys::date{} && n.get_battle_from_navy_battle_participation()) {
+			n.set_arrival_time(arrival + 1);
+			continue;
+		}
+		if(auto path = n.get_path(); arrival == state.current_date) {
+			assert(path.size() > 0);
+			auto from = n.get_location_from_navy_location();
+			auto dest = path.at(path.size() - 1);
+			path.pop_back();
+
+			if(dest.index() < state.province_definitions.first_sea_province.index()) { // land province
+				if(province::has_naval_access_to_province(state, n.get_controller_from_navy_control(), dest)) {
+
+					navy_arrives_in_province(state, n, dest, dcon::naval_battle_id{ });
+
+					// check for whether there are troops to disembark
+					auto attached = state.world.navy_get_army_transport(n);
+					while(attached.begin() != attached.end()) {
+						auto a = (*attached.begin()).get_army();
+
+						a.set_navy_from_army_transport(dcon::navy_id{});
+						stop_army_movement(state, a);
+						auto acontroller = a.get_controller_from_army_control();
+
+						// ai code
+						if(acontroller && !acontroller.get_is_player_controlled()) {
+							auto army_dest = a.get_ai_province();
+							a.set_location_from_army_location(dest);
+							if(army_dest && army_dest != dest) {
+								auto apath = province::make_land_unit_path(state, dest, army_dest, acontroller, a);
+								if(apath.size() > 0) {
+									set_army_path(state, a, apath, acontroller);
+									auto activity = ai::army_activity(a.get_ai_activity());
+									if(activity == ai::army_activity::transport_guard) {
+										a.set_ai_activity(uint8_t(ai::army_activity::on_guard));
+									} else if(activity == ai::army_activity::transport_attack) {
+										a.set_ai_activity(uint8_t(ai::army_activity::attack_gathered));
+									}
+								} else {
+									a.set_ai_activity(uint8_t(ai::army_activity::on_guard));
+								}
+							} else {
+								a.set_ai_activity(uint8_t(ai::army_activity::on_guard));
+							}
+						}
+						army_arrives_in_province(state, a, dest, military::crossing_type::sea, dcon::land_battle_id{});
+					}
+				} else {
+					// if the destination province becomes inaccesible by the time the movement happens, stop movement and check for enemy navy collision
+					stop_navy_movement(state, n);
+					n.set_is_retreating(false);
+					navy_arrives_in_province(state, n, from, dcon::naval_battle_id{});
+				}
+			} else { // sea province
+
+				auto adj = state.world.get_province_adjacency_by_province_pair(dest, from);
+				auto path_bits = state.world.province_adjacency_get_type(adj);
+				if((path_bits & province::border::non_adjacent_bit) != 0 && province::is_crossing_blocked(state, n.get_controller_from_navy_control(), adj)) { // hostile canal crossing
+					// if the canal province becomes hostile by the time the movement happens, stop movement and check for enemy navy collision
+					stop_navy_movement(state, n);
+					n.set_is_retreating(false);
+					navy_arrives_in_province(state, n, from, dcon::naval_battle_id{});
+					
+				}
+				else {
+					navy_arrives_in_province(state, n, dest, dcon::naval_battle_id{});
+
+					// take embarked units along with
+					for(auto a : state.world.navy_get_army_transport(n)) {
+						a.get_army().set_location_from_army_location(dest);
+						stop_army_movement(state, a.get_army());
+					}
+				}
+			}
+
+			if(path.size() > 0) {
+				auto next_dest = path.at(path.size() - 1);
+				update_movement_arrival_days_on_unit(state, next_dest, n.get_location_from_navy_location(), n.id);
+			} else {
+				n.set_arrival_time(sys::date{});
+				n.set_unused_travel_days(0.0f);
+				if(n.get_is_retreating()) {
+					n.set_is_retreating(false);
+				}
+				if(n.get_moving_to_merge()) {
+					n.set_moving_to_merge(false);
+					[&]() {
+						for(auto ar : state.world.province_get_navy_location(dest)) {
+							if(ar.get_navy().get_controller_from_navy_control() == n.get_controller_from_navy_control() && ar.get_navy() != n && !ar.get_navy().get_moving_to_merge()) {
+								auto regs = state.world.navy_get_navy_membership(n);
+								while(regs.begin() != regs.end()) {
+									(*regs.begin()).set_navy(ar.get_navy());
+								}
+								auto a = state.world.navy_get_army_transport(n);
+								while(a.begin() != a.end()) {
+									(*a.begin()).set_navy(ar.get_navy());
+								}
+								queue_for_gc(state, n.id);
+								return;
+							}
+						}
+						}();
+				}
+			}
+		}
+	}
+}
+
+std::vector<float> record_damage_results(sys::state& state) {
+	std::vector<float> result;
+	for(uint32_t i = 0; i < state.world.regiment_size(); ++i) {
+		dcon::regiment_id r{ dcon::regiment_id::value_base_t(i) };
+		result.push_back(state.world.regiment_is_valid(r) ? 1.0f : 0.0f);
+		if(state.world.regiment_is_valid(r)) {
+			result.push_back(state.world.regiment_get_pending_combat_damage(r));
+			result.push_back(state.world.regiment_get_pending_attrition_damage(r));
+			result.push_back(float(state.world.regiment_get_pop_from_regiment_source(r).index()));
+		}
+	}
+	for(auto p : state.world.in_pop)
+		result.push_back(p.get_size());
+	for(auto n : state.world.in_nation)
+		result.push_back(n.get_war_exhaustion());
+	return result;
+}
+
+// the occupation, blockade and war goal parts of the primary war score as they were counted before they were cached on the war
+float reference_warscore_from_occupation(sys::state& state, dcon::war_id w) {
+	float total = 0.0f;
+
+	auto pattacker = state.world.war_get_primary_attacker(w);
+	auto pdefender = state.world.war_get_primary_defender(w);
+
+	float sum_attacker_prov_values = 0;
+	float sum_attacker_occupied_values = 0;
+	for(auto prv : state.world.nation_get_province_ownership(pattacker)) {
+		auto v = (float)military::province_point_cost(state, prv.get_province(), pattacker);
+		sum_attacker_prov_values += v;
+		sum_attacker_occupied_values += military::share_province_score_for_war_occupation(state, w, prv.get_province()) * v;
+	}
+
+	float sum_defender_prov_values = 0;
+	float sum_defender_occupied_values = 0;
+	for(auto prv : state.world.nation_get_province_ownership(pdefender)) {
+		auto v = (float)military::province_point_cost(state, prv.get_province(), pdefender);
+		sum_defender_prov_values += v;
+		sum_defender_occupied_values += military::share_province_score_for_war_occupation(state, w, prv.get_province()) * v;
+	}
+	if(sum_defender_prov_values > 0) {
+		float defender_total = (sum_defender_occupied_values * 100.0f) / sum_defender_prov_values;
+		if(defender_total >= 100.0f)
+			return defender_total;
+		total += defender_total;
+	}
+	if(sum_attacker_prov_values > 0) {
+		float attacker_total = (sum_attacker_occupied_values * 100.0f) / sum_attacker_prov_values;
+		if(attacker_total >= 100.0f)
+			return -attacker_total;
+		total -= attacker_total;
+	}
+	return total;
+}
+
+float reference_warscore_from_blockades(sys::state& state, dcon::war_id w) {
+	auto count_blockaded = [&](dcon::nation_id n, military::war_role enemy) {
+		int32_t blockaded_in_war = 0;
+		for(auto p : state.world.nation_get_province_ownership(n)) {
+			if(military::province_is_blockaded(state, p.get_province()) && !province::is_overseas(state, p.get_province().id)) {
+				for(auto v : state.world.province_get_navy_location(p.get_province().get_port_to())) {
+					if(!v.get_navy().get_is_retreating() && !v.get_navy().get_battle_from_navy_battle_participation()) {
+						if(military::get_role(state, w, v.get_navy().get_controller_from_navy_control()) == enemy) {
+							++blockaded_in_war;
+							break;
+						}
+					}
+				}
+			}
+		}
+		return blockaded_in_war;
+	};
+	auto pattacker = state.world.war_get_primary_attacker(w);
+	auto pdefender = state.world.war_get_primary_defender(w);
+	auto d_cpc = state.world.nation_get_central_ports(pdefender);
+	auto def_b_frac = std::clamp(d_cpc > 0 ? float(count_blockaded(pdefender, military::war_role::attacker)) / float(d_cpc) : 0.0f, 0.0f, 1.0f);
+	auto a_cpc = state.world.nation_get_central_ports(pattacker);
+	auto att_b_frac = std::clamp(a_cpc > 0 ? float(count_blockaded(pattacker, military::war_role::defender)) / float(a_cpc) : 0.0f, 0.0f, 1.0f);
+	return 25.0f * (def_b_frac - att_b_frac);
+}
+
+float reference_warscore_from_war_goals(sys::state& state, dcon::war_id w) {
+	float total = 0.0f;
+	for(auto wg : state.world.war_get_wargoals_attached(w)) {
+		if(military::is_attacker(state, w, wg.get_wargoal().get_added_by()))
+			total += wg.get_wargoal().get_ticking_war_score();
+		else
+			total -= wg.get_wargoal().get_ticking_war_score();
+	}
+	return total;
+}
+
+void compare_war_scores_with_reference(sys::state& state) {
+	for(auto w : state.world.in_war) {
+		REQUIRE(military::primary_warscore_from_occupation(state, w) == reference_warscore_from_occupation(state, w));
+		REQUIRE(military::primary_warscore_from_blockades(state, w) == reference_warscore_from_blockades(state, w));
+		REQUIRE(military::primary_warscore_from_war_goals(state, w) == reference_warscore_from_war_goals(state, w));
+	}
+}
+
+}
+
+TEST_CASE("war_relations_match_brute_force", "[military]") {
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *game_state;
+
+	military_test::start_wars(state, 48);
+	REQUIRE(state.military_definitions.war_relations_out_of_date);
+	military_test::compare_with_brute_force(state);
+
+	// leaving a war marks the tables stale, and the queries walk the wars until the next rebuild
+	auto w = *state.world.in_war.begin();
+	auto leaving = (*w.get_war_participant().begin()).get_nation();
+	military::remove_from_war(state, w, leaving, false);
+	REQUIRE(state.military_definitions.war_relations_out_of_date);
+	for(auto b : state.world.in_nation)
+		REQUIRE(military::are_at_war(state, leaving, b) == military_test::brute_force_at_war(state, leaving, b));
+	military_test::compare_with_brute_force(state);
+
+	for(int32_t i = 0; i < 30; ++i)
+		state.single_game_tick();
+	military_test::compare_with_brute_force(state);
+}
+
+TEST_CASE("regiment_damage_benchmark", "[.][military_bench]") {
+	std::unique_ptr<sys::state> reference_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& reference = *reference_state;
+	auto& state = *game_state;
+
+	military_test::start_wars(reference, 48);
+	military_test::start_wars(state, 48);
+
+	bench::function_result serial{ "serial apply_regiment_damage" };
+	bench::function_result vectorized{ "apply_regiment_damage" };
+	bench::result_hash hash;
+
+	for(uint32_t round = 0; round < 10; ++round) {
+		military_test::inflict_damage(reference, round);
+		military_test::inflict_damage(state, round);
+		bench::measure(reference, serial, false, [&]() {
+			military_test::reference_apply_regiment_damage(reference);
+		});
+		bench::measure(state, vectorized, false, [&]() {
+			military::apply_regiment_damage(state);
+		});
+		military_test::compare_damage_results(reference, state);
+		for(auto v : military_test::record_damage_results(state))
+			hash.add(v);
+	}
+	WARN(bench::report_line(serial));
+	WARN(bench::report_line(vectorized));
+
+	bench::require_recorded_result(state, "regiment_damage/apply_regiment_damage", hash.to_hex());
+}
+
+TEST_CASE("queued_gc_leaves_nothing_stale", "[military]") {
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *game_state;
+
+	// what the daily sweep used to delete, apart from the units still in a battle
+	auto require_nothing_stale = [&]() {
+		for(auto a : state.world.in_army) {
+			if(!a.get_battle_from_army_battle_participation()) {
+				REQUIRE(a.get_army_membership().begin() != a.get_army_membership().end());
+				REQUIRE(bool(a.get_controller_from_army_control() || a.get_controller_from_army_rebel_control()));
+			}
+		}
+		for(auto n : state.world.in_navy) {
+			if(!n.get_battle_from_navy_battle_participation()) {
+				REQUIRE(n.get_navy_membership().begin() != n.get_navy_membership().end());
+				REQUIRE(bool(n.get_controller_from_navy_control()));
+			}
+		}
+		for(auto po : state.world.in_peace_offer) {
+			REQUIRE(bool(po.get_nation_from_pending_peace_offer()));
+			REQUIRE(bool(po.get_war_from_war_settlement() || po.get_is_crisis_offer()));
+		}
+		for(auto wg : state.world.in_wargoal) {
+			REQUIRE(bool(wg.get_peace_offer_from_peace_offer_item() || wg.get_war_from_wargoals_attached()));
+		}
+	};
+
+	military::run_gc(state);
+	REQUIRE(!state.military_definitions.gc_full_sweep);
+	require_nothing_stale();
+
+	// splitting every regiment out of an army leaves it empty
+	for(auto a : state.world.in_army) {
+		if(a.get_battle_from_army_battle_participation() || !a.get_controller_from_army_control())
+			continue;
+		std::vector<dcon::regiment_id> regiments;
+		for(auto r : a.get_army_membership())
+			regiments.push_back(r.get_regiment());
+		if(regiments.empty())
+			continue;
+		military::split_army<command::actor::ai>(state, a.get_controller_from_army_control(), a, regiments);
+		REQUIRE(a.get_army_membership().begin() == a.get_army_membership().end());
+		break;
+	}
+	// ending a war orphans its peace offers and war goals
+	military_test::start_wars(state, 48);
+	auto w = *state.world.in_war.begin();
+	auto offer = fatten(state.world, state.world.create_peace_offer());
+	offer.set_target(w.get_primary_defender());
+	offer.set_war_from_war_settlement(w);
+	offer.set_nation_from_pending_peace_offer(w.get_primary_attacker());
+	military::cleanup_war(state, w, military::war_result::draw);
+
+	military::run_gc(state);
+	require_nothing_stale();
+
+	for(int32_t i = 0; i < 30; ++i) {
+		state.single_game_tick();
+		military::run_gc(state);
+		require_nothing_stale();
+	}
+}
+
+TEST_CASE("staged_notifications_keep_serial_order", "[military]") {
+	std::unique_ptr<sys::state> game_state = std::make_unique<sys::state>();
+	auto& state = *game_state;
+
+	// every iteration stages two messages, tagged with its index and their sequence
+	constexpr uint32_t count = 600;
+	for(uint32_t round = 0; round < 3; ++round) {
+		concurrency::parallel_for(uint32_t(0), count, [&](uint32_t i) {
+			for(uint32_t k = 0; k < 2; ++k) {
+				state.staged_messages.stage(i, notification::message{
+					.source = dcon::nation_id{ dcon::nation_id::value_base_t(i) },
+					.third = dcon::nation_id{ dcon::nation_id::value_base_t(k) },
+				});
+			}
+		});
+		REQUIRE(!state.staged_messages.empty());
+		state.staged_messages.flush(state);
+		REQUIRE(state.staged_messages.empty());
+
+		for(uint32_t i = 0; i < count; ++i) {
+			for(uint32_t k = 0; k < 2; ++k) {
+				auto* m = state.new_messages.front();
+				REQUIRE(m);
+				REQUIRE(m->source.index() == int32_t(i));
+				REQUIRE(m->third.index() == int32_t(k));
+				state.new_messages.pop();
+			}
+		}
+		REQUIRE(!state.new_messages.front());
+	}
+}
+
+TEST_CASE("attrition_from_supply_fields_matches_per_army_attrition", "[military]") {
+	std::unique_ptr<sys::state> reference_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& reference = *reference_state;
+	auto& state = *game_state;
+
+	// the weight of every army in the province, counted from the regiments
+	auto count_army_weight = [](sys::state& s, dcon::province_id prov) {
+		float total_army_weight = 0;
+		for(auto ar : s.world.province_get_army_location(prov)) {
+			if(ar.get_army().get_black_flag() == false && ar.get_army().get_is_retreating() == false) {
+				for(auto rg : ar.get_army().get_army_membership()) {
+					total_army_weight += (s.defines.pop_size_per_regiment / 1000.0f) * rg.get_regiment().get_strength();
+				}
+			}
+		}
+		return total_army_weight;
+	};
+	// apply_attrition as it was before the supply fields: every army counts the weight of its province itself, after the losses of the armies before it
+	auto per_army_attrition = [&](sys::state& s) {
+		military::update_supply_fields(s);
+		for(auto p : s.world.in_province) {
+			for(auto ar : p.get_army_location()) {
+				s.military_definitions.supply_army_weight[p.id.index()] = count_army_weight(s, p);
+				military::apply_attrition_to_army(s, ar.get_army());
+			}
+			for(auto nv : p.get_navy_location())
+				military::apply_monthly_attrition_to_navy(s, nv.get_navy());
+		}
+	};
+	// the fields follow the losses by subtracting the weight of each army, which rounds differently from a count of the whole province
+	auto compare = [&]() {
+		per_army_attrition(reference);
+		military::apply_attrition(state);
+		for(auto r : state.world.in_regiment) {
+			REQUIRE(r.get_strength() == Approx(reference.world.regiment_get_strength(r)));
+			REQUIRE(r.get_pending_attrition_damage() == Approx(reference.world.regiment_get_pending_attrition_damage(r)));
+		}
+		for(auto sh : state.world.in_ship)
+			REQUIRE(sh.get_strength() == reference.world.ship_get_strength(sh));
+		for(auto n : state.world.in_navy)
+			REQUIRE(n.get_months_outside_naval_range() == reference.world.navy_get_months_outside_naval_range(n));
+		for(auto p : state.world.in_province)
+			REQUIRE(military::local_army_weight(state, p) == Approx(count_army_weight(state, p)).margin(0.001));
+	};
+
+	compare();
+
+	// wars bring sieges, occupations and armies crowding into enemy provinces
+	military_test::start_wars(reference, 48);
+	military_test::start_wars(state, 48);
+	for(int32_t i = 0; i < 30; ++i) {
+		reference.single_game_tick();
+		state.single_game_tick();
+	}
+	compare();
+
+	// every army moved into the capital of its nation, well over the supply limit, so that several armies share each province
+	for(auto* s : { &reference, &state }) {
+		for(auto n : s->world.in_nation) {
+			auto armies = n.get_army_control();
+			if(armies.begin() == armies.end() || !n.get_capital())
+				continue;
+			for(auto a : armies) {
+				if(!a.get_army().get_battle_from_army_battle_participation() && !a.get_army().get_navy_from_army_transport())
+					a.get_army().set_location_from_army_location(n.get_capital());
+			}
+		}
+	}
+	for(int32_t i = 0; i < 3; ++i)
+		compare();
+}
+
+TEST_CASE("movement_with_parallel_arrival_checks_matches_serial_movement", "[military]") {
+	std::unique_ptr<sys::state> reference_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& reference = *reference_state;
+	auto& state = *game_state;
+
+	// wars keep armies and fleets marching, embarking, meeting in battle and merging
+	military_test::start_wars(reference, 48);
+	military_test::start_wars(state, 48);
+
+	for(int32_t day = 0; day < 40; ++day) {
+		military_test::reference_update_movement(reference);
+		military::update_movement(state);
+
+		REQUIRE(reference.world.army_size() == state.world.army_size());
+		for(uint32_t i = 0; i < state.world.army_size(); ++i) {
+			dcon::army_id a{ dcon::army_id::value_base_t(i) };
+			REQUIRE(reference.world.army_is_valid(a) == state.world.army_is_valid(a));
+			if(!state.world.army_is_valid(a))
+				continue;
+			REQUIRE(reference.world.army_get_location_from_army_location(a) == state.world.army_get_location_from_army_location(a));
+			REQUIRE(reference.world.army_get_arrival_time(a) == state.world.army_get_arrival_time(a));
+			REQUIRE(reference.world.army_get_unused_travel_days(a) == state.world.army_get_unused_travel_days(a));
+			REQUIRE(reference.world.army_get_is_retreating(a) == state.world.army_get_is_retreating(a));
+			REQUIRE(reference.world.army_get_black_flag(a) == state.world.army_get_black_flag(a));
+			REQUIRE(reference.world.army_get_special_order(a) == state.world.army_get_special_order(a));
+			REQUIRE(reference.world.army_get_navy_from_army_transport(a) == state.world.army_get_navy_from_army_transport(a));
+			REQUIRE(reference.world.army_get_battle_from_army_battle_participation(a) == state.world.army_get_battle_from_army_battle_participation(a));
+			auto reference_path = reference.world.army_get_path(a);
+			auto path = state.world.army_get_path(a);
+			REQUIRE(reference_path.size() == path.size());
+			for(uint32_t k = 0; k < path.size(); ++k)
+				REQUIRE(reference_path.at(k) == path.at(k));
+		}
+		for(auto r : state.world.in_regiment) {
+			REQUIRE(reference.world.regiment_get_army_from_army_membership(r) == r.get_army_from_army_membership());
+			REQUIRE(reference.world.regiment_get_strength(r) == r.get_strength());
+			REQUIRE(reference.world.regiment_get_org(r) == r.get_org());
+		}
+		REQUIRE(reference.world.navy_size() == state.world.navy_size());
+		for(uint32_t i = 0; i < state.world.navy_size(); ++i) {
+			dcon::navy_id n{ dcon::navy_id::value_base_t(i) };
+			REQUIRE(reference.world.navy_is_valid(n) == state.world.navy_is_valid(n));
+			if(!state.world.navy_is_valid(n))
+				continue;
+			REQUIRE(reference.world.navy_get_location_from_navy_location(n) == state.world.navy_get_location_from_navy_location(n));
+			REQUIRE(reference.world.navy_get_arrival_time(n) == state.world.navy_get_arrival_time(n));
+			REQUIRE(reference.world.navy_get_unused_travel_days(n) == state.world.navy_get_unused_travel_days(n));
+			REQUIRE(reference.world.navy_get_battle_from_navy_battle_participation(n) == state.world.navy_get_battle_from_navy_battle_participation(n));
+		}
+		REQUIRE(reference.world.land_battle_size() == state.world.land_battle_size());
+		REQUIRE(reference.world.naval_battle_size() == state.world.naval_battle_size());
+
+		// the rest of the day is the same code for both
+		reference.single_game_tick();
+		state.single_game_tick();
+	}
+}
+
+TEST_CASE("batched_control_changes_match_single_changes", "[military]") {
+	std::unique_ptr<sys::state> single_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	std::unique_ptr<sys::state> batch_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& single = *single_state;
+	auto& batch = *batch_state;
+
+	// every fifth owned land province is occupied by a neighbor, and every seventh given back to its owner afterwards
+	std::vector<province::controller_change> changes;
+	for(auto p : batch.world.in_province) {
+		if(p.id.index() >= batch.province_definitions.first_sea_province.index())
+			break;
+		if(!p.get_nation_from_province_ownership() || p.id.index() % 5 != 0)
+			continue;
+		for(auto adj : p.get_province_adjacency()) {
+			auto other = adj.get_connected_provinces(0) == p ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			if(other.get_nation_from_province_ownership() && other.get_nation_from_province_ownership() != p.get_nation_from_province_ownership()) {
+				changes.push_back(province::controller_change{ p, other.get_nation_from_province_ownership(), dcon::rebel_faction_id{ } });
+				break;
+			}
+		}
+	}
+	for(auto& c : std::vector<province::controller_change>(changes)) {
+		if(c.province.index() % 7 == 0)
+			changes.push_back(province::controller_change{ c.province, batch.world.province_get_nation_from_province_ownership(c.province), dcon::rebel_faction_id{ } });
+	}
+	REQUIRE(!changes.empty());
+
+	for(auto& c : changes)
+		province::set_province_controller(single, c.province, c.nation);
+	province::set_province_controllers(batch, changes);
+
+	province::update_cached_values(single);
+	province::update_cached_values(batch);
+	for(auto p : batch.world.in_province) {
+		REQUIRE(p.get_nation_from_province_control() == single.world.province_get_nation_from_province_control(p));
+		REQUIRE(p.get_last_control_change() == single.world.province_get_last_control_change(p));
+	}
+	for(auto n : batch.world.in_nation) {
+		REQUIRE(n.get_occupied_count() == single.world.nation_get_occupied_count(n));
+		REQUIRE(n.get_rebel_controlled_count() == single.world.nation_get_rebel_controlled_count(n));
+		REQUIRE(n.get_central_blockaded() == single.world.nation_get_central_blockaded(n));
+		REQUIRE(n.get_owned_province_count() == single.world.nation_get_owned_province_count(n));
+		REQUIRE(n.get_central_province_count() == single.world.nation_get_central_province_count(n));
+	}
+	REQUIRE(batch.military_definitions.pending_blackflag_update);
+}
+
+TEST_CASE("cached_war_scores_match_recounting", "[military]") {
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *game_state;
+
+	military_test::start_wars(state, 48);
+	military::update_war_scores(state);
+	REQUIRE(state.world.war_size() > 0);
+	for(auto w : state.world.in_war)
+		REQUIRE(w.get_war_score_current_parts() == military::war_score_part::all);
+	military_test::compare_war_scores_with_reference(state);
+
+	// an occupation marks only the territory of the owner stale, which is counted directly until the next update
+	auto w = *state.world.in_war.begin();
+	auto attacker = w.get_primary_attacker();
+	auto defender = w.get_primary_defender();
+	dcon::province_id occupied;
+	for(auto o : defender.get_province_ownership()) {
+		if(o.get_province().get_nation_from_province_control() == defender) {
+			occupied = o.get_province();
+			break;
+		}
+	}
+	REQUIRE(occupied);
+	province::set_province_controller(state, occupied, attacker);
+	REQUIRE((w.get_war_score_current_parts() & military::war_score_part::defender_occupation) == 0);
+	REQUIRE((w.get_war_score_current_parts() & military::war_score_part::attacker_occupation) != 0);
+	military_test::compare_war_scores_with_reference(state);
+	military::update_war_scores(state);
+	REQUIRE(w.get_war_score_current_parts() == military::war_score_part::all);
+	military_test::compare_war_scores_with_reference(state);
+
+	// the reads between updates and right after them agree with recounting as control, blockades, fleets and war goals change
+	for(int32_t i = 0; i < 30; ++i) {
+		state.single_game_tick();
+		military_test::compare_war_scores_with_reference(state);
+	}
+}
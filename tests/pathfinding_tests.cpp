@@ -578,3 +578,612 @@ TEST_CASE("make_path_to_expression_profiling_AStar", "[pathfinding_profiling]")
 
 
 
+
+TEST_CASE("path_cache_matches_uncached", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	std::vector<std::pair<dcon::province_id, dcon::province_id>> land_pairs;
+	std::vector<std::pair<dcon::province_id, dcon::province_id>> coast_pairs;
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	for(uint32_t i = 0; i < land_count; i += 37) {
+		dcon::province_id a{ dcon::province_id::value_base_t(i) };
+		dcon::province_id b{ dcon::province_id::value_base_t((i * 7 + 101) % land_count) };
+		land_pairs.emplace_back(a, b);
+		if(state.world.province_get_is_coast(a) && state.world.province_get_is_coast(b))
+			coast_pairs.emplace_back(a, b);
+	}
+
+	auto compare_all = [&]() {
+		for(auto [a, b] : land_pairs) {
+			auto n = state.world.province_get_nation_from_province_ownership(a);
+			REQUIRE(province::cached::make_safe_land_path(state, a, b, n) == province::make_safe_land_path(state, a, b, n));
+			REQUIRE(province::cached::make_land_trade_path(state, a, b) == province::make_land_trade_path(state, a, b));
+		}
+		for(auto [a, b] : coast_pairs) {
+			auto n = state.world.province_get_nation_from_province_ownership(a);
+			REQUIRE(province::cached::make_naval_unit_path(state, a, b, n) == province::make_naval_unit_path(state, a, b, n));
+		}
+	};
+
+	compare_all(); // filled on a miss
+	compare_all(); // served from the cache
+
+	for(int32_t i = 0; i < 60; ++i) {
+		state.single_game_tick();
+		if(i % 10 == 0)
+			compare_all();
+	}
+
+	// a change of control must not be served from stale entries
+	auto [a, b] = land_pairs[land_pairs.size() / 2];
+	auto n = state.world.province_get_nation_from_province_ownership(a);
+	REQUIRE(province::cached::make_safe_land_path(state, a, b, n) == province::make_safe_land_path(state, a, b, n));
+	for(auto [p, q] : land_pairs) {
+		if(p != a && state.world.province_get_nation_from_province_ownership(p) != n) {
+			province::set_province_controller(state, p, n);
+		}
+	}
+	REQUIRE(province::cached::make_safe_land_path(state, a, b, n) == province::make_safe_land_path(state, a, b, n));
+	compare_all();
+
+	// nor from entries found before a change of military access
+	for(auto [p, q] : land_pairs) {
+		auto owner = state.world.province_get_nation_from_province_ownership(p);
+		auto other = state.world.province_get_nation_from_province_ownership(q);
+		if(owner && other && owner != other)
+			military::give_military_access(state, owner, other);
+	}
+	compare_all();
+}
+
+TEST_CASE("hierarchical_path_matches_exact", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	auto adj_func = [&](auto to, auto from, dcon::province_adjacency_id adj) {
+		return (state.world.province_adjacency_get_type(adj) & province::border::impassible_bit) == 0;
+	};
+	auto prov_func = [&](dcon::province_id to_prov) {
+		return to_prov.index() < state.province_definitions.first_sea_province.index();
+	};
+	auto mod_func = [&](auto to_prov, auto from_prov, auto adj, float dist) { return dist; };
+
+	// paths are stored from the end back to the start, without the start itself
+	auto path_cost = [&](dcon::province_id start, std::vector<dcon::province_id> const& path) {
+		float total = 0.0f;
+		auto from = start;
+		for(auto i = path.size(); i-- > 0;) {
+			auto adj = state.world.get_province_adjacency_by_province_pair(path[i], from);
+			REQUIRE(bool(adj));
+			REQUIRE(adj_func(path[i], from, adj));
+			REQUIRE(prov_func(path[i]));
+			total += mod_func(path[i], from, adj, state.world.province_adjacency_get_distance(adj));
+			from = path[i];
+		}
+		return total;
+	};
+
+	// the shortest distances come from a distance field, which does not share the open queue order of the pair searches
+	province::distance_field shortest;
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	double exact_total = 0.0;
+	double hierarchical_total = 0.0;
+	float worst_ratio = 1.0f;
+	for(uint32_t i = 0; i < land_count; i += 23) {
+		dcon::province_id a{ dcon::province_id::value_base_t(i) };
+		dcon::province_id b{ dcon::province_id::value_base_t((i * 13 + 577) % land_count) };
+		if(a == b)
+			continue;
+
+		province::fill_distance_field<province::search_direction::from_sources>(state, std::span<dcon::province_id const>(&a, 1), adj_func, prov_func, mod_func, shortest, std::span<dcon::province_id const>(&b, 1));
+		auto hierarchical = province::make_hierarchical_path_to_prov<1.0f>(state, a, b, adj_func, prov_func, mod_func);
+		REQUIRE(shortest.reached(b) == !hierarchical.empty());
+		if(hierarchical.empty())
+			continue;
+		REQUIRE(hierarchical.front() == b);
+
+		auto exact_cost = shortest.distance(b);
+		auto hierarchical_cost = path_cost(a, hierarchical);
+		REQUIRE(hierarchical_cost >= exact_cost * 0.999f);
+		exact_total += exact_cost;
+		hierarchical_total += hierarchical_cost;
+		if(exact_cost > 0.0f)
+			worst_ratio = std::max(worst_ratio, hierarchical_cost / exact_cost);
+	}
+	WARN("hierarchical / exact path cost: " << (hierarchical_total / exact_total) << ", worst: " << worst_ratio);
+	REQUIRE(hierarchical_total <= exact_total * 1.25);
+}
+
+TEST_CASE("region_hierarchy_incremental_matches_rebuild", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	auto compare_with_rebuild = [&]() {
+		province::update_region_hierarchy(state);
+		province::region_hierarchy fresh;
+		province::rebuild_region_hierarchy(state, fresh);
+
+		auto& current = state.region_hierarchy;
+		REQUIRE(current.province_cluster.size() == fresh.province_cluster.size());
+		// cluster numbering may differ, so compare what each province sees
+		for(auto p : state.world.in_province) {
+			auto& a = current.clusters[current.province_cluster[p.id.index()]];
+			auto& b = fresh.clusters[fresh.province_cluster[p.id.index()]];
+			REQUIRE(a.key == b.key);
+			REQUIRE(a.provinces == b.provinces);
+			REQUIRE(a.center == b.center);
+			REQUIRE(a.portals.size() == b.portals.size());
+			for(uint32_t i = 0; i < a.portals.size(); ++i) {
+				REQUIRE(a.portals[i].adjacency == b.portals[i].adjacency);
+				REQUIRE(current.clusters[a.portals[i].to_cluster].key == fresh.clusters[b.portals[i].to_cluster].key);
+			}
+		}
+	};
+
+	compare_with_rebuild();
+
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	for(uint32_t i = 0; i < land_count; i += 41) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		dcon::province_id q{ dcon::province_id::value_base_t((i * 7 + 101) % land_count) };
+		auto n = state.world.province_get_nation_from_province_ownership(q);
+		if(n && state.world.province_get_nation_from_province_ownership(p))
+			province::set_province_controller(state, p, n);
+	}
+	compare_with_rebuild();
+
+	for(int32_t i = 0; i < 30; ++i)
+		state.single_game_tick();
+	compare_with_rebuild();
+}
+
+TEST_CASE("path_workspace_reuse_matches_fresh_search", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	auto adj_func = [&](auto to, auto from, auto adj) { return true; };
+	auto prov_func = [&](dcon::province_id to_prov) {
+		return to_prov.index() < state.province_definitions.first_sea_province.index();
+	};
+	auto mod_func = [&](auto to_prov, auto from_prov, auto adj, float dist) { return dist; };
+
+	std::vector<dcon::province_id> reused;
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	for(uint32_t i = 0; i < land_count; i += 31) {
+		dcon::province_id a{ dcon::province_id::value_base_t(i) };
+		dcon::province_id b{ dcon::province_id::value_base_t((i * 11 + 313) % land_count) };
+		auto end_exp = [&](auto end_prov) { return end_prov == b; };
+
+		// the reference allocates and clears a full node array for every search, and visits provinces in the original order
+		auto reference = make_path_to_expression_tagged_vector_heap(state, a, adj_func, prov_func, mod_func, end_exp);
+		auto exact = province::make_path_to_prov<0.0f>(state, a, b, adj_func, prov_func, mod_func);
+		auto expression = province::make_path_to_expression(state, a, adj_func, prov_func, mod_func, end_exp);
+		REQUIRE(expression == reference);
+		REQUIRE(exact == reference);
+		if(!exact.empty()) {
+			REQUIRE(exact.front() == b);
+		}
+
+		// results written into a reused vector, after other searches have left their stamps in the workspace
+		province::make_path_to_prov<0.0f>(state, a, b, adj_func, prov_func, mod_func, reused);
+		REQUIRE(reused == exact);
+		province::make_path_to_expression(state, a, adj_func, prov_func, mod_func, end_exp, reused);
+		REQUIRE(reused == expression);
+
+		auto fast = province::make_path_to_prov_fast(state, a, b, adj_func, prov_func, mod_func);
+		province::make_path_to_prov_fast(state, a, b, adj_func, prov_func, mod_func, reused);
+		REQUIRE(reused == fast);
+		REQUIRE(fast.empty() == exact.empty());
+
+		auto expression_fast = province::make_path_to_expression_fast(state, a, adj_func, prov_func, mod_func, end_exp);
+		province::make_path_to_expression_fast(state, a, adj_func, prov_func, mod_func, end_exp, reused);
+		REQUIRE(reused == expression_fast);
+		REQUIRE(expression_fast.empty() == exact.empty());
+	}
+}
+
+TEST_CASE("distance_field_matches_pair_searches", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	auto adj_func = [&](auto to, auto from, dcon::province_adjacency_id adj) {
+		return (state.world.province_adjacency_get_type(adj) & province::border::impassible_bit) == 0;
+	};
+	auto prov_func = [&](dcon::province_id to_prov) {
+		return to_prov.index() < state.province_definitions.first_sea_province.index();
+	};
+	auto mod_func = [&](auto to_prov, auto from_prov, auto adj, float dist) { return dist; };
+
+	auto path_cost = [&](dcon::province_id start, std::vector<dcon::province_id> const& path) {
+		float total = 0.0f;
+		auto from = start;
+		for(auto i = path.size(); i-- > 0;) {
+			auto adj = state.world.get_province_adjacency_by_province_pair(path[i], from);
+			REQUIRE(bool(adj));
+			total += state.world.province_adjacency_get_distance(adj);
+			from = path[i];
+		}
+		return total;
+	};
+
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	dcon::province_id source{ dcon::province_id::value_base_t(land_count / 2) };
+	province::distance_field from_field;
+	province::distance_field to_field;
+	std::vector<dcon::province_id> field_path;
+	province::fill_distance_field<province::search_direction::from_sources>(state, std::span<dcon::province_id const>(&source, 1), adj_func, prov_func, mod_func, from_field);
+	province::fill_distance_field<province::search_direction::to_sources>(state, std::span<dcon::province_id const>(&source, 1), adj_func, prov_func, mod_func, to_field);
+
+	for(uint32_t i = 0; i < land_count; i += 17) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		if(p == source)
+			continue;
+		auto exact = province::make_path_to_prov<0.0f>(state, source, p, adj_func, prov_func, mod_func);
+		REQUIRE(from_field.reached(p) == !exact.empty());
+		REQUIRE(to_field.reached(p) == !exact.empty());
+		if(exact.empty())
+			continue;
+
+		// the pair search does not move a queued province up when it finds a shorter route to it, so the field can only be shorter
+		auto exact_cost = path_cost(source, exact);
+		REQUIRE(from_field.distance(p) <= exact_cost * 1.0001f);
+		REQUIRE(to_field.distance(p) <= exact_cost * 1.0001f);
+
+		from_field.path(p, field_path);
+		REQUIRE(field_path.front() == p);
+		REQUIRE(std::abs(path_cost(source, field_path) - from_field.distance(p)) <= from_field.distance(p) * 0.0001f);
+		to_field.path(p, field_path);
+		REQUIRE(field_path.front() == source);
+		REQUIRE(std::abs(path_cost(p, field_path) - to_field.distance(p)) <= to_field.distance(p) * 0.0001f);
+	}
+
+	// the safe land rules reach the same provinces as the pair searches, never along a more expensive route
+	for(auto n : state.world.in_nation) {
+		auto capital = n.get_capital();
+		if(!capital || n.get_owned_province_count() < 2)
+			continue;
+		std::vector<dcon::province_id> starts;
+		for(auto o : n.get_province_ownership())
+			starts.push_back(o.get_province().id);
+		province::fill_safe_land_distance_field(state, n, province::search_direction::to_sources, std::span<dcon::province_id const>(&capital.id, 1), to_field, starts);
+		for(auto s : starts) {
+			if(s == capital.id)
+				continue;
+			auto pair_path = province::make_safe_land_path(state, s, capital, n);
+			REQUIRE(to_field.reached(s) == !pair_path.empty());
+			if(pair_path.empty())
+				continue;
+			float pair_cost = 0.0f;
+			auto from = s;
+			for(auto i = pair_path.size(); i-- > 0;) {
+				auto adj = state.world.get_province_adjacency_by_province_pair(pair_path[i], from);
+				pair_cost += state.world.province_adjacency_get_distance(adj) * military::get_avg_movement_cost_modifier(state, n, from, pair_path[i]);
+				from = pair_path[i];
+			}
+			REQUIRE(to_field.distance(s) <= pair_cost * 1.0001f);
+
+			// the route the ai gathers along arrives where the pair search does
+			to_field.path(s, field_path);
+			REQUIRE(field_path.front() == pair_path.front());
+			REQUIRE(bool(state.world.get_province_adjacency_by_province_pair(field_path.back(), s)));
+		}
+	}
+}
+
+TEST_CASE("distance_field_profiling", "[pathfinding_profiling]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	// every nation gathers all the provinces it owns at its capital, once with a search per province and once with a single field
+	std::vector<std::pair<dcon::nation_id, std::vector<dcon::province_id>>> jobs;
+	for(auto n : state.world.in_nation) {
+		if(!n.get_capital() || n.get_owned_province_count() < 2)
+			continue;
+		auto& job = jobs.emplace_back(n.id, std::vector<dcon::province_id>{ });
+		for(auto o : n.get_province_ownership())
+			job.second.push_back(o.get_province().id);
+	}
+
+	size_t placeholder = 0;
+	std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+	for(int32_t repeat = 0; repeat < 10; ++repeat) {
+		for(auto& [n, starts] : jobs) {
+			auto capital = state.world.nation_get_capital(n);
+			for(auto s : starts)
+				placeholder += province::make_safe_land_path(state, s, capital, n).size();
+		}
+	}
+	std::chrono::steady_clock::time_point time_end = std::chrono::steady_clock::now();
+	auto pair_time = time_end - time_start;
+
+	province::distance_field field;
+	std::vector<dcon::province_id> path;
+	time_start = std::chrono::steady_clock::now();
+	for(int32_t repeat = 0; repeat < 10; ++repeat) {
+		for(auto& [n, starts] : jobs) {
+			auto capital = state.world.nation_get_capital(n);
+			province::fill_safe_land_distance_field(state, n, province::search_direction::to_sources, std::span<dcon::province_id const>(&capital, 1), field, starts);
+			for(auto s : starts) {
+				field.path(s, path);
+				placeholder += path.size();
+			}
+		}
+	}
+	time_end = std::chrono::steady_clock::now();
+	auto field_time = time_end - time_start;
+
+	gamestate->console_log("gather to capital, search per province ns: " + std::to_string(pair_time.count()));
+	gamestate->console_log("gather to capital, one distance field per nation ns: " + std::to_string(field_time.count()));
+	std::cout << placeholder;
+}
+
+TEST_CASE("adjacency_graph_matches_relationship", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	auto compare_with_relationship = [&]() {
+		REQUIRE(state.adjacency_graph.offsets.size() == state.world.province_size() + 1);
+		for(auto p : state.world.in_province) {
+			auto edges = state.adjacency_graph.neighbors(p);
+			uint32_t i = 0;
+			for(auto adj : p.get_province_adjacency()) {
+				REQUIRE(i < edges.size());
+				auto other = adj.get_connected_provinces(0) == p ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+				REQUIRE(edges[i].adjacency == adj.id);
+				REQUIRE(edges[i].neighbor == other.id);
+				REQUIRE(edges[i].type == adj.get_type());
+				REQUIRE(edges[i].distance == adj.get_distance());
+				++i;
+			}
+			REQUIRE(i == edges.size());
+		}
+	};
+	compare_with_relationship();
+
+	// a change of owner moves national borders, which the edges must follow
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	for(uint32_t i = 0; i < land_count; i += 23) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		auto owner = state.world.province_get_nation_from_province_ownership(p);
+		if(!owner)
+			continue;
+		for(auto& e : state.adjacency_graph.neighbors(p)) {
+			auto other = state.world.province_get_nation_from_province_ownership(e.neighbor);
+			if(other && other != owner) {
+				province::change_province_owner(state, p, other);
+				break;
+			}
+		}
+	}
+	compare_with_relationship();
+}
+
+TEST_CASE("adjacency_graph_profiling", "[pathfinding_profiling]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	// flood fills over passable land borders from every 50th land province, summing the border lengths on the way
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	std::vector<uint8_t> visited;
+	std::vector<dcon::province_id> to_fill;
+	double placeholder = 0.0;
+
+	std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+	for(uint32_t i = 0; i < land_count; i += 50) {
+		visited.assign(state.world.province_size(), 0);
+		to_fill.push_back(dcon::province_id{ dcon::province_id::value_base_t(i) });
+		while(!to_fill.empty()) {
+			auto current = to_fill.back();
+			to_fill.pop_back();
+			for(auto adj : state.world.province_get_province_adjacency(current)) {
+				auto other = adj.get_connected_provinces(0) == current ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+				if((adj.get_type() & (province::border::coastal_bit | province::border::impassible_bit)) == 0 && !visited[other.id.index()]) {
+					visited[other.id.index()] = 1;
+					placeholder += adj.get_distance();
+					to_fill.push_back(other);
+				}
+			}
+		}
+	}
+	std::chrono::steady_clock::time_point time_end = std::chrono::steady_clock::now();
+	gamestate->console_log("flood fill over the relationship ns: " + std::to_string((time_end - time_start).count()));
+
+	time_start = std::chrono::steady_clock::now();
+	for(uint32_t i = 0; i < land_count; i += 50) {
+		visited.assign(state.world.province_size(), 0);
+		to_fill.push_back(dcon::province_id{ dcon::province_id::value_base_t(i) });
+		while(!to_fill.empty()) {
+			auto current = to_fill.back();
+			to_fill.pop_back();
+			for(auto& e : state.adjacency_graph.neighbors(current)) {
+				if((e.type & (province::border::coastal_bit | province::border::impassible_bit)) == 0 && !visited[e.neighbor.index()]) {
+					visited[e.neighbor.index()] = 1;
+					placeholder -= e.distance;
+					to_fill.push_back(e.neighbor);
+				}
+			}
+		}
+	}
+	time_end = std::chrono::steady_clock::now();
+	gamestate->console_log("flood fill over the adjacency graph ns: " + std::to_string((time_end - time_start).count()));
+
+	std::cout << placeholder;
+}
+
+TEST_CASE("connected_regions_incremental_matches_rebuild", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	auto compare_with_rebuild = [&]() {
+		province::update_connected_regions(state);
+
+		std::vector<uint16_t> region_ids;
+		std::vector<uint16_t> coast_ids;
+		for(auto p : state.world.in_province) {
+			region_ids.push_back(p.get_connected_region_id());
+			coast_ids.push_back(p.get_connected_coast_id());
+		}
+		auto region_is_coastal = state.province_definitions.connected_region_is_coastal;
+		std::vector<std::pair<dcon::nation_id, dcon::nation_id>> pairs;
+		for(auto a : state.world.in_nation_adjacency)
+			pairs.emplace_back(a.get_connected_nations(0), a.get_connected_nations(1));
+
+		state.province_definitions.connected_regions_need_rebuild = true;
+		state.adjacency_data_out_of_date = true;
+		province::update_connected_regions(state);
+
+		for(auto p : state.world.in_province) {
+			REQUIRE(region_ids[p.id.index()] == p.get_connected_region_id());
+			REQUIRE(coast_ids[p.id.index()] == p.get_connected_coast_id());
+		}
+		REQUIRE(region_is_coastal == state.province_definitions.connected_region_is_coastal);
+		REQUIRE(pairs.size() == state.world.nation_adjacency_size());
+		for(auto a : state.world.in_nation_adjacency) {
+			REQUIRE(pairs[a.id.index()].first == a.get_connected_nations(0));
+			REQUIRE(pairs[a.id.index()].second == a.get_connected_nations(1));
+		}
+	};
+
+	compare_with_rebuild();
+
+	// give provinces to a neighbor, which splits and merges regions along the way
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	std::vector<std::pair<dcon::province_id, dcon::nation_id>> original_owners;
+	for(uint32_t i = 0; i < land_count; i += 29) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		auto owner = state.world.province_get_nation_from_province_ownership(p);
+		if(!owner)
+			continue;
+		for(auto& e : state.adjacency_graph.neighbors(p)) {
+			auto other = state.world.province_get_nation_from_province_ownership(e.neighbor);
+			if(other && other != owner) {
+				original_owners.emplace_back(p, owner);
+				province::change_province_owner(state, p, other);
+				break;
+			}
+		}
+	}
+	REQUIRE(!original_owners.empty());
+	compare_with_rebuild();
+
+	// several transfers of the same provinces between two updates, ending with their original owners
+	for(uint32_t i = 0; i < original_owners.size(); i += 2) {
+		auto [p, owner] = original_owners[i];
+		auto [q, other] = original_owners[(i + 1) % original_owners.size()];
+		province::change_province_owner(state, p, other);
+		province::change_province_owner(state, p, owner);
+	}
+	compare_with_rebuild();
+
+	for(uint32_t i = 1; i < original_owners.size(); i += 2) {
+		province::change_province_owner(state, original_owners[i].first, original_owners[i].second);
+	}
+	compare_with_rebuild();
+
+	for(int32_t i = 0; i < 30; ++i)
+		state.single_game_tick();
+	compare_with_rebuild();
+}
+
+TEST_CASE("landmark_heuristic_finds_shortest_paths", "[pathfinding]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	REQUIRE(state.distance_oracle.landmarks.size() == province::distance_oracle::landmark_count);
+
+	auto adj_func = [&](auto to, auto from, dcon::province_adjacency_id adj) {
+		return (state.world.province_adjacency_get_type(adj) & province::border::impassible_bit) == 0;
+	};
+	auto prov_func = [&](dcon::province_id to_prov) { return true; };
+	auto mod_func = [&](auto to_prov, auto from_prov, auto adj, float dist) { return dist; };
+
+	auto path_cost = [&](dcon::province_id start, std::vector<dcon::province_id> const& path) {
+		float total = 0.0f;
+		auto from = start;
+		for(auto i = path.size(); i-- > 0;) {
+			auto adj = state.world.get_province_adjacency_by_province_pair(path[i], from);
+			REQUIRE(bool(adj));
+			total += state.world.province_adjacency_get_distance(adj);
+			from = path[i];
+		}
+		return total;
+	};
+
+	// the shortest distances come from a distance field, as the pair searches keep the original open queue order, which does not move a
+	// queued province up when a shorter route to it is found; their paths can be slightly longer than the shortest one
+	province::distance_field shortest;
+	auto province_count = uint32_t(state.world.province_size());
+	for(uint32_t i = 0; i < province_count; i += 23) {
+		dcon::province_id start{ dcon::province_id::value_base_t(i) };
+		dcon::province_id end{ dcon::province_id::value_base_t((i * 13 + 577) % province_count) };
+		if(start == end)
+			continue;
+		auto exact = province::make_path_to_prov<0.0f>(state, start, end, adj_func, prov_func, mod_func);
+		auto guided = province::make_path_to_prov<province::landmark_heuristic>(state, start, end, adj_func, prov_func, mod_func);
+		REQUIRE(exact.empty() == guided.empty());
+		province::fill_distance_field<province::search_direction::from_sources>(state, std::span<dcon::province_id const>(&start, 1), adj_func, prov_func, mod_func, shortest, std::span<dcon::province_id const>(&end, 1));
+		REQUIRE(shortest.reached(end) == !exact.empty());
+		if(exact.empty())
+			continue;
+
+		auto shortest_cost = shortest.distance(end);
+		REQUIRE(province::landmark_lower_bound(state, start, end) <= shortest_cost * 1.0001f);
+		REQUIRE(path_cost(start, guided) <= shortest_cost * 1.01f);
+		REQUIRE(path_cost(start, exact) <= shortest_cost * 1.01f);
+	}
+
+	// naval unit paths are guided by the landmarks, and reach every port the direct distance guided search reaches, along a route no longer than it
+	auto sea_count = province_count - uint32_t(state.province_definitions.first_sea_province.index());
+	for(uint32_t i = 0; i < sea_count; i += 11) {
+		dcon::province_id start{ dcon::province_id::value_base_t(state.province_definitions.first_sea_province.index() + i) };
+		dcon::province_id end{ dcon::province_id::value_base_t(state.province_definitions.first_sea_province.index() + (i * 13 + 97) % sea_count) };
+		if(start == end)
+			continue;
+		dcon::nation_id n{ };
+		auto naval_adj = [&](dcon::province_id to, dcon::province_id from, dcon::province_adjacency_id adj) {
+			return province::make_naval_unit_path_adjacency_valid(state, n, to, from, adj);
+		};
+		auto naval_prov = [&](dcon::province_id to) { return province::make_naval_unit_path_province_valid(state, n, to); };
+		auto direct = province::make_path_to_prov<1.0f>(state, start, end, naval_adj, naval_prov, mod_func);
+		auto guided = province::make_naval_unit_path(state, start, end, n);
+		REQUIRE(direct.empty() == guided.empty());
+		if(!direct.empty())
+			REQUIRE(path_cost(start, guided) <= path_cost(start, direct) * 1.01f);
+	}
+}
+
+TEST_CASE("landmark_heuristic_profiling", "[pathfinding_profiling]") {
+	gamestate = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *gamestate;
+
+	auto adj_func = [&](auto to, auto from, dcon::province_adjacency_id adj) {
+		return (state.world.province_adjacency_get_type(adj) & province::border::impassible_bit) == 0;
+	};
+	auto prov_func = [&](dcon::province_id to_prov) { return true; };
+	uint64_t direct_expansions = 0;
+	uint64_t landmark_expansions = 0;
+	uint64_t* expansions = &direct_expansions;
+	auto mod_func = [&](auto to_prov, auto from_prov, auto adj, float dist) {
+		++*expansions;
+		return dist;
+	};
+
+	auto province_count = uint32_t(state.world.province_size());
+	auto run = [&]<float H>() {
+		auto start_time = std::chrono::steady_clock::now();
+		for(uint32_t i = 0; i < province_count; i += 7) {
+			dcon::province_id start{ dcon::province_id::value_base_t(i) };
+			dcon::province_id end{ dcon::province_id::value_base_t((i * 13 + 577) % province_count) };
+			province::make_path_to_prov<H>(state, start, end, adj_func, prov_func, mod_func);
+		}
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+	};
+	expansions = &direct_expansions;
+	auto direct_time = run.operator()<1.0f>();
+	expansions = &landmark_expansions;
+	auto landmark_time = run.operator()<province::landmark_heuristic>();
+
+	WARN("direct distance heuristic: " << direct_time << " us, " << direct_expansions << " edges relaxed");
+	WARN("landmark heuristic: " << landmark_time << " us, " << landmark_expansions << " edges relaxed");
+}
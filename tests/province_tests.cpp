@@ -0,0 +1,107 @@
+#include <array>
+#include <vector>
+#include "catch.hpp"
+#include "system_state.hpp"
+#include "province.hpp"
+
+TEST_CASE("cached_values_incremental_matches_rebuild", "[province]") {
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save(sys::network_mode_type::host);
+	auto& state = *game_state;
+
+	struct nation_counts {
+		std::array<uint16_t, 10> values;
+		bool is_colonial_nation = false;
+		dcon::province_id capital;
+	};
+	auto read_nations = [&]() {
+		std::vector<nation_counts> result;
+		for(auto n : state.world.in_nation) {
+			result.push_back(nation_counts{ { n.get_owned_province_count(), n.get_central_province_count(), n.get_central_blockaded(),
+				n.get_central_rebel_controlled(), n.get_rebel_controlled_count(), n.get_central_ports(), n.get_central_crime_count(),
+				n.get_total_ports(), n.get_occupied_count(), n.get_owned_state_count() },
+				n.get_is_colonial_nation(), n.get_capital().id });
+		}
+		return result;
+	};
+	auto read_owner_cores = [&]() {
+		std::vector<bool> result;
+		for(auto p : state.world.in_province)
+			result.push_back(p.get_is_owner_core());
+		return result;
+	};
+	auto read_state_capitals = [&]() {
+		std::vector<dcon::province_id> result;
+		for(auto s : state.world.in_state_instance)
+			result.push_back(s.get_capital().id);
+		return result;
+	};
+
+	auto compare_with_rebuild = [&]() {
+		province::update_connected_regions(state);
+		province::update_cached_values(state);
+		province::update_blockaded_cache(state); // blockades are only recounted monthly for nations which did not change
+		REQUIRE(state.province_definitions.cached_values_dirty_provinces.empty());
+		REQUIRE(state.province_definitions.cached_values_dirty_nations.empty());
+
+		auto nations = read_nations();
+		auto owner_cores = read_owner_cores();
+		auto state_capitals = read_state_capitals();
+
+		state.province_definitions.cached_values_need_rebuild = true;
+		state.national_cached_values_out_of_date = true;
+		province::update_cached_values(state);
+
+		auto rebuilt = read_nations();
+		REQUIRE(nations.size() == rebuilt.size());
+		for(size_t i = 0; i < rebuilt.size(); ++i) {
+			REQUIRE(nations[i].values == rebuilt[i].values);
+			REQUIRE(nations[i].is_colonial_nation == rebuilt[i].is_colonial_nation);
+			REQUIRE(nations[i].capital == rebuilt[i].capital);
+		}
+		REQUIRE(owner_cores == read_owner_cores());
+		REQUIRE(state_capitals == read_state_capitals());
+	};
+
+	compare_with_rebuild();
+
+	// give provinces to a neighbor, which also empties some states of their old owner
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
+	std::vector<std::pair<dcon::province_id, dcon::nation_id>> original_owners;
+	for(uint32_t i = 0; i < land_count; i += 23) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		auto owner = state.world.province_get_nation_from_province_ownership(p);
+		if(!owner)
+			continue;
+		for(auto& e : state.adjacency_graph.neighbors(p)) {
+			auto other = state.world.province_get_nation_from_province_ownership(e.neighbor);
+			if(other && other != owner) {
+				original_owners.emplace_back(p, owner);
+				province::change_province_owner(state, p, other);
+				break;
+			}
+		}
+	}
+	REQUIRE(!original_owners.empty());
+	compare_with_rebuild();
+
+	// occupations by the old owner and by rebels
+	for(uint32_t i = 0; i < original_owners.size(); ++i) {
+		auto [p, owner] = original_owners[i];
+		auto rebellions = state.world.nation_get_rebellion_within(state.world.province_get_nation_from_province_ownership(p));
+		if(i % 2 == 0)
+			province::set_province_controller(state, p, owner);
+		else if(rebellions.begin() != rebellions.end())
+			province::set_province_controller(state, p, (*rebellions.begin()).get_rebels().id);
+	}
+	compare_with_rebuild();
+
+	for(auto [p, owner] : original_owners) {
+		province::change_province_owner(state, p, owner);
+		province::set_province_controller(state, p, owner);
+	}
+	compare_with_rebuild();
+
+	for(int32_t i = 0; i < 30; ++i)
+		state.single_game_tick();
+	compare_with_rebuild();
+}
@@ -87,6 +87,9 @@ std::unique_ptr<sys::state> load_testing_scenario_file_with_save(sys::network_mo
 #include "dcon_tests.cpp"
 #include "network_tests.cpp"
 #include "pathfinding_tests.cpp"
+#include "economy_bench_tests.cpp"
+#include "military_tests.cpp"
+#include "province_tests.cpp"
 
 TEST_CASE("Dummy test", "[dummy test instance]") {
 	REQUIRE(1 + 1 == 2);